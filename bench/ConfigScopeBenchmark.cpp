@@ -0,0 +1,107 @@
+// Copyright (c) 2017-2021 offa
+// Copyright 2011 Ciaran McHale.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/internal/ConfigScope.h"
+#include "danek/internal/ConfigItem.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+using namespace danek;
+
+namespace
+{
+    constexpr int minEntries{10};
+    constexpr int maxEntries{1'000'000};
+
+
+    std::vector<std::string> makeNames(std::size_t count)
+    {
+        std::vector<std::string> names;
+        names.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            names.push_back(std::string{"item_"}.append(std::to_string(i)));
+        }
+        return names;
+    }
+}
+
+static void scopeInsert(benchmark::State& state)
+{
+    const auto names = makeNames(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        ConfigScope root{nullptr, ""};
+
+        for (const auto& name : names)
+        {
+            root.addOrReplaceString(name, "value");
+        }
+        benchmark::DoNotOptimize(root);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(scopeInsert)->RangeMultiplier(10)->Range(minEntries, maxEntries)->Unit(benchmark::kMicrosecond);
+
+static void scopeFindItem(benchmark::State& state)
+{
+    const auto names = makeNames(static_cast<std::size_t>(state.range(0)));
+    ConfigScope root{nullptr, ""};
+
+    for (const auto& name : names)
+    {
+        root.addOrReplaceString(name, "value");
+    }
+
+    std::size_t i{0};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(root.findItem(names[i]));
+        i = (i + 1) % names.size();
+    }
+}
+BENCHMARK(scopeFindItem)->RangeMultiplier(10)->Range(minEntries, maxEntries);
+
+static void scopeFindMissingItem(benchmark::State& state)
+{
+    const auto names = makeNames(static_cast<std::size_t>(state.range(0)));
+    ConfigScope root{nullptr, ""};
+
+    for (const auto& name : names)
+    {
+        root.addOrReplaceString(name, "value");
+    }
+
+    const std::string missing{"not_present"};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(root.findItem(missing));
+    }
+}
+BENCHMARK(scopeFindMissingItem)->RangeMultiplier(10)->Range(minEntries, maxEntries);
@@ -0,0 +1,493 @@
+// Copyright (c) 2017-2021 offa
+// Copyright 2011 Ciaran McHale.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/Configuration.h"
+#include "danek/ConfigurationHolder.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <thread>
+
+using namespace danek;
+
+namespace
+{
+    // A scope nested some levels deep with a number of sibling entries on each level
+    std::string makeConfig(int entries)
+    {
+        std::string str;
+
+        for (const auto scope : {"server", "http", "limits"})
+        {
+            str.append(scope).append(" {\n");
+
+            for (int i = 0; i < entries; ++i)
+            {
+                str.append("entry_").append(std::to_string(i)).append(" = \"").append(std::to_string(i)).append("\";\n");
+            }
+        }
+
+        str.append("timeout = \"30 seconds\";\n");
+        str.append("}\n}\n}\n");
+        return str;
+    }
+
+    // Keeps track of the bytes currently allocated through it
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t bytesInUse() const
+        {
+            return m_bytesInUse;
+        }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            m_bytesInUse += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            m_bytesInUse -= bytes;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        std::size_t m_bytesInUse{0};
+    };
+
+    // A number of sibling scopes with a few entries each, like a list of recipes
+    std::string makeScopesConfig(int scopes)
+    {
+        std::string str{"app {\nrecipes {\n"};
+
+        for (int i = 0; i < scopes; ++i)
+        {
+            str.append("recipe_").append(std::to_string(i)).append(" {\n");
+            str.append("name = \"r\";\nservings = \"2\";\nduration = \"5 minutes\";\n}\n");
+        }
+
+        str.append("}\n}\n");
+        return str;
+    }
+
+    struct ConfigDeleter
+    {
+        void operator()(Configuration* cfg) const
+        {
+            cfg->destroy();
+        }
+    };
+
+    std::unique_ptr<Configuration, ConfigDeleter> createConfig(int entries)
+    {
+        std::unique_ptr<Configuration, ConfigDeleter> cfg{Configuration::create()};
+        cfg->parse(Configuration::SourceType::String, makeConfig(entries).c_str());
+        return cfg;
+    }
+}
+
+static void lookupIntByName(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupInt("server.http.limits", "entry_1"));
+    }
+}
+BENCHMARK(lookupIntByName)->Arg(10)->Arg(1000);
+
+static void lookupIntByNameFrozen(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+    cfg->freeze();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupInt("server.http.limits", "entry_1"));
+    }
+}
+BENCHMARK(lookupIntByNameFrozen)->Arg(10)->Arg(1000);
+
+static void lookupIntByKey(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+    const auto key = cfg->resolveKey("server.http.limits", "entry_1");
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupInt(key));
+    }
+}
+BENCHMARK(lookupIntByKey)->Arg(10)->Arg(1000);
+
+static void lookupDurationByName(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupDurationMilliseconds("server.http.limits", "timeout"));
+    }
+}
+BENCHMARK(lookupDurationByName)->Arg(10);
+
+static void lookupMissingWithDefaultByName(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupInt("server.http.limits", "missing", 42));
+    }
+}
+BENCHMARK(lookupMissingWithDefaultByName)->Arg(10);
+
+static void lookupMissingWithFallbackByName(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+    cfg->setFallbackConfiguration(Configuration::SourceType::String, makeConfig(static_cast<int>(state.range(0))).c_str());
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupInt("server.http.limits", "missing", 42));
+    }
+}
+BENCHMARK(lookupMissingWithFallbackByName)->Arg(10)->Arg(1000);
+
+static void lookupFallbackByName(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+    cfg->setFallbackConfiguration(Configuration::SourceType::String, "retries = \"3\";");
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupInt("server.http.limits", "retries"));
+    }
+}
+BENCHMARK(lookupFallbackByName)->Arg(10)->Arg(1000);
+
+static void lookupFallbackByNameMerged(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+    cfg->setFallbackConfiguration(Configuration::SourceType::String, "retries = \"3\";");
+    cfg->setMergedIndex(true);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupInt("server.http.limits", "retries"));
+    }
+}
+BENCHMARK(lookupFallbackByNameMerged)->Arg(10)->Arg(1000);
+
+static void lookupMissingWithDefaultByNameFrozen(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+    cfg->freeze();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupInt("server.http.limits", "missing", 42));
+    }
+}
+BENCHMARK(lookupMissingWithDefaultByNameFrozen)->Arg(10);
+
+static void lookupListCopy(benchmark::State& state)
+{
+    std::unique_ptr<Configuration, ConfigDeleter> cfg{Configuration::create()};
+    cfg->insertList("", "table", std::vector<std::string>(static_cast<std::size_t>(state.range(0)), "some_entry"));
+    std::vector<std::string> data;
+
+    for (auto _ : state)
+    {
+        cfg->lookupList("", "table", data);
+        benchmark::DoNotOptimize(data.data());
+    }
+}
+BENCHMARK(lookupListCopy)->Arg(10)->Arg(10000);
+
+static void lookupListView(benchmark::State& state)
+{
+    std::unique_ptr<Configuration, ConfigDeleter> cfg{Configuration::create()};
+    cfg->insertList("", "table", std::vector<std::string>(static_cast<std::size_t>(state.range(0)), "some_entry"));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupListView("", "table"));
+    }
+}
+BENCHMARK(lookupListView)->Arg(10)->Arg(10000);
+
+static void lookupTenIntsIndividually(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+    const std::array names{"entry_0", "entry_1", "entry_2", "entry_3", "entry_4",
+                           "entry_5", "entry_6", "entry_7", "entry_8", "entry_9"};
+    std::array<int, names.size()> values{};
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            values[i] = cfg->lookupInt("server.http.limits", names[i]);
+        }
+        benchmark::DoNotOptimize(values);
+    }
+}
+BENCHMARK(lookupTenIntsIndividually)->Arg(10)->Arg(1000);
+
+static void lookupTenIntsBatched(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+    const std::array names{"entry_0", "entry_1", "entry_2", "entry_3", "entry_4",
+                           "entry_5", "entry_6", "entry_7", "entry_8", "entry_9"};
+    std::array<int, names.size()> values{};
+    std::array<LookupRequest, names.size()> requests{};
+
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        requests[i] = LookupRequest{names[i], LookupRequest::Type::Int, &values[i]};
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cfg->lookupBatch("server.http.limits", requests));
+        benchmark::DoNotOptimize(values);
+    }
+}
+BENCHMARK(lookupTenIntsBatched)->Arg(10)->Arg(1000);
+
+static void lookupScopeFieldsByName(benchmark::State& state)
+{
+    const int scopes = static_cast<int>(state.range(0));
+    std::unique_ptr<Configuration, ConfigDeleter> cfg{Configuration::create()};
+    cfg->parse(Configuration::SourceType::String, makeScopesConfig(scopes).c_str());
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < scopes; ++i)
+        {
+            const std::string scope = std::string{"app.recipes.recipe_"}.append(std::to_string(i));
+            benchmark::DoNotOptimize(cfg->lookupString(scope, std::string_view{"name"}));
+            benchmark::DoNotOptimize(cfg->lookupInt(scope, std::string_view{"servings"}));
+            benchmark::DoNotOptimize(cfg->lookupDurationSeconds(scope, std::string_view{"duration"}));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * scopes);
+}
+BENCHMARK(lookupScopeFieldsByName)->Arg(1000);
+
+static void lookupScopeFieldsByView(benchmark::State& state)
+{
+    const int scopes = static_cast<int>(state.range(0));
+    std::unique_ptr<Configuration, ConfigDeleter> cfg{Configuration::create()};
+    cfg->parse(Configuration::SourceType::String, makeScopesConfig(scopes).c_str());
+    const auto recipes = cfg->scopeView("app.recipes");
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < scopes; ++i)
+        {
+            const auto recipe = recipes.child(std::string{"recipe_"}.append(std::to_string(i)));
+            benchmark::DoNotOptimize(recipe.lookupString("name"));
+            benchmark::DoNotOptimize(recipe.lookupInt("servings"));
+            benchmark::DoNotOptimize(recipe.lookupDurationSeconds("duration"));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * scopes);
+}
+BENCHMARK(lookupScopeFieldsByView)->Arg(1000);
+
+static void listFullyScopedNames(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        StringVector names;
+        cfg->listFullyScopedNames("", "", ConfType::ScopesAndVars, true, names);
+        benchmark::DoNotOptimize(names.size());
+    }
+}
+BENCHMARK(listFullyScopedNames)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void listFullyScopedNamesFiltered(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        StringVector names;
+        cfg->listFullyScopedNames("", "", ConfType::ScopesAndVars, true, "*", names);
+        benchmark::DoNotOptimize(names.size());
+    }
+}
+BENCHMARK(listFullyScopedNamesFiltered)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void forEachItem(benchmark::State& state)
+{
+    const auto cfg = createConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::size_t length{0};
+        cfg->forEachItem("", ConfType::ScopesAndVars, true, [&length](const ItemRef& item) { length += item.name.size(); });
+        benchmark::DoNotOptimize(length);
+    }
+}
+BENCHMARK(forEachItem)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void parseAndDestroy(benchmark::State& state)
+{
+    const auto mode = state.range(1) == 0 ? Configuration::AllocationMode::Heap : Configuration::AllocationMode::Arena;
+    const auto input = makeConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::unique_ptr<Configuration, ConfigDeleter> cfg{Configuration::create(mode)};
+        cfg->parse(Configuration::SourceType::String, input.c_str());
+    }
+}
+BENCHMARK(parseAndDestroy)->ArgNames({"entries", "arena"})->ArgsProduct({{10, 1000}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+static void treeMemory(benchmark::State& state)
+{
+    const auto entries = static_cast<int>(state.range(0));
+    const auto input = makeConfig(entries);
+    std::size_t bytes{0};
+
+    for (auto _ : state)
+    {
+        CountingResource resource;
+        std::unique_ptr<Configuration, ConfigDeleter> cfg{Configuration::create(&resource)};
+        cfg->parse(Configuration::SourceType::String, input.c_str());
+        bytes = resource.bytesInUse();
+    }
+
+    state.counters["bytes"] = static_cast<double>(bytes);
+    state.counters["bytesPerItem"] = static_cast<double>(bytes) / (3.0 * (entries + 1));
+}
+BENCHMARK(treeMemory)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+namespace
+{
+    std::unique_ptr<Configuration, ConfigDeleter> sharedConfig;
+}
+
+static void lookupConcurrently(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        sharedConfig = createConfig(10);
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sharedConfig->lookupInt("server.http.limits", "entry_1"));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        sharedConfig.reset();
+    }
+}
+BENCHMARK(lookupConcurrently)->ThreadRange(1, 64)->UseRealTime();
+
+namespace
+{
+    // Parses and publishes new versions until stopped
+    class Reloader
+    {
+    public:
+        explicit Reloader(ConfigurationHolder& holder)
+            : m_input(makeConfig(10)), m_stop(false), m_reloads(0), m_thread([this, &holder] { run(holder); })
+        {
+        }
+
+        ~Reloader()
+        {
+            m_stop = true;
+            m_thread.join();
+        }
+
+        std::uint64_t reloads() const
+        {
+            return m_reloads;
+        }
+
+    private:
+        void run(ConfigurationHolder& holder)
+        {
+            while (m_stop == false)
+            {
+                auto cfg = Configuration::create();
+                cfg->parse(Configuration::SourceType::String, m_input.c_str());
+                holder.publish(cfg);
+                ++m_reloads;
+            }
+        }
+
+        const std::string m_input;
+        std::atomic<bool> m_stop;
+        std::atomic<std::uint64_t> m_reloads;
+        std::thread m_thread;
+    };
+
+    std::unique_ptr<ConfigurationHolder> holder;
+    std::unique_ptr<Reloader> reloader;
+}
+
+static void lookupDuringReload(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        holder = std::make_unique<ConfigurationHolder>(createConfig(10).release());
+        reloader = std::make_unique<Reloader>(*holder);
+    }
+
+    for (auto _ : state)
+    {
+        const auto snapshot = holder->acquire();
+        benchmark::DoNotOptimize(snapshot->lookupInt("server.http.limits", "entry_1"));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        state.counters["reloads"] = static_cast<double>(reloader->reloads());
+        reloader.reset();
+        holder.reset();
+    }
+}
+BENCHMARK(lookupDuringReload)->ThreadRange(1, 8)->UseRealTime();
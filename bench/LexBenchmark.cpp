@@ -0,0 +1,198 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "danek/internal/ConfigLex.h"
+#include "danek/internal/LexBaseSymbols.h"
+#include "danek/internal/SchemaLex.h"
+#include <benchmark/benchmark.h>
+#include <clocale>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace danek;
+
+namespace
+{
+    // A generated configuration of roughly entries * 40 bytes; the values
+    // are mostly multi-byte characters if requested
+    std::string makeConfig(int entries, bool multiByte = false)
+    {
+        const std::string value = (multiByte == true) ? "Grüße — 日本語 ünïcödé" : "value";
+        std::string str{"generated {\n"};
+
+        for (int i = 0; i < entries; ++i)
+        {
+            str.append("    entry_").append(std::to_string(i)).append(" = [\"").append(std::to_string(i)).append("\", \"");
+            str.append(value).append("\"];\n");
+        }
+        return str.append("}\n");
+    }
+
+    // A configuration dominated by what the scanning kernels skip:
+    // comments, indentation, and long plain and block strings
+    std::string makeDocumentedConfig(int entries)
+    {
+        const std::string indent(16, ' ');
+        std::string str{"generated {\n"};
+
+        for (int i = 0; i < entries; ++i)
+        {
+            str.append("\n").append(indent).append("# The description of this entry, which is long enough to span\n");
+            str.append(indent).append("# a second comment line before the entry itself.\n");
+            str.append(indent).append("entry_").append(std::to_string(i)).append(" = \"");
+            str.append("a long quoted value with %\"an escape%\" in the middle of it\";\n");
+            str.append(indent).append("block_").append(std::to_string(i)).append(" = <%\n");
+            str.append(indent).append("    several lines of block text\n").append(indent).append("    kept verbatim\n").append(indent);
+            str.append("%>;\n");
+        }
+        return str.append("}\n");
+    }
+
+    // A generated schema in the style of the ones applications embed
+    std::string makeSchema(int entries)
+    {
+        std::string str;
+
+        for (int i = 0; i < entries; ++i)
+        {
+            const auto n = std::to_string(i);
+            str.append("@typedef colour_").append(n).append(" = enum[red, green, blue];\n");
+            str.append("@required entry_").append(n).append(" = colour_").append(n).append(";\n");
+            str.append("@optional limit_").append(n).append(" = int[0, 100];\n");
+            str.append("@ignoreScopesIn extra_").append(n).append(";\n");
+        }
+        return str;
+    }
+
+    std::string writeConfig(int entries)
+    {
+        const auto fileName = (std::filesystem::temp_directory_path() / "danek-LexBenchmark.cfg").string();
+        std::ofstream file{fileName, std::ios::binary};
+        file << makeConfig(entries);
+        return fileName;
+    }
+
+    std::size_t lexAll(LexBase& lexer)
+    {
+        LexToken token;
+        std::size_t count{0};
+
+        do
+        {
+            lexer.nextToken(token);
+            ++count;
+        } while (token.type() != lex::LEX_EOF_SYM);
+        return count;
+    }
+
+    std::size_t lexAll(Configuration::SourceType sourceType, const char* source)
+    {
+        UidIdentifierProcessor uidProc;
+        ConfigLex lexer{sourceType, source, &uidProc};
+        return lexAll(lexer);
+    }
+}
+
+static void lexFile(benchmark::State& state)
+{
+    const auto fileName = writeConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(lexAll(Configuration::SourceType::File, fileName.c_str()));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * std::filesystem::file_size(fileName)));
+    std::filesystem::remove(fileName);
+}
+BENCHMARK(lexFile)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void lexString(benchmark::State& state)
+{
+    std::setlocale(LC_ALL, "C.UTF-8");
+    const auto config = makeConfig(static_cast<int>(state.range(0)), state.range(1) != 0);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(lexAll(Configuration::SourceType::String, config.c_str()));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * config.size()));
+}
+BENCHMARK(lexString)->ArgNames({"entries", "multiByte"})->ArgsProduct({{1000, 100000}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+static void lexDocumented(benchmark::State& state)
+{
+    const auto config = makeDocumentedConfig(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(lexAll(Configuration::SourceType::String, config.c_str()));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * config.size()));
+}
+BENCHMARK(lexDocumented)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Token throughput of the two lexers over a config and a schema of similar size
+static void tokensConfigLex(benchmark::State& state)
+{
+    const auto config = makeConfig(static_cast<int>(state.range(0)));
+    std::size_t tokens{0};
+
+    for (auto _ : state)
+    {
+        tokens += lexAll(Configuration::SourceType::String, config.c_str());
+    }
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+}
+BENCHMARK(tokensConfigLex)->Arg(25000)->Unit(benchmark::kMillisecond);
+
+static void tokensSchemaLex(benchmark::State& state)
+{
+    const auto schema = makeSchema(static_cast<int>(state.range(0)));
+    std::size_t tokens{0};
+
+    for (auto _ : state)
+    {
+        SchemaLex lexer{schema.c_str()};
+        tokens += lexAll(lexer);
+    }
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+}
+BENCHMARK(tokensSchemaLex)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void mbstrlen(benchmark::State& state)
+{
+    std::setlocale(LC_ALL, "C.UTF-8");
+    const std::string unit = (state.range(0) != 0) ? "Grüße — 日本語 ünïcödé " : "plain ascii text ";
+    std::string str;
+
+    while (str.size() < 64 * 1024)
+    {
+        str.append(unit);
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Configuration::mbstrlen(str.c_str()));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * str.size()));
+}
+BENCHMARK(mbstrlen)->ArgName("multiByte")->Arg(0)->Arg(1);
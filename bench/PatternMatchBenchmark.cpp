@@ -0,0 +1,142 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/GlobPattern.h"
+#include "danek/PatternMatch.h"
+#include "danek/PatternSet.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+using namespace danek;
+
+namespace
+{
+    // "*a*a...*a*b*": backtracking over each "*" makes matching a string
+    // of "a"s exponential in the number of pieces
+    std::string adversarialPattern(int pieces)
+    {
+        std::string pattern;
+
+        for (int i = 0; i < pieces; ++i)
+        {
+            pattern.append("*a");
+        }
+        return pattern.append("*b*");
+    }
+
+    // Deny rules as a security configuration may list them, none of
+    // which matches the command line
+    std::vector<std::string> denyPatterns(int count)
+    {
+        std::vector<std::string> patterns;
+
+        for (int i = 0; i < count; ++i)
+        {
+            patterns.push_back(std::string{"*/bin/tool"}.append(std::to_string(i)).append(" *"));
+        }
+        return patterns;
+    }
+
+    const std::string cmdLineToCheck{"/usr/local/bin/hostname --fqdn --all-ip-addresses"};
+}
+
+static void patternMatchAdversarial(benchmark::State& state)
+{
+    const std::string str(static_cast<std::size_t>(state.range(0)), 'a');
+    const auto pattern = adversarialPattern(static_cast<int>(state.range(1)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(patternMatch(str.c_str(), pattern.c_str()));
+    }
+}
+BENCHMARK(patternMatchAdversarial)->ArgNames({"length", "pieces"})->ArgsProduct({{32, 1024}, {3, 6}});
+
+static void globPatternAdversarial(benchmark::State& state)
+{
+    const std::string str(static_cast<std::size_t>(state.range(0)), 'a');
+    const GlobPattern pattern{adversarialPattern(static_cast<int>(state.range(1)))};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pattern.matches(str));
+    }
+}
+BENCHMARK(globPatternAdversarial)->ArgNames({"length", "pieces"})->ArgsProduct({{32, 1024}, {3, 6}});
+
+static void patternMatchCommandLine(benchmark::State& state)
+{
+    const std::string cmdLine{"/usr/local/bin/hostname --fqdn"};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(patternMatch(cmdLine.c_str(), "/usr/*bin/hostname*"));
+    }
+}
+BENCHMARK(patternMatchCommandLine);
+
+static void globPatternCommandLine(benchmark::State& state)
+{
+    const std::string cmdLine{"/usr/local/bin/hostname --fqdn"};
+    const GlobPattern pattern{"/usr/*bin/hostname*"};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pattern.matches(cmdLine));
+    }
+}
+BENCHMARK(globPatternCommandLine);
+
+static void globPatternEachOfMany(benchmark::State& state)
+{
+    std::vector<GlobPattern> patterns;
+
+    for (const auto& pattern : denyPatterns(static_cast<int>(state.range(0))))
+    {
+        patterns.emplace_back(pattern);
+    }
+
+    for (auto _ : state)
+    {
+        bool matched = false;
+
+        for (const auto& pattern : patterns)
+        {
+            matched = matched || pattern.matches(cmdLineToCheck);
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+}
+BENCHMARK(globPatternEachOfMany)->Arg(16)->Arg(256);
+
+static void patternSetAnyOfMany(benchmark::State& state)
+{
+    const PatternSet patterns{denyPatterns(static_cast<int>(state.range(0)))};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(patterns.matchesAny(cmdLineToCheck));
+    }
+}
+BENCHMARK(patternSetAnyOfMany)->Arg(16)->Arg(256);
@@ -18,6 +18,9 @@ print_option(UNIT_TESTS "Unit Tests")
 option(COVERAGE "Enable Coverage" OFF)
 print_option(COVERAGE "Coverage")
 
+option(THREAD_SANITIZER "Enable ThreadSanitizer" OFF)
+print_option(THREAD_SANITIZER "ThreadSanitizer")
+
 option(BUILD_TOOLS "Build the tools" ON)
 print_option(BUILD_TOOLS "Build Tools")
 
@@ -27,5 +30,8 @@ print_option(BUILD_SCHEMA_TESTS "Build Schema Tests")
 option(BUILD_DEMOS "Build the Demos" OFF)
 print_option(BUILD_DEMOS "Build Demos")
 
+option(BUILD_BENCHMARKS "Build the Benchmarks" OFF)
+print_option(BUILD_BENCHMARKS "Build Benchmarks")
+
 option(BUILD_SHARED_LIBS "Build Shared Library" OFF)
 print_option(BUILD_SHARED_LIBS "Build shared library")
@@ -23,12 +23,14 @@
 
 #include "RecipeFileParser.h"
 #include "danek/SchemaValidator.h"
+#include <optional>
 #include <stdexcept>
 #include <stdio.h>
 #include <stdlib.h>
 
 using danek::Configuration;
 using danek::ConfigurationException;
+using danek::ScopeView;
 using danek::SchemaValidator;
 
 RecipeFileParser::RecipeFileParser()
@@ -113,6 +115,7 @@ void RecipeFileParser::getRecipeSteps(const char* recipeScope, StringVector& res
 {
     int len;
     StringVector namesVec;
+    std::optional<ScopeView> recipe;
 
     checkState();
 
@@ -120,6 +123,7 @@ void RecipeFileParser::getRecipeSteps(const char* recipeScope, StringVector& res
     {
         m_cfg->listLocallyScopedNames(
             recipeScope, "", ConfType::String, false, "uid-step", namesVec);
+        recipe = m_cfg->scopeView(recipeScope);
     }
     catch (const ConfigurationException& ex)
     {
@@ -137,8 +141,7 @@ void RecipeFileParser::getRecipeSteps(const char* recipeScope, StringVector& res
                 throw std::invalid_argument{"Invalid uid"};
             }
 
-            const char* str = m_cfg->lookupString(recipeScope, namesVec[i].c_str());
-            result.push_back(str);
+            result.push_back(std::string{recipe->lookupString(namesVec[i])});
         }
     }
     catch (const ConfigurationException&)
@@ -0,0 +1,98 @@
+// Copyright (c) 2017-2021 offa
+// Copyright 2011 Ciaran McHale.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace danek
+{
+    class ConfigItem;
+    class Configuration;
+
+    //----------------------------------------------------------------------
+    // Class:	ConfigKey
+    //
+    // Description:	A (scope, localName) pair pre-resolved against a
+    //		Configuration via Configuration::resolveKey().
+    //
+    //		Lookups through a key return the resolved entry directly
+    //		as long as the configuration (and its fallback) has not
+    //		been modified since the key was resolved. Once it has
+    //		been modified, the key is stale and lookups through it
+    //		fall back to resolving the name again. Keys are immutable
+    //		and can be shared between threads.
+    //
+    //		symbol() is the id the resolving configuration interned
+    //		the entry's name as, or noSymbol if the entry did not
+    //		exist there. Entries of the same name share the symbol.
+    //----------------------------------------------------------------------
+
+    class ConfigKey
+    {
+    public:
+        static constexpr std::uint32_t noSymbol{std::numeric_limits<std::uint32_t>::max()};
+
+
+        ConfigKey()
+            : ConfigKey(nullptr, 0, nullptr, noSymbol, "", "")
+        {
+        }
+
+        const char* scope() const
+        {
+            return m_scope.c_str();
+        }
+
+        const char* localName() const
+        {
+            return m_localName.c_str();
+        }
+
+        std::uint32_t symbol() const
+        {
+            return m_symbol;
+        }
+
+
+    private:
+        friend class ConfigurationImpl;
+
+        ConfigKey(const Configuration* owner, std::uint64_t generation, const ConfigItem* item, std::uint32_t symbol,
+                  const char* scope, const char* localName)
+            : m_owner(owner), m_generation(generation), m_item(item), m_symbol(symbol), m_scope(scope),
+              m_localName(localName)
+        {
+        }
+
+
+        const Configuration* m_owner;
+        std::uint64_t m_generation;
+        const ConfigItem* m_item;
+        std::uint32_t m_symbol;
+        std::string m_scope;
+        std::string m_localName;
+    };
+}
@@ -24,11 +24,20 @@
 #pragma once
 
 #include "danek/ConfType.h"
+#include "danek/ConfigKey.h"
 #include "danek/ConfigurationException.h"
+#include "danek/FunctionRef.h"
+#include "danek/ItemRef.h"
+#include "danek/ListView.h"
+#include "danek/LookupRequest.h"
+#include "danek/ScopeView.h"
 #include "danek/StringBuffer.h"
 #include "danek/StringVector.h"
+#include <memory_resource>
+#include <span>
 #include <stddef.h>
 #include <string.h>
+#include <string_view>
 
 namespace danek
 {
@@ -39,6 +48,15 @@ namespace danek
     };
 
 
+    //----------------------------------------------------------------------
+    // Class:	Configuration
+    //
+    // Description:	Any number of threads may call the const member
+    //		functions of a configuration concurrently, as long as
+    //		no thread modifies it (or its fallback configuration)
+    //		at the same time.
+    //----------------------------------------------------------------------
+
     class Configuration
     {
     public:
@@ -49,15 +67,28 @@ namespace danek
             Exec
         };
 
+        // Where the parsed configuration tree is allocated: on the heap
+        // (item by item) or in an arena owned by the configuration, which
+        // is released as a whole by empty() and destroy().
+        enum class AllocationMode
+        {
+            Heap,
+            Arena
+        };
+
         Configuration(const Configuration& ex) = delete;
         Configuration& operator=(const Configuration& ex) = delete;
 
 
         static Configuration* create();
+        static Configuration* create(AllocationMode mode);
+        // The resource must outlive the configuration
+        static Configuration* create(std::pmr::memory_resource* resource);
         virtual void destroy();
 
         static void mergeNames(const char* scope, const char* localName, StringBuffer& fullyScopedName);
 
+        // The number of characters in the UTF-8 string, or -1 if it is invalid
         static int mbstrlen(const char* str);
 
         virtual void setFallbackConfiguration(Configuration* cfg) = 0;
@@ -89,6 +120,11 @@ namespace danek
         virtual void listLocallyScopedNames(const char* scope, const char* localName, ConfType typeMask, bool recursive,
                                             const StringVector& filterPatterns, StringVector& names) const = 0;
 
+        // Calls back for the items of scope ("" is the root) in insertion order, without
+        // listing them first; the callback must not modify the configuration
+        virtual void forEachItem(std::string_view scope, ConfType typeMask, bool recursive,
+                                 FunctionRef<void(const ItemRef&)> callback) const = 0;
+
         virtual ConfType type(const char* scope, const char* localName) const = 0;
 
         virtual bool uidEquals(const char* s1, const char* s2) const = 0;
@@ -209,14 +245,124 @@ namespace danek
 
         virtual void lookupScope(const char* scope, const char* localName) const = 0;
 
+        virtual ConfigKey resolveKey(const char* scope, const char* localName) const = 0;
+
+        virtual ConfType type(const ConfigKey& key) const = 0;
+
+        virtual const char* lookupString(const ConfigKey& key, const char* defaultVal) const = 0;
+        virtual const char* lookupString(const ConfigKey& key) const = 0;
+
+        virtual void lookupList(const ConfigKey& key, std::vector<std::string>& data, const char** defaultArray,
+                                int defaultArraySize) const = 0;
+        virtual void lookupList(const ConfigKey& key, std::vector<std::string>& data) const = 0;
+        virtual ListView lookupListView(const ConfigKey& key, ListView defaultList) const = 0;
+        virtual ListView lookupListView(const ConfigKey& key) const = 0;
+
+        virtual int lookupInt(const ConfigKey& key, int defaultVal) const = 0;
+        virtual int lookupInt(const ConfigKey& key) const = 0;
+
+        virtual float lookupFloat(const ConfigKey& key, float defaultVal) const = 0;
+        virtual float lookupFloat(const ConfigKey& key) const = 0;
+
+        virtual int lookupEnum(const ConfigKey& key, const char* typeName, const EnumNameAndValue* enumInfo, int numEnums,
+                               int defaultVal) const = 0;
+        virtual int lookupEnum(const ConfigKey& key, const char* typeName, const EnumNameAndValue* enumInfo,
+                               int numEnums) const = 0;
+
+        virtual bool lookupBoolean(const ConfigKey& key, bool defaultVal) const = 0;
+        virtual bool lookupBoolean(const ConfigKey& key) const = 0;
+
+        virtual int lookupDurationMicroseconds(const ConfigKey& key, int defaultVal) const = 0;
+        virtual int lookupDurationMicroseconds(const ConfigKey& key) const = 0;
+        virtual int lookupDurationMilliseconds(const ConfigKey& key, int defaultVal) const = 0;
+        virtual int lookupDurationMilliseconds(const ConfigKey& key) const = 0;
+        virtual int lookupDurationSeconds(const ConfigKey& key, int defaultVal) const = 0;
+        virtual int lookupDurationSeconds(const ConfigKey& key) const = 0;
+
+        virtual int lookupMemorySizeBytes(const ConfigKey& key, int defaultVal) const = 0;
+        virtual int lookupMemorySizeBytes(const ConfigKey& key) const = 0;
+        virtual int lookupMemorySizeKB(const ConfigKey& key, int defaultVal) const = 0;
+        virtual int lookupMemorySizeKB(const ConfigKey& key) const = 0;
+        virtual int lookupMemorySizeMB(const ConfigKey& key, int defaultVal) const = 0;
+        virtual int lookupMemorySizeMB(const ConfigKey& key) const = 0;
+
+        virtual ConfType type(std::string_view scope, std::string_view localName) const = 0;
+
+        virtual std::string_view lookupString(std::string_view scope, std::string_view localName,
+                                              std::string_view defaultVal) const = 0;
+        virtual std::string_view lookupString(std::string_view scope, std::string_view localName) const = 0;
+
+        virtual void lookupList(std::string_view scope, std::string_view localName, std::vector<std::string>& data,
+                                const char** defaultArray, int defaultArraySize) const = 0;
+        virtual void lookupList(std::string_view scope, std::string_view localName,
+                                std::vector<std::string>& data) const = 0;
+        virtual void lookupList(std::string_view scope, std::string_view localName, StringVector& list,
+                                const StringVector& defaultList) const = 0;
+        virtual void lookupList(std::string_view scope, std::string_view localName, StringVector& list) const = 0;
+
+        // Views the list instead of copying it; see ListView for how long the view is valid
+        virtual ListView lookupListView(std::string_view scope, std::string_view localName,
+                                        ListView defaultList) const = 0;
+        virtual ListView lookupListView(std::string_view scope, std::string_view localName) const = 0;
+
+        virtual int lookupInt(std::string_view scope, std::string_view localName, int defaultVal) const = 0;
+        virtual int lookupInt(std::string_view scope, std::string_view localName) const = 0;
+
+        virtual float lookupFloat(std::string_view scope, std::string_view localName, float defaultVal) const = 0;
+        virtual float lookupFloat(std::string_view scope, std::string_view localName) const = 0;
+
+        virtual int lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                               const EnumNameAndValue* enumInfo, int numEnums, const char* defaultVal) const = 0;
+        virtual int lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                               const EnumNameAndValue* enumInfo, int numEnums, int defaultVal) const = 0;
+        virtual int lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                               const EnumNameAndValue* enumInfo, int numEnums) const = 0;
+
+        virtual bool lookupBoolean(std::string_view scope, std::string_view localName, bool defaultVal) const = 0;
+        virtual bool lookupBoolean(std::string_view scope, std::string_view localName) const = 0;
+
+        virtual int lookupDurationMicroseconds(std::string_view scope, std::string_view localName, int defaultVal) const = 0;
+        virtual int lookupDurationMicroseconds(std::string_view scope, std::string_view localName) const = 0;
+        virtual int lookupDurationMilliseconds(std::string_view scope, std::string_view localName, int defaultVal) const = 0;
+        virtual int lookupDurationMilliseconds(std::string_view scope, std::string_view localName) const = 0;
+        virtual int lookupDurationSeconds(std::string_view scope, std::string_view localName, int defaultVal) const = 0;
+        virtual int lookupDurationSeconds(std::string_view scope, std::string_view localName) const = 0;
+
+        virtual int lookupMemorySizeBytes(std::string_view scope, std::string_view localName, int defaultVal) const = 0;
+        virtual int lookupMemorySizeBytes(std::string_view scope, std::string_view localName) const = 0;
+        virtual int lookupMemorySizeKB(std::string_view scope, std::string_view localName, int defaultVal) const = 0;
+        virtual int lookupMemorySizeKB(std::string_view scope, std::string_view localName) const = 0;
+        virtual int lookupMemorySizeMB(std::string_view scope, std::string_view localName, int defaultVal) const = 0;
+        virtual int lookupMemorySizeMB(std::string_view scope, std::string_view localName) const = 0;
+
+        // Looks up all requests relative to scope; returns the number of missing or invalid entries
+        virtual std::size_t lookupBatch(std::string_view scope, std::span<LookupRequest> requests) const = 0;
+
+        // Resolves the scope once for lookups relative to it; throws if it does not exist
+        virtual ScopeView scopeView(std::string_view scope) const = 0;
+
         virtual void insertString(const char* scope, const char* localName, const char* strValue) = 0;
         virtual void insertList(const char* scope, const char* localName, std::vector<std::string> data) = 0;
         virtual void insertList(const char* scope, const char* localName, const StringVector& vec) = 0;
+        virtual void insertString(std::string_view scope, std::string_view localName, std::string_view strValue) = 0;
+        virtual void insertList(std::string_view scope, std::string_view localName, std::vector<std::string> data) = 0;
+        virtual void insertList(std::string_view scope, std::string_view localName, const StringVector& vec) = 0;
         virtual void ensureScopeExists(const char* scope, const char* localName) = 0;
         virtual void remove(const char* scope, const char* localName) = 0;
 
         virtual void empty() = 0;
 
+        // Builds a flat index for faster lookups; afterwards the
+        // configuration is read-only until it is emptied.
+        virtual void freeze() = 0;
+        virtual bool isFrozen() const = 0;
+
+        // Keeps one index over this and the fallback configurations, so a
+        // lookup takes a single probe whether or not it falls back; it is
+        // rebuilt by the first lookup after either side changes.
+        virtual void setMergedIndex(bool enabled) = 0;
+        virtual bool isMergedIndexEnabled() const = 0;
+
     protected:
         Configuration() = default;
         virtual ~Configuration() = default;
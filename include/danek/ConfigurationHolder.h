@@ -0,0 +1,129 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace danek
+{
+    class Configuration;
+
+    //----------------------------------------------------------------------
+    // Class:	ConfigurationHolder
+    //
+    // Description:	Holds the current version of a configuration, which
+    //		can be replaced while other threads keep reading it.
+    //
+    //		A writer parses a new configuration and publish()es
+    //		it; readers acquire() a Snapshot of whichever version
+    //		is current. Acquiring is wait-free: it neither locks
+    //		nor retries. A snapshot keeps its version alive until
+    //		it is released, and the last snapshot of a replaced
+    //		version destroys it.
+    //
+    //		Published configurations are frozen and only handed
+    //		out as const, so readers never see them change.
+    //----------------------------------------------------------------------
+
+    class ConfigurationHolder
+    {
+    private:
+        struct Version;
+
+    public:
+        class Snapshot
+        {
+        public:
+            Snapshot() noexcept;
+            Snapshot(const Snapshot& other) noexcept;
+            Snapshot(Snapshot&& other) noexcept;
+            ~Snapshot();
+
+            const Configuration* get() const noexcept;
+            std::uint64_t version() const noexcept;
+
+            const Configuration* operator->() const noexcept
+            {
+                return get();
+            }
+
+            const Configuration& operator*() const noexcept
+            {
+                return *get();
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return m_version != nullptr;
+            }
+
+            Snapshot& operator=(Snapshot other) noexcept;
+
+        private:
+            explicit Snapshot(Version* version) noexcept;
+
+            Version* m_version;
+
+            friend class ConfigurationHolder;
+        };
+
+
+        // Takes ownership of the configuration, which becomes version 1
+        explicit ConfigurationHolder(Configuration* cfg);
+        ConfigurationHolder(const ConfigurationHolder&) = delete;
+        ~ConfigurationHolder();
+
+        Snapshot acquire() const noexcept;
+
+        // Takes ownership of the configuration and returns its version
+        std::uint64_t publish(Configuration* cfg);
+
+        std::uint64_t version() const noexcept;
+
+
+        ConfigurationHolder& operator=(const ConfigurationHolder&) = delete;
+
+
+    private:
+        // Each counter has a cache line of its own, so the readers registered
+        // in one don't contend with those in the other
+        struct alignas(64) ReaderCount
+        {
+            std::atomic<std::uint64_t> count{0};
+        };
+
+        static Version* makeVersion(Configuration* cfg, std::uint64_t number);
+        static void release(Version* version) noexcept;
+
+        void waitForReaders();
+
+
+        std::atomic<Version*> m_current;
+        std::atomic<unsigned> m_readIndex;
+        mutable ReaderCount m_readers[2];
+        std::mutex m_publishMutex;
+    };
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace danek
+{
+    template <class Signature>
+    class FunctionRef;
+
+    //----------------------------------------------------------------------
+    // Class:	FunctionRef
+    //
+    // Description:	A non-owning reference to a callable, used for
+    //		callbacks. Unlike std::function it never allocates; the
+    //		callable must outlive the call it is passed to.
+    //----------------------------------------------------------------------
+
+    template <class R, class... Args>
+    class FunctionRef<R(Args...)>
+    {
+    public:
+        template <class F>
+            requires(std::is_object_v<std::remove_reference_t<F>> && std::is_invocable_r_v<R, F&, Args...> &&
+                     std::is_same_v<std::remove_cvref_t<F>, FunctionRef> == false)
+        FunctionRef(F&& callable) noexcept
+            : m_callable(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+              m_call(&call<std::remove_reference_t<F>>)
+        {
+        }
+
+        R operator()(Args... args) const
+        {
+            return m_call(m_callable, std::forward<Args>(args)...);
+        }
+
+
+    private:
+        template <class F>
+        static R call(void* callable, Args... args)
+        {
+            if constexpr (std::is_void_v<R> == true)
+            {
+                std::invoke(*static_cast<F*>(callable), std::forward<Args>(args)...);
+            }
+            else
+            {
+                return std::invoke(*static_cast<F*>(callable), std::forward<Args>(args)...);
+            }
+        }
+
+
+        void* m_callable;
+        R (*m_call)(void*, Args...);
+    };
+}
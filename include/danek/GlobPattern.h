@@ -0,0 +1,74 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace danek
+{
+    //----------------------------------------------------------------------
+    // Class:	GlobPattern
+    //
+    // Description:	A pattern in which "*" matches zero or more
+    //		characters, as patternMatch() uses them, prepared for
+    //		being matched against many strings.
+    //
+    //		The pattern is split at its first and last "*" once.
+    //		Matching compares the UTF-8 bytes directly and takes
+    //		the leftmost match of every piece in between, so it
+    //		never backtracks: the worst case is O(n * m) and no
+    //		memory is allocated.
+    //----------------------------------------------------------------------
+
+    class GlobPattern
+    {
+    public:
+        explicit GlobPattern(std::string_view pattern);
+        GlobPattern(const GlobPattern& other);
+
+        bool matches(std::string_view str) const;
+
+        static bool matches(std::string_view str, std::string_view pattern);
+
+        const std::string& pattern() const
+        {
+            return m_pattern;
+        }
+
+
+        GlobPattern& operator=(const GlobPattern& other);
+
+
+    private:
+        void split();
+
+
+        std::string m_pattern;
+        bool m_hasWildcard;
+        std::string_view m_prefix;
+        std::string_view m_middle;
+        std::string_view m_suffix;
+    };
+}
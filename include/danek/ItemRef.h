@@ -0,0 +1,54 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "danek/ConfType.h"
+#include "danek/ListView.h"
+#include <string_view>
+
+namespace danek
+{
+    //----------------------------------------------------------------------
+    // Class:	ItemRef
+    //
+    // Description:	An item passed to the callback of
+    //		Configuration::forEachItem().
+    //
+    //		The name is relative to the scope being enumerated; the
+    //		unexpanded name is the same name with its "uid-" parts
+    //		unexpanded. Both refer to buffers which are reused for the
+    //		next item, so they are only valid during the call; the
+    //		values stay valid until the configuration is modified or
+    //		destroyed.
+    //----------------------------------------------------------------------
+
+    struct ItemRef
+    {
+        std::string_view name;
+        std::string_view unexpandedName;
+        ConfType type;
+        std::string_view stringValue; // If type is ConfType::String
+        ListView listValue;           // If type is ConfType::List
+    };
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace danek
+{
+    //----------------------------------------------------------------------
+    // Class:	ListView
+    //
+    // Description:	A read-only view of a list stored in a
+    //		configuration, see Configuration::lookupListView().
+    //
+    //		The view refers to the strings of the list instead of
+    //		copying them. It (and every string_view it returns)
+    //		stays valid until the configuration is modified or
+    //		destroyed. The strings are null-terminated, c_str()
+    //		returns them as such.
+    //----------------------------------------------------------------------
+
+    class ListView
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::string_view;
+            using pointer = void;
+
+            Iterator() = default;
+
+            explicit Iterator(const std::pmr::string* pos)
+                : m_pos(pos)
+            {
+            }
+
+            std::string_view operator*() const
+            {
+                return *m_pos;
+            }
+
+            std::string_view operator[](difference_type n) const
+            {
+                return m_pos[n];
+            }
+
+            Iterator& operator++()
+            {
+                ++m_pos;
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                return Iterator{m_pos++};
+            }
+
+            Iterator& operator--()
+            {
+                --m_pos;
+                return *this;
+            }
+
+            Iterator operator--(int)
+            {
+                return Iterator{m_pos--};
+            }
+
+            Iterator& operator+=(difference_type n)
+            {
+                m_pos += n;
+                return *this;
+            }
+
+            Iterator& operator-=(difference_type n)
+            {
+                m_pos -= n;
+                return *this;
+            }
+
+            friend Iterator operator+(Iterator it, difference_type n)
+            {
+                return it += n;
+            }
+
+            friend Iterator operator+(difference_type n, Iterator it)
+            {
+                return it += n;
+            }
+
+            friend Iterator operator-(Iterator it, difference_type n)
+            {
+                return it -= n;
+            }
+
+            friend difference_type operator-(Iterator lhs, Iterator rhs)
+            {
+                return lhs.m_pos - rhs.m_pos;
+            }
+
+            friend bool operator==(Iterator lhs, Iterator rhs) = default;
+            friend std::strong_ordering operator<=>(Iterator lhs, Iterator rhs) = default;
+
+        private:
+            const std::pmr::string* m_pos{nullptr};
+        };
+
+        using value_type = std::string_view;
+        using size_type = std::size_t;
+        using iterator = Iterator;
+        using const_iterator = Iterator;
+
+
+        ListView() = default;
+
+        explicit ListView(std::span<const std::pmr::string> strings)
+            : m_strings(strings)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return m_strings.size();
+        }
+
+        bool empty() const
+        {
+            return m_strings.empty();
+        }
+
+        std::string_view operator[](std::size_t index) const
+        {
+            return m_strings[index];
+        }
+
+        const char* c_str(std::size_t index) const
+        {
+            return m_strings[index].c_str();
+        }
+
+        Iterator begin() const
+        {
+            return Iterator{m_strings.data()};
+        }
+
+        Iterator end() const
+        {
+            return Iterator{m_strings.data() + m_strings.size()};
+        }
+
+
+    private:
+        std::span<const std::pmr::string> m_strings;
+    };
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace danek
+{
+    //----------------------------------------------------------------------
+    // Class:	LookupRequest
+    //
+    // Description:	One entry of a batch lookup, see
+    //		Configuration::lookupBatch().
+    //
+    //		The value is converted according to type and stored in
+    //		destination, which must point to a variable of the
+    //		matching type (int for durations and memory sizes).
+    //		Strings are views into the configuration; they stay
+    //		valid until it is modified or destroyed.
+    //
+    //		An entry which is not required and does not exist keeps
+    //		the value already stored in destination, which thereby
+    //		serves as its default.
+    //----------------------------------------------------------------------
+
+    struct LookupRequest
+    {
+        enum class Type
+        {
+            String,
+            List,
+            Int,
+            Float,
+            Boolean,
+            DurationMicroseconds,
+            DurationMilliseconds,
+            DurationSeconds,
+            MemorySizeBytes,
+            MemorySizeKB,
+            MemorySizeMB
+        };
+
+        enum class Status
+        {
+            Found,
+            Defaulted,
+            Missing,
+            Invalid
+        };
+
+        using Destination = std::variant<std::string_view*, std::vector<std::string>*, int*, float*, bool*>;
+
+
+        std::string_view localName;
+        Type type;
+        Destination destination;
+        bool required{true};
+
+        // Results
+        Status status{Status::Missing};
+        std::string error{};
+    };
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "danek/GlobPattern.h"
+#include <array>
+#include <cstdint>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace danek
+{
+    //----------------------------------------------------------------------
+    // Class:	PatternSet
+    //
+    // Description:	A set of GlobPatterns, which finds the ones that
+    //		match a string in a single pass over it.
+    //
+    //		The longest literal piece of each pattern is put into an
+    //		Aho-Corasick automaton. Scanning the string with it
+    //		yields the patterns whose piece occurs, and only those
+    //		(plus patterns without any literal) are matched in full,
+    //		each at most once.
+    //----------------------------------------------------------------------
+
+    class PatternSet
+    {
+    public:
+        PatternSet();
+
+        template <std::ranges::input_range Range>
+            requires(std::is_convertible_v<std::ranges::range_reference_t<Range>, std::string_view> &&
+                     std::is_same_v<std::remove_cvref_t<Range>, PatternSet> == false)
+        explicit PatternSet(const Range& patterns)
+            : PatternSet()
+        {
+            for (const auto& pattern : patterns)
+            {
+                add(pattern);
+            }
+            build();
+        }
+
+        bool matchesAny(std::string_view str) const;
+
+        // The indices of the matching patterns, in ascending order
+        std::vector<std::size_t> matching(std::string_view str) const;
+
+        std::size_t size() const;
+        bool empty() const;
+
+
+    private:
+        struct State
+        {
+            std::uint32_t firstEdge;
+            std::uint32_t numEdges;
+            std::uint32_t fail;
+            std::uint32_t outputLink;
+            std::uint32_t firstOutput;
+            std::uint32_t numOutputs;
+        };
+
+        struct Edge
+        {
+            unsigned char byte;
+            std::uint32_t next;
+        };
+
+        void add(std::string_view pattern);
+        void build();
+        std::uint32_t next(std::uint32_t state, unsigned char byte) const;
+
+        template <class Verify>
+        bool forEachMatch(std::string_view str, Verify&& verify) const;
+
+
+        std::vector<GlobPattern> m_patterns;
+        std::vector<std::size_t> m_withoutLiteral;
+        std::array<std::uint32_t, 256> m_rootNext;
+        std::vector<State> m_states;
+        std::vector<Edge> m_edges;
+        std::vector<std::uint32_t> m_outputs;
+    };
+}
@@ -27,6 +27,8 @@
 #include "danek/SchemaType.h"
 #include "danek/internal/SchemaIdRuleInfo.h"
 #include "danek/internal/SchemaIgnoreRuleInfo.h"
+#include <string>
+#include <vector>
 
 
 namespace danek
@@ -91,7 +93,7 @@ namespace danek
         SchemaType* findType(const char* name) const;
 
         void validate(const Configuration* cfg, const char* scope, const char* localName, const StringVector& itemNames,
-                      ForceMode forceMode) const;
+                      const std::vector<std::string>& unexpandedNames, ForceMode forceMode) const;
         void validateForceMode(const Configuration* cfg, const char* scope, const char* localName, ForceMode forceMode) const;
         void validateRequiredUidEntry(const Configuration* cfg, const char* fullScope, SchemaIdRuleInfo* idRule) const;
 
@@ -0,0 +1,129 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "danek/ConfType.h"
+#include "danek/ListView.h"
+#include "danek/StringVector.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace danek
+{
+    class ConfigScope;
+    class ConfigurationImpl;
+    struct EnumNameAndValue;
+
+    //----------------------------------------------------------------------
+    // Class:	ScopeView
+    //
+    // Description:	A scope pinned via Configuration::scopeView(), for
+    //		looking up entries relative to it.
+    //
+    //		The scope is resolved once, so lookups through the view
+    //		only resolve the local name within it instead of the
+    //		fully scoped name from the root. They otherwise behave
+    //		exactly like the lookups of Configuration with scope()
+    //		as the scope, including the fallback configuration.
+    //
+    //		Like a ConfigKey, a view becomes stale once the
+    //		configuration (or its fallback) is modified; lookups
+    //		through it then resolve the full name again. A view must
+    //		not outlive the configuration it was created by.
+    //----------------------------------------------------------------------
+
+    class ScopeView
+    {
+    public:
+        const char* scope() const
+        {
+            return m_name.c_str();
+        }
+
+        ScopeView child(std::string_view localName) const;
+
+        ConfType type(std::string_view localName) const;
+
+        std::string_view lookupString(std::string_view localName, std::string_view defaultVal) const;
+        std::string_view lookupString(std::string_view localName) const;
+
+        void lookupList(std::string_view localName, std::vector<std::string>& data, const char** defaultArray,
+                        int defaultArraySize) const;
+        void lookupList(std::string_view localName, std::vector<std::string>& data) const;
+        void lookupList(std::string_view localName, StringVector& list, const StringVector& defaultList) const;
+        void lookupList(std::string_view localName, StringVector& list) const;
+        ListView lookupListView(std::string_view localName, ListView defaultList) const;
+        ListView lookupListView(std::string_view localName) const;
+
+        int lookupInt(std::string_view localName, int defaultVal) const;
+        int lookupInt(std::string_view localName) const;
+
+        float lookupFloat(std::string_view localName, float defaultVal) const;
+        float lookupFloat(std::string_view localName) const;
+
+        int lookupEnum(std::string_view localName, const char* typeName, const EnumNameAndValue* enumInfo, int numEnums,
+                       const char* defaultVal) const;
+        int lookupEnum(std::string_view localName, const char* typeName, const EnumNameAndValue* enumInfo, int numEnums,
+                       int defaultVal) const;
+        int lookupEnum(std::string_view localName, const char* typeName, const EnumNameAndValue* enumInfo,
+                       int numEnums) const;
+
+        bool lookupBoolean(std::string_view localName, bool defaultVal) const;
+        bool lookupBoolean(std::string_view localName) const;
+
+        int lookupDurationMicroseconds(std::string_view localName, int defaultVal) const;
+        int lookupDurationMicroseconds(std::string_view localName) const;
+        int lookupDurationMilliseconds(std::string_view localName, int defaultVal) const;
+        int lookupDurationMilliseconds(std::string_view localName) const;
+        int lookupDurationSeconds(std::string_view localName, int defaultVal) const;
+        int lookupDurationSeconds(std::string_view localName) const;
+
+        int lookupMemorySizeBytes(std::string_view localName, int defaultVal) const;
+        int lookupMemorySizeBytes(std::string_view localName) const;
+        int lookupMemorySizeKB(std::string_view localName, int defaultVal) const;
+        int lookupMemorySizeKB(std::string_view localName) const;
+        int lookupMemorySizeMB(std::string_view localName, int defaultVal) const;
+        int lookupMemorySizeMB(std::string_view localName) const;
+
+
+    private:
+        friend class ConfigurationImpl;
+
+        ScopeView(const ConfigurationImpl* owner, std::uint64_t generation, const ConfigScope* scopeObj, bool resolved,
+                  std::string name)
+            : m_owner(owner), m_generation(generation), m_scope(scopeObj), m_resolved(resolved), m_name(std::move(name))
+        {
+        }
+
+
+        const ConfigurationImpl* m_owner;
+        std::uint64_t m_generation;
+        const ConfigScope* m_scope;
+        bool m_resolved;
+        std::string m_name;
+    };
+}
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 namespace danek
 {
@@ -53,6 +54,8 @@ namespace danek
 
         StringBuffer& operator<<(const StringBuffer& other);
         StringBuffer& operator<<(const std::string& str);
+        StringBuffer& operator<<(std::string_view str);
+        StringBuffer& operator<<(const char* str);
         StringBuffer& operator<<(int val);
         StringBuffer& operator<<(float val);
         StringBuffer& operator<<(char ch);
@@ -24,8 +24,15 @@
 #pragma once
 
 #include "danek/ConfType.h"
+#include "danek/internal/MemoryResource.h"
+#include "danek/internal/SymbolTable.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <vector>
 
 namespace danek
@@ -39,35 +46,70 @@ namespace danek
     //      A config file contains "name = <value>" statements and
     //      "name <scope>" statements. This class is used to store
     //      name plus the the <value> part, (which can be a string
-    //      or a sequence of string) or a <scope>.
+    //      or a sequence of string) or a <scope>. The name is
+    //      interned in the symbol table of the configuration, which
+    //      must outlive the item, along with its unexpanded
+    //      spelling. The value is allocated from the given memory
+    //      resource; only the active alternative is stored.
+    //
+    //      The result of the last conversion of a string value (to
+    //      an int, a duration, ...) is cached along with the kind of
+    //      the conversion, so repeated lookups need not parse the
+    //      string again. The value itself never changes; replacing
+    //      it replaces the item, and with it the cache.
     //--------------------------------------------------------------
 
     class ConfigItem
     {
     public:
-        ConfigItem(const std::string& name, const std::string& str);
-        ConfigItem(const std::string& name, const std::vector<std::string>& v);
-        ConfigItem(const std::string& name, std::unique_ptr<ConfigScope> scope);
+        enum class Conversion : std::uint8_t
+        {
+            Int = 1,
+            Float,
+            Boolean,
+            Enum,
+            DurationMicroseconds,
+            DurationMilliseconds,
+            DurationSeconds,
+            MemorySizeBytes,
+            MemorySizeKB,
+            MemorySizeMB
+        };
+
+        ConfigItem(const SymbolTable& symbols, SymbolId name, std::string_view str,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        ConfigItem(const SymbolTable& symbols, SymbolId name, const std::vector<std::string>& v,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        ConfigItem(const SymbolTable& symbols, SymbolId name, ResourcePtr<ConfigScope> scope);
         ConfigItem(const ConfigItem&) = delete;
 
 
         ConfType type() const;
-        const std::string& name() const;
-        const std::string& stringVal() const;
-        const std::vector<std::string>& listVal() const;
+        SymbolId nameId() const;
+        const std::pmr::string& name() const;
+        const std::pmr::string& unexpandedName() const;
+        const std::pmr::string& stringVal() const;
+        const std::pmr::vector<std::pmr::string>& listVal() const;
         ConfigScope* scopeVal() const;
 
+        bool cachedValue(Conversion conversion, std::int32_t& value) const;
+        void cacheValue(Conversion conversion, std::int32_t value) const;
+
 
         ConfigItem& operator=(const ConfigItem&) = delete;
 
 
     private:
-        void checkVariantType(ConfType expected) const;
+        using Value = std::variant<std::pmr::string, std::pmr::vector<std::pmr::string>, ResourcePtr<ConfigScope>>;
+
+        template <class T>
+        const T& checkedValue() const;
 
-        const ConfType m_type;
-        const std::string m_name;
-        const std::string m_stringVal;
-        const std::vector<std::string> m_listVal;
-        const std::unique_ptr<ConfigScope> m_scope;
+        const SymbolId m_nameId;
+        const std::pmr::string& m_name;
+        const std::pmr::string& m_unexpandedName;
+        const Value m_value;
+        // The conversion in the upper, its result in the lower half; 0 if there is none
+        mutable std::atomic<std::uint64_t> m_cache{0};
     };
 }
@@ -104,6 +104,7 @@ namespace danek
         void parseList(StringVector& expr);
         void parseStringExprList(StringVector& list);
 
+        ConfType typeInCurrScope(std::string_view name) const;
         void getDirectoryOfFile(const char* filename, StringBuffer& str);
         void accept(short, const char* errMsg);
         void error(const char* errMsg, bool printNear = true);
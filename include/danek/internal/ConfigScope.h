@@ -24,8 +24,15 @@
 #pragma once
 
 #include "danek/ConfType.h"
+#include "danek/FunctionRef.h"
 #include "danek/StringBuffer.h"
+#include "danek/internal/MemoryResource.h"
+#include "danek/internal/SymbolTable.h"
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace danek
@@ -36,15 +43,34 @@ namespace danek
     // Class:	ConfigScope
     //
     // Description:	A hash table for storing (name, item) pairs.
+    //
+    //		Items are kept in insertion order (which the list and
+    //		dump functions rely on); an open addressing index over
+    //		the item names provides constant time lookups once the
+    //		scope grows beyond a few entries.
+    //
+    //		Names are interned in a symbol table owned by the root
+    //		scope and shared by all of its descendants; lookups
+    //		compare symbol ids rather than strings.
+    //
+    //		All items, child scopes and names of a tree are allocated
+    //		from the memory resource passed to the root scope.
     //----------------------------------------------------------------------
 
     class ConfigScope
     {
     public:
-        ConfigScope(ConfigScope* parentScope, const std::string& name);
+        ConfigScope(ConfigScope* parentScope, const std::string& name,
+                    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
         ConfigScope(const ConfigScope&) = delete;
 
-        const std::string& scopedName() const;
+        std::string scopedName() const;
+        std::string unexpandedScopedName() const;
+
+        std::pmr::memory_resource* resource() const;
+
+        SymbolTable& symbols();
+        const SymbolTable& symbols() const;
 
         bool addOrReplaceString(const std::string& name, const std::string& str);
         bool addOrReplaceList(const std::string& name, const std::vector<std::string>& list);
@@ -53,9 +79,20 @@ namespace danek
 
         bool removeItem(const std::string& name);
 
-        const ConfigItem* findItem(const std::string& name) const;
+        const ConfigItem* findItem(std::string_view name) const;
+        const ConfigItem* findItem(SymbolId name) const;
+
+        bool contains(std::string_view name) const;
 
-        bool contains(const std::string& name) const;
+        // Calls back with the scoped name (prefix + '.' + item name) of
+        // the matching items, built in name; the name is restored after
+        using ItemCallback = FunctionRef<void(std::string_view, const ConfigItem&)>;
+        void forEachItem(ConfType typeMask, bool recursive, std::string& name, ItemCallback callback) const;
+
+        // As above, with the unexpanded scoped name built alongside
+        using UnexpandedItemCallback = FunctionRef<void(std::string_view, std::string_view, const ConfigItem&)>;
+        void forEachItem(ConfType typeMask, bool recursive, std::string& name, std::string& unexpandedName,
+                         UnexpandedItemCallback callback) const;
 
         std::vector<std::string> listFullyScopedNames(ConfType typeMask, bool recursive) const;
         std::vector<std::string> listFullyScopedNames(ConfType typeMask, bool recursive,
@@ -71,13 +108,23 @@ namespace danek
 
 
     private:
-        std::vector<std::string> listScopedNamesHelper(const std::string& prefix, ConfType typeMask, bool recursive,
+        std::vector<std::string> listScopedNamesHelper(bool fullyScoped, ConfType typeMask, bool recursive,
                                                        const std::vector<std::string>& filterPatterns) const;
-        bool listFilter(const std::string& name, const std::vector<std::string>& filterPatterns) const;
+
+        std::size_t indexOf(std::string_view name) const;
+        std::size_t indexOf(SymbolId name) const;
+        void addToIndex(std::size_t pos);
+        void removeFromIndex(SymbolId name);
+        void rebuildIndex();
 
 
         const ConfigScope* m_parentScope;
-        std::string m_scopedName;
-        std::vector<std::unique_ptr<ConfigItem>> m_table;
+        std::pmr::memory_resource* m_resource;
+        ResourcePtr<SymbolTable> m_ownSymbols;
+        SymbolTable* m_symbols;
+        SymbolId m_nameId;
+        std::pmr::vector<ResourcePtr<ConfigItem>> m_table;
+        std::pmr::vector<std::uint64_t> m_index;
+        std::size_t m_removed; // Empty positions left in m_table by removeItem()
     };
 }
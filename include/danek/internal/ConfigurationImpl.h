@@ -26,9 +26,15 @@
 //--------
 // #include's
 //--------
+#include "ConfigItem.h"
 #include "ConfigScope.h"
+#include "FrozenIndex.h"
+#include "NameFilter.h"
 #include "UidIdentifierProcessor.h"
+#include "Util.h"
 #include "danek/Configuration.h"
+#include <atomic>
+#include <memory>
 
 namespace danek
 {
@@ -54,6 +60,8 @@ namespace danek
         // Constructor and destructor
         //--------
         ConfigurationImpl();
+        explicit ConfigurationImpl(Configuration::AllocationMode mode);
+        explicit ConfigurationImpl(std::pmr::memory_resource* resource);
         virtual ~ConfigurationImpl();
 
         //--------
@@ -86,6 +94,9 @@ namespace danek
         virtual void listLocallyScopedNames(const char* scope, const char* localName, ConfType typeMask, bool recursive,
                                             const StringVector& filterPatterns, StringVector& names) const;
 
+        virtual void forEachItem(std::string_view scope, ConfType typeMask, bool recursive,
+                                 FunctionRef<void(const ItemRef&)> callback) const;
+
         virtual bool uidEquals(const char* s1, const char* s2) const;
         virtual void expandUid(StringBuffer& spelling);
 
@@ -203,6 +214,101 @@ namespace danek
 
         virtual void lookupScope(const char* scope, const char* localName) const;
 
+        //--------
+        // Lookups through pre-resolved keys
+        //--------
+        virtual ConfigKey resolveKey(const char* scope, const char* localName) const;
+
+        virtual ConfType type(const ConfigKey& key) const;
+
+        virtual const char* lookupString(const ConfigKey& key, const char* defaultVal) const;
+        virtual const char* lookupString(const ConfigKey& key) const;
+
+        virtual void lookupList(const ConfigKey& key, std::vector<std::string>& data, const char** defaultArray,
+                                int defaultArraySize) const;
+        virtual void lookupList(const ConfigKey& key, std::vector<std::string>& data) const;
+        virtual ListView lookupListView(const ConfigKey& key, ListView defaultList) const;
+        virtual ListView lookupListView(const ConfigKey& key) const;
+
+        virtual int lookupInt(const ConfigKey& key, int defaultVal) const;
+        virtual int lookupInt(const ConfigKey& key) const;
+
+        virtual float lookupFloat(const ConfigKey& key, float defaultVal) const;
+        virtual float lookupFloat(const ConfigKey& key) const;
+
+        virtual int lookupEnum(const ConfigKey& key, const char* typeName, const EnumNameAndValue* enumInfo, int numEnums,
+                               int defaultVal) const;
+        virtual int lookupEnum(const ConfigKey& key, const char* typeName, const EnumNameAndValue* enumInfo, int numEnums) const;
+
+        virtual bool lookupBoolean(const ConfigKey& key, bool defaultVal) const;
+        virtual bool lookupBoolean(const ConfigKey& key) const;
+
+        virtual int lookupDurationMicroseconds(const ConfigKey& key, int defaultVal) const;
+        virtual int lookupDurationMicroseconds(const ConfigKey& key) const;
+        virtual int lookupDurationMilliseconds(const ConfigKey& key, int defaultVal) const;
+        virtual int lookupDurationMilliseconds(const ConfigKey& key) const;
+        virtual int lookupDurationSeconds(const ConfigKey& key, int defaultVal) const;
+        virtual int lookupDurationSeconds(const ConfigKey& key) const;
+
+        virtual int lookupMemorySizeBytes(const ConfigKey& key, int defaultVal) const;
+        virtual int lookupMemorySizeBytes(const ConfigKey& key) const;
+        virtual int lookupMemorySizeKB(const ConfigKey& key, int defaultVal) const;
+        virtual int lookupMemorySizeKB(const ConfigKey& key) const;
+        virtual int lookupMemorySizeMB(const ConfigKey& key, int defaultVal) const;
+        virtual int lookupMemorySizeMB(const ConfigKey& key) const;
+
+        //--------
+        // Lookups by std::string_view names
+        //--------
+        virtual ConfType type(std::string_view scope, std::string_view localName) const;
+
+        virtual std::string_view lookupString(std::string_view scope, std::string_view localName,
+                                              std::string_view defaultVal) const;
+        virtual std::string_view lookupString(std::string_view scope, std::string_view localName) const;
+
+        virtual void lookupList(std::string_view scope, std::string_view localName, std::vector<std::string>& data,
+                                const char** defaultArray, int defaultArraySize) const;
+        virtual void lookupList(std::string_view scope, std::string_view localName, std::vector<std::string>& data) const;
+        virtual void lookupList(std::string_view scope, std::string_view localName, StringVector& list,
+                                const StringVector& defaultList) const;
+        virtual void lookupList(std::string_view scope, std::string_view localName, StringVector& list) const;
+        virtual ListView lookupListView(std::string_view scope, std::string_view localName, ListView defaultList) const;
+        virtual ListView lookupListView(std::string_view scope, std::string_view localName) const;
+
+        virtual int lookupInt(std::string_view scope, std::string_view localName, int defaultVal) const;
+        virtual int lookupInt(std::string_view scope, std::string_view localName) const;
+
+        virtual float lookupFloat(std::string_view scope, std::string_view localName, float defaultVal) const;
+        virtual float lookupFloat(std::string_view scope, std::string_view localName) const;
+
+        virtual int lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                               const EnumNameAndValue* enumInfo, int numEnums, const char* defaultVal) const;
+        virtual int lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                               const EnumNameAndValue* enumInfo, int numEnums, int defaultVal) const;
+        virtual int lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                               const EnumNameAndValue* enumInfo, int numEnums) const;
+
+        virtual bool lookupBoolean(std::string_view scope, std::string_view localName, bool defaultVal) const;
+        virtual bool lookupBoolean(std::string_view scope, std::string_view localName) const;
+
+        virtual int lookupDurationMicroseconds(std::string_view scope, std::string_view localName, int defaultVal) const;
+        virtual int lookupDurationMicroseconds(std::string_view scope, std::string_view localName) const;
+        virtual int lookupDurationMilliseconds(std::string_view scope, std::string_view localName, int defaultVal) const;
+        virtual int lookupDurationMilliseconds(std::string_view scope, std::string_view localName) const;
+        virtual int lookupDurationSeconds(std::string_view scope, std::string_view localName, int defaultVal) const;
+        virtual int lookupDurationSeconds(std::string_view scope, std::string_view localName) const;
+
+        virtual int lookupMemorySizeBytes(std::string_view scope, std::string_view localName, int defaultVal) const;
+        virtual int lookupMemorySizeBytes(std::string_view scope, std::string_view localName) const;
+        virtual int lookupMemorySizeKB(std::string_view scope, std::string_view localName, int defaultVal) const;
+        virtual int lookupMemorySizeKB(std::string_view scope, std::string_view localName) const;
+        virtual int lookupMemorySizeMB(std::string_view scope, std::string_view localName, int defaultVal) const;
+        virtual int lookupMemorySizeMB(std::string_view scope, std::string_view localName) const;
+
+        virtual std::size_t lookupBatch(std::string_view scope, std::span<LookupRequest> requests) const;
+
+        virtual ScopeView scopeView(std::string_view scope) const;
+
         //--------
         // Update operations.
         //--------
@@ -210,13 +316,23 @@ namespace danek
         virtual void insertList(const char* scope, const char* localName, std::vector<std::string> data);
 
         virtual void insertList(const char* scope, const char* localName, const StringVector& vec);
+        virtual void insertString(std::string_view scope, std::string_view localName, std::string_view strValue);
+        virtual void insertList(std::string_view scope, std::string_view localName, std::vector<std::string> data);
+        virtual void insertList(std::string_view scope, std::string_view localName, const StringVector& vec);
 
         virtual void ensureScopeExists(const char* scope, const char* localName);
         virtual void remove(const char* scope, const char* localName);
         virtual void empty();
 
+        virtual void freeze();
+        virtual bool isFrozen() const;
+
+        virtual void setMergedIndex(bool enabled);
+        virtual bool isMergedIndexEnabled() const;
+
     protected:
         friend class ConfigParser;
+        friend class ScopeView;
 
         //--------
         // Operations called by ConfigParser
@@ -235,20 +351,68 @@ namespace danek
         //--------
         // Helper operations
         //--------
-        const ConfigItem* lookup(const char* fullyScopedName, const char* localName, bool startInRoot = false) const;
-        const ConfigItem* lookupHelper(const ConfigScope* scope, const StringVector& vec) const;
-        void stringValue(const char* fullyScopedName, const char* localName, const char*& str, ConfType& type) const;
-        void listValue(const char* fullyScopedName, const char* localName, StringVector& list, ConfType& type) const;
-        void listValue(const char* fullyScopedName, const char* localName, std::vector<std::string>& list, ConfType& type) const;
+        const ConfigItem* lookup(const util::ScopedName& name) const;
+        const ConfigItem* lookup(const util::ScopedName& name, const ConfigScope* startScope) const;
+        const ConfigItem* lookupHelper(const ConfigScope* startScope, const util::ScopedName& name,
+                                       std::string_view localName) const;
+        const ConfigItem* lookupInScope(const ConfigScope* scope, const util::ScopedName& name) const;
+        const ConfigItem* lookupInFallback(std::string_view localName) const;
+        const ConfigScope* listedScope(const util::ScopedName& name) const;
+        const ConfigItem* lookup(const ConfigKey& key) const;
+        const ConfigItem* lookup(const ScopeView& view, std::string_view localName) const;
+        const ConfigItem* lookupInResolvedScope(const ConfigScope* scopeObj, const util::ScopedName& name,
+                                                std::string_view localName) const;
+        bool resolveScope(std::string_view scope, const ConfigScope*& scopeObj) const;
+        ScopeView childView(const ScopeView& parent, std::string_view localName) const;
+        ScopeView makeScopeView(std::string name, const ConfigScope* scopeObj, bool resolved) const;
+        void storeValue(LookupRequest& request, const ConfigItem* item, const util::ScopedName& name) const;
+        const std::pmr::string& checkedStringValue(const ConfigItem* item, const util::ScopedName& name) const;
+        void checkedListValue(const ConfigItem* item, const util::ScopedName& name, std::vector<std::string>& data) const;
+        ListView checkedListView(const ConfigItem* item, const util::ScopedName& name) const;
+        bool mayExist(const util::ScopedName& name) const;
+        void noteMiss() const;
+        const FrozenIndex* mergedIndex() const;
+        void resetLookupCaches();
+        std::uint64_t generation() const;
+        void modified();
+        void checkNotFrozen() const;
+        void attachFallbackConfiguration(ConfigurationImpl* cfg, bool takeOwnership);
+        void detachFallbackConfiguration();
+        void stringValue(const util::ScopedName& name, const char*& str, ConfType& type) const;
+        void listValue(const util::ScopedName& name, StringVector& list, ConfType& type) const;
+        void listValue(const util::ScopedName& name, std::vector<std::string>& list, ConfType& type) const;
         virtual bool enumVal(const char* description, const EnumNameAndValue* enumInfo, int numEnums, int& val) const;
+        int enumValue(const util::ScopedName& name, const char* typeName, const char* strValue,
+                      const EnumNameAndValue* enumInfo, int numEnums) const;
+
+        //--------
+        // Conversions of the string value of (possibly missing) items,
+        // cached in the item
+        //--------
+        int intValue(const ConfigItem* item, const util::ScopedName& name, ConfigItem::Conversion conversion) const;
+        float floatValue(const ConfigItem* item, const util::ScopedName& name) const;
+        bool booleanValue(const ConfigItem* item, const util::ScopedName& name) const;
+        int enumValue(const ConfigItem* item, const util::ScopedName& name, const char* typeName,
+                      const EnumNameAndValue* enumInfo, int numEnums) const;
+
+        int stringToInt(const util::ScopedName& name, const char* str) const;
+        float stringToFloat(const util::ScopedName& name, const char* str) const;
+        int stringToDurationSeconds(const util::ScopedName& name, const char* str) const;
+        int stringToDurationMicroseconds(const util::ScopedName& name, const char* str) const;
+        int stringToDurationMilliseconds(const util::ScopedName& name, const char* str) const;
+        int stringToMemorySizeBytes(const util::ScopedName& name, const char* str) const;
+        int stringToMemorySizeKB(const util::ScopedName& name, const char* str) const;
+        int stringToMemorySizeMB(const util::ScopedName& name, const char* str) const;
+        void stringToFloatWithUnits(const util::ScopedName& name, const char* typeName, const char* str,
+                                    const char** allowedUnits, int allowedUnitsSize, float& floatResult,
+                                    const char*& unitsResult) const;
 
         void pushIncludedFilename(const char* fileName);
         void popIncludedFilename(const char* fileName);
         void checkForCircularIncludes(const char* fileName, int includeLineNum);
 
         int stringToMemorySizeGeneric(const char* typeName, SpellingAndValue unitsInfo[], int unitsInfoSize,
-                                      const char* allowedSizes[], const char* scope, const char* localName,
-                                      const char* str) const;
+                                      const char* allowedSizes[], const util::ScopedName& name, const char* str) const;
 
     protected:
         //--------
@@ -258,14 +422,35 @@ namespace danek
         Configuration* m_securityCfg;
         StringBuffer m_securityCfgScope;
         StringBuffer m_fileName;
-        std::unique_ptr<ConfigScope> m_rootScope;
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> m_arena;
+        std::pmr::memory_resource* m_resource;
+        ResourcePtr<ConfigScope> m_rootScope;
         ConfigScope* m_currScope;
+        ResourcePtr<FrozenIndex> m_frozenIndex;
         StringVector m_fileNameStack;
         ConfigurationImpl* m_fallbackCfg;
         bool m_amOwnerOfSecurityCfg;
         bool m_amOwnerOfFallbackCfg;
+        std::uint64_t m_generation;
+        std::vector<ConfigurationImpl*> m_dependentCfgs;
+        // Built by the lookup which finds the nth absent name, and reset
+        // whenever the tree changes
+        mutable std::unique_ptr<NameFilter> m_nameFilter;
+        mutable std::atomic<const NameFilter*> m_nameFilterView;
+        mutable std::atomic<std::uint32_t> m_misses;
+        // Covers the fallback configurations too; built by the first
+        // lookup after a change, but not while parsing
+        bool m_mergedIndexEnabled;
+        bool m_parsing;
+        mutable std::unique_ptr<FrozenIndex> m_mergedIndex;
+        mutable std::atomic<const FrozenIndex*> m_mergedIndexView;
+        mutable std::atomic<bool> m_mergedIndexStale;
 
     private:
+        // The tree is allocated from arena if there is one, else from resource
+        ConfigurationImpl(std::unique_ptr<std::pmr::monotonic_buffer_resource> arena,
+                          std::pmr::memory_resource* resource);
+
         //--------
         // The following are not implemented
         //--------
@@ -0,0 +1,103 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "danek/internal/Util.h"
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace danek
+{
+    class ConfigItem;
+    class ConfigScope;
+
+    //----------------------------------------------------------------------
+    // Class:	FrozenIndex
+    //
+    // Description:	A read-only index of all items of a configuration,
+    //		keyed by their fully scoped name.
+    //
+    //		The names are stored back to back in one buffer and the
+    //		index is a single open addressing table, so finding an
+    //		item takes one hash and (usually) one probe instead of
+    //		a walk through the nested scopes. The index refers to
+    //		the items of the tree it was built from, which must not
+    //		change while it is in use.
+    //
+    //		An index may also cover fallback configurations. Their
+    //		items are kept apart from the items of the root, so
+    //		findWithFallback() resolves a name the way a lookup
+    //		which falls back to them does, usually in one probe.
+    //----------------------------------------------------------------------
+
+    class FrozenIndex
+    {
+    public:
+        explicit FrozenIndex(const ConfigScope& root,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        // The fallback roots are ordered by precedence, nearest first
+        FrozenIndex(const ConfigScope& root, std::span<const ConfigScope* const> fallbackRoots,
+                    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        FrozenIndex(const FrozenIndex&) = delete;
+
+        const ConfigItem* find(const util::ScopedName& name) const;
+        const ConfigItem* findInFallback(const util::ScopedName& name) const;
+        const ConfigItem* findWithFallback(const util::ScopedName& name) const;
+
+        std::size_t size() const;
+
+
+        FrozenIndex& operator=(const FrozenIndex&) = delete;
+
+
+    private:
+        struct Slot
+        {
+            std::uint64_t hash;
+            std::uint32_t offset;
+            std::uint32_t length;
+            const ConfigItem* item;
+            const ConfigItem* fallbackItem;
+
+            bool used() const
+            {
+                return item != nullptr || fallbackItem != nullptr;
+            }
+        };
+
+        void collect(const ConfigScope& root, bool fallback);
+        void insert(const Slot& entry);
+        const Slot* probe(const util::ScopedName& name) const;
+        std::string_view key(const Slot& slot) const;
+
+
+        std::pmr::string m_names;
+        std::pmr::vector<Slot> m_slots;
+        std::size_t m_size;
+    };
+}
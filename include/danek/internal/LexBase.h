@@ -26,11 +26,13 @@
 #include "LexBaseSymbols.h"
 #include "LexToken.h"
 #include "MBChar.h"
+#include "PerfectHash.h"
 #include "UidIdentifierProcessor.h"
 #include "danek/Configuration.h"
 #include "danek/internal/FunctionType.h"
-#include <fstream>
-#include <wchar.h>
+#include "danek/internal/platform/Platform.h"
+#include <memory>
+#include <string>
 
 namespace danek
 {
@@ -59,22 +61,23 @@ namespace danek
         virtual ~LexBase();
 
         // The constructors of a subclass should initialize the
-        // following variables.
-        KeywordInfo* m_keywordInfoArray;
-        int m_keywordInfoArraySize;
-        FuncInfo* m_funcInfoArray;
-        int m_funcInfoArraySize;
+        // following variables; nullptr means there are none.
+        const lex::PerfectHash<KeywordInfo>* m_keywords;
+        const lex::PerfectHash<FuncInfo>* m_funcs;
 
     private:
-        void searchForKeyword(const char* spelling, bool& found, short& symbol);
-        void searchForFunction(const char* spelling, bool& found, FunctionType& funcType, short& symbol);
-
         void nextChar();
-        char nextByte();
+        void skipWhiteSpace();
         void consumeString(LexToken& token);
         void consumeBlockString(LexToken& token);
-        bool isKeywordChar(const MBChar& ch);
-        bool isIdentifierChar(const MBChar& ch);
+        void resetFromSource(LexToken& token, short type, int lineNum, const char* begin, const char* end);
+        static std::string withoutCarriageReturns(const char* begin, const char* end);
+
+        // Where the bytes of the lookahead char start in the source
+        const char* lookaheadPos() const
+        {
+            return m_ptr - m_ch.length();
+        }
 
         UidIdentifierProcessor* m_uidIdentifierProcessor;
         bool m_amOwnerOfUidIdentifierProcessor;
@@ -83,15 +86,16 @@ namespace danek
         Configuration::SourceType m_sourceType;
         const char* m_source;
         bool m_atEOF;
-        mbstate_t m_mbtowcState;
 
         //--------
-        // CFG_INPUT_FILE   uses m_file
-        // CFG_INPUT_STRING uses m_ptr and m_source
-        // CFG_INPUT_EXEC   uses m_ptr and m_execOutput
+        // All sources are scanned from m_ptr up to m_end:
+        // CFG_INPUT_FILE   in m_file, mapped or read in one go
+        // CFG_INPUT_STRING in m_source
+        // CFG_INPUT_EXEC   in m_execOutput
         //--------
-        std::ifstream m_file;
+        std::unique_ptr<platform::FileContents> m_file;
         const char* m_ptr;
+        const char* m_end;
         StringBuffer m_execOutput;
 
         // Unsupported constructors and assignment operators
@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+namespace danek::lex
+{
+    //----------------------------------------------------------------------
+    // Scanning kernels used by the lexer to move over runs of bytes that
+    // need no per-character processing. Each kernel examines a block of
+    // bytes at a time (32 with AVX2, 16 with SSE2) and falls back to a
+    // scalar loop for the tail and on other targets. The search kernels
+    // also stop at a non-ASCII byte so that the caller can decode (and
+    // validate) it.
+    //----------------------------------------------------------------------
+
+    // First byte in [begin, end) that is not ASCII white space
+    const char* skipSpace(const char* begin, const char* end);
+
+    // First '\n' or non-ASCII byte in [begin, end)
+    const char* findLineEnd(const char* begin, const char* end);
+
+    // First '"', '%', '\n', '\r' or non-ASCII byte in [begin, end)
+    const char* findStringSpecial(const char* begin, const char* end);
+
+    // First '%', '\r' or non-ASCII byte in [begin, end)
+    const char* findBlockStringSpecial(const char* begin, const char* end);
+
+    // The number of '\n' bytes in [begin, end)
+    int countNewlines(const char* begin, const char* end);
+}
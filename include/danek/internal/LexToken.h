@@ -26,6 +26,7 @@
 #include "danek/internal/FunctionType.h"
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace danek
 {
@@ -35,7 +36,7 @@ namespace danek
         LexToken();
         LexToken(short type, std::int32_t lineNum, const std::string& spelling);
 
-        const std::string& spelling() const;
+        std::string_view spelling() const;
         std::int32_t lineNum() const;
         short type() const;
 
@@ -43,13 +44,21 @@ namespace danek
         bool isListFunc() const;
         bool isBoolFunc() const;
 
-        void reset(short type, std::int32_t lineNum, const std::string& spelling);
-        void reset(short type, std::int32_t lineNum, const std::string& spelling, FunctionType funcType);
+        // The token keeps its own copy of spelling
+        void reset(short type, std::int32_t lineNum, std::string spelling);
+        void reset(short type, std::int32_t lineNum, std::string spelling, FunctionType funcType);
+
+        // The token refers to spelling, which must outlive it; used for
+        // spellings in the lexer's source and for string literals
+        void resetView(short type, std::int32_t lineNum, std::string_view spelling);
+        void resetView(short type, std::int32_t lineNum, std::string_view spelling, FunctionType funcType);
 
 
     private:
         short m_type; //  LexBaseSymbols
-        std::string m_spelling;
+        bool m_isOwned;
+        std::string_view m_viewedSpelling;
+        std::string m_ownedSpelling;
         std::int32_t m_lineNum;
         FunctionType m_funcType;
     };
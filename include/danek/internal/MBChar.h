@@ -23,10 +23,9 @@
 
 #pragma once
 
+#include "danek/internal/Utf8.h"
 #include <limits.h>
 #include <stdlib.h>
-#include <wchar.h>
-#include <wctype.h>
 
 namespace danek
 {
@@ -38,11 +37,12 @@ namespace danek
         MBChar(const MBChar&) = delete;
 
         inline bool add(char ch);
+        inline void assign(const char* bytes, int length, char32_t codePoint);
         inline const char* c_str() const;
         inline int length() const;
 
-        inline void setWChar(wchar_t wChar);
-        inline wchar_t getWChar() const;
+        inline void setCodePoint(char32_t codePoint);
+        inline char32_t codePoint() const;
 
         inline bool isSpace() const;
         inline bool isEmpty() const;
@@ -60,7 +60,7 @@ namespace danek
     private:
         char m_mbChar[MB_LEN_MAX + 1];
         short m_mbCharLen;
-        wchar_t m_wChar;
+        char32_t m_codePoint;
     };
 
     inline MBChar& MBChar::operator=(const MBChar& other)
@@ -68,7 +68,7 @@ namespace danek
         int i;
 
         m_mbCharLen = other.m_mbCharLen;
-        m_wChar = other.m_wChar;
+        m_codePoint = other.m_codePoint;
         for (i = 0; i < MB_LEN_MAX + 1; i++)
         {
             m_mbChar[i] = other.m_mbChar[i];
@@ -81,7 +81,7 @@ namespace danek
         m_mbCharLen = 1;
         m_mbChar[0] = ch;
         m_mbChar[1] = '\0';
-        m_wChar = 0;
+        m_codePoint = 0;
         return *this;
     }
 
@@ -97,19 +97,30 @@ namespace danek
         return false;
     }
 
-    inline void MBChar::setWChar(wchar_t wChar)
+    inline void MBChar::assign(const char* bytes, int length, char32_t codePoint)
     {
-        m_wChar = wChar;
+        for (int i = 0; i < length; ++i)
+        {
+            m_mbChar[i] = bytes[i];
+        }
+        m_mbChar[length] = '\0';
+        m_mbCharLen = static_cast<short>(length);
+        m_codePoint = codePoint;
+    }
+
+    inline void MBChar::setCodePoint(char32_t codePoint)
+    {
+        m_codePoint = codePoint;
     }
 
-    inline wchar_t MBChar::getWChar() const
+    inline char32_t MBChar::codePoint() const
     {
-        return m_wChar;
+        return m_codePoint;
     }
 
     inline bool MBChar::isSpace() const
     {
-        return ::iswspace(m_wChar) != 0;
+        return utf8::isSpace(m_codePoint);
     }
 
     inline int MBChar::length() const
@@ -136,7 +147,7 @@ namespace danek
     {
         m_mbCharLen = 0;
         m_mbChar[0] = '\0';
-        m_wChar = 0;
+        m_codePoint = 0;
     }
 
     inline bool MBChar::operator!=(const MBChar& other) const
@@ -0,0 +1,84 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace danek
+{
+    //----------------------------------------------------------------------
+    // Class:	ResourceDeleter
+    //
+    // Description:	Deleter for objects placed in a memory resource by
+    //		makeResourcePtr(). It destroys the object and returns its
+    //		storage to the resource it came from.
+    //----------------------------------------------------------------------
+
+    template <class T>
+    class ResourceDeleter
+    {
+    public:
+        ResourceDeleter() noexcept
+            : m_resource(nullptr)
+        {
+        }
+
+        explicit ResourceDeleter(std::pmr::memory_resource* resource) noexcept
+            : m_resource(resource)
+        {
+        }
+
+        void operator()(T* ptr) const
+        {
+            ptr->~T();
+            m_resource->deallocate(ptr, sizeof(T), alignof(T));
+        }
+
+    private:
+        std::pmr::memory_resource* m_resource;
+    };
+
+
+    template <class T>
+    using ResourcePtr = std::unique_ptr<T, ResourceDeleter<T>>;
+
+
+    template <class T, class... Args>
+    ResourcePtr<T> makeResourcePtr(std::pmr::memory_resource* resource, Args&&... args)
+    {
+        void* storage = resource->allocate(sizeof(T), alignof(T));
+
+        try
+        {
+            return ResourcePtr<T>{::new (storage) T(std::forward<Args>(args)...), ResourceDeleter<T>{resource}};
+        }
+        catch (...)
+        {
+            resource->deallocate(storage, sizeof(T), alignof(T));
+            throw;
+        }
+    }
+}
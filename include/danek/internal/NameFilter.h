@@ -0,0 +1,71 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "danek/internal/Util.h"
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace danek
+{
+    class ConfigScope;
+
+    //----------------------------------------------------------------------
+    // Class:	NameFilter
+    //
+    // Description:	A Bloom filter of the fully scoped names of all
+    //		items of a configuration, keyed by util::hashName().
+    //
+    //		mayContain() is false only for names which do not exist,
+    //		so lookups of absent names can skip the walk through the
+    //		scopes. All bits of a name are in one word, so checking
+    //		a name reads a single word. The filter is not updated;
+    //		it has to be rebuilt once the tree changes.
+    //----------------------------------------------------------------------
+
+    class NameFilter
+    {
+    public:
+        explicit NameFilter(const ConfigScope& root,
+                            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        NameFilter(const NameFilter&) = delete;
+
+        bool mayContain(std::uint64_t hash) const;
+
+        std::size_t size() const;
+
+
+        NameFilter& operator=(const NameFilter&) = delete;
+
+
+    private:
+        static std::uint64_t bitsOf(std::uint64_t hash);
+
+
+        std::pmr::vector<std::uint64_t> m_words;
+        std::size_t m_size;
+    };
+}
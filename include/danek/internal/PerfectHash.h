@@ -0,0 +1,134 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+namespace danek::lex
+{
+    //----------------------------------------------------------------------
+    // Class:	PerfectHash
+    //
+    // Description:	A collision-free hash table over a fixed set of
+    //		entries, built at compile time. Entry is a struct with a
+    //		"const char* m_spelling" member; the table refers to the
+    //		entries, which must outlive it. A lookup hashes the
+    //		spelling once and compares it to at most one entry.
+    //----------------------------------------------------------------------
+
+    template <typename Entry>
+    class PerfectHash
+    {
+    public:
+        static constexpr std::size_t maxSlots = 64;
+
+        consteval explicit PerfectHash(std::span<const Entry> entries)
+            : m_entries(entries), m_slots{}, m_mask(0), m_seed(0)
+        {
+            if (entries.size() >= maxSlots)
+            {
+                throw std::length_error("too many entries for a perfect hash");
+            }
+
+            //--------
+            // Try the smallest power-of-two table first, then larger
+            // ones, each with a range of seeds.
+            //--------
+            for (std::size_t slots = 1; slots <= maxSlots; slots *= 2)
+            {
+                if (slots < entries.size())
+                {
+                    continue;
+                }
+                for (std::uint32_t seed = 0; seed < 4096; ++seed)
+                {
+                    if (tryBuild(slots - 1, seed) == true)
+                    {
+                        return;
+                    }
+                }
+            }
+            throw std::logic_error("no perfect hash found; are there duplicate spellings?");
+        }
+
+        const Entry* find(std::string_view spelling) const
+        {
+            const std::uint8_t slot = m_slots[hash(spelling, m_seed) & m_mask];
+
+            if (slot == 0)
+            {
+                return nullptr;
+            }
+            const Entry& entry = m_entries[slot - 1];
+            return (spelling == entry.m_spelling) ? &entry : nullptr;
+        }
+
+        std::size_t size() const
+        {
+            return m_entries.size();
+        }
+
+        // Seeded FNV-1a
+        static constexpr std::uint32_t hash(std::string_view str, std::uint32_t seed)
+        {
+            std::uint32_t h = 2166136261u ^ seed;
+
+            for (const char ch : str)
+            {
+                h ^= static_cast<unsigned char>(ch);
+                h *= 16777619u;
+            }
+            return h ^ (h >> 15);
+        }
+
+    private:
+        constexpr bool tryBuild(std::uint32_t mask, std::uint32_t seed)
+        {
+            m_slots = {};
+
+            for (std::size_t i = 0; i < m_entries.size(); ++i)
+            {
+                std::uint8_t& slot = m_slots[hash(m_entries[i].m_spelling, seed) & mask];
+
+                if (slot != 0)
+                {
+                    return false;
+                }
+                slot = static_cast<std::uint8_t>(i + 1);
+            }
+            m_mask = mask;
+            m_seed = seed;
+            return true;
+        }
+
+        std::span<const Entry> m_entries;
+        std::array<std::uint8_t, maxSlots> m_slots; // entry index + 1, or 0
+        std::uint32_t m_mask;
+        std::uint32_t m_seed;
+    };
+}
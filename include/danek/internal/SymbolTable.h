@@ -0,0 +1,79 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace danek
+{
+    using SymbolId = std::uint32_t;
+
+    //----------------------------------------------------------------------
+    // Class:	SymbolTable
+    //
+    // Description:	Interns the scope and item names of a configuration.
+    //
+    //		Each distinct name is stored once and identified by a
+    //		small integer, so items compare names by id. Symbols
+    //		are never removed; ids and the interned strings stay
+    //		valid for the lifetime of the table.
+    //
+    //		The unexpanded spelling of a "uid-" name is derived once
+    //		when it is interned; other names are their own
+    //		unexpanded spelling.
+    //----------------------------------------------------------------------
+
+    class SymbolTable
+    {
+    public:
+        static constexpr SymbolId noSymbol{std::numeric_limits<SymbolId>::max()};
+
+
+        explicit SymbolTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        SymbolTable(const SymbolTable&) = delete;
+
+        SymbolId intern(std::string_view name);
+        SymbolId find(std::string_view name) const;
+
+        const std::pmr::string& name(SymbolId id) const;
+        const std::pmr::string& unexpandedName(SymbolId id) const;
+
+        std::size_t size() const;
+
+
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+
+    private:
+        std::pmr::deque<std::pmr::string> m_names;
+        std::pmr::deque<const std::pmr::string*> m_unexpanded;
+        std::pmr::deque<std::pmr::string> m_unexpandedNames;
+        std::pmr::unordered_map<std::string_view, SymbolId> m_ids;
+    };
+}
@@ -30,6 +30,11 @@ namespace danek
     class UidIdentifierDummyProcessor : public UidIdentifierProcessor
     {
     public:
+        bool needsExpanding([[maybe_unused]] std::string_view spelling) const override
+        {
+            return false;
+        }
+
         std::string expand(const std::string& spelling) override
         {
             return spelling;
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 namespace danek
 {
@@ -33,6 +34,8 @@ namespace danek
         UidIdentifierProcessor();
         virtual ~UidIdentifierProcessor() = default;
 
+        // False if expand() returns spelling unchanged
+        virtual bool needsExpanding(std::string_view spelling) const;
         virtual std::string expand(const std::string& spelling);
         virtual std::string unexpand(const std::string& spelling) const;
 
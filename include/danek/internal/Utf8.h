@@ -0,0 +1,47 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace danek::utf8
+{
+    //----------------------------------------------------------------------
+    // UTF-8 decoding which does not depend on the C locale. Overlong
+    // forms, surrogates and code points above U+10FFFF are invalid.
+    //----------------------------------------------------------------------
+
+    // Length of the run of ASCII bytes at the start of [begin, end)
+    std::size_t asciiLength(const char* begin, const char* end);
+
+    // Decodes the character at ptr and moves ptr past it; returns false,
+    // leaving ptr unchanged, if the sequence is invalid or truncated
+    bool decode(const char*& ptr, const char* end, char32_t& codePoint);
+
+    // The number of characters in str, or -1 if it is not valid UTF-8
+    std::ptrdiff_t countCodePoints(std::string_view str);
+
+    bool isSpace(char32_t codePoint);
+}
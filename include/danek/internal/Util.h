@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace danek
@@ -30,5 +32,59 @@ namespace danek
     namespace util
     {
         std::vector<std::string> splitScopes(const std::string& input);
+
+        // Hash of a fully scoped name, see ScopedName::hash()
+        std::uint64_t hashName(std::string_view name);
+
+
+        //----------------------------------------------------------------------
+        // Class:	ScopedName
+        //
+        // Description:	A non-owning view of the name formed by merging a
+        //		scope and a local name, as Configuration::mergeNames()
+        //		does. The Tokenizer yields the same components as
+        //		splitScopes() does for the merged name, without
+        //		merging or copying anything.
+        //----------------------------------------------------------------------
+
+        class ScopedName
+        {
+        public:
+            class Tokenizer
+            {
+            public:
+                explicit Tokenizer(const ScopedName& name);
+
+                bool next(std::string_view& component);
+
+            private:
+                const ScopedName& m_name;
+                std::size_t m_part;
+                std::size_t m_pos;
+                bool m_done;
+            };
+
+
+            ScopedName(std::string_view scope, std::string_view localName);
+
+            bool empty() const;
+            bool isAbsolute() const;
+            ScopedName relativeName() const;
+
+            std::string_view localName() const;
+            std::string str() const;
+
+            // The merged name is part(0), followed by '.' and part(1) if there are two parts
+            std::size_t numParts() const;
+            std::string_view part(std::size_t index) const;
+
+            // Equals hashName() of the merged name, without a trailing '.'
+            std::uint64_t hash() const;
+
+        private:
+            std::string_view m_parts[2];
+            std::size_t m_numParts;
+            std::string_view m_localName;
+        };
     }
 }
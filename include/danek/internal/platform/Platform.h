@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace danek
 {
@@ -36,5 +38,51 @@ namespace danek
 
         std::string execCmd(const std::string& cmd);
         bool isCmdInDir(const std::string& cmd, const std::string& dir);
+
+
+        //------------------------------------------------------------------
+        // Class:	FileContents
+        //
+        // Description:	The contents of a file as one contiguous, read-only
+        //		buffer. Regular files are memory-mapped where the
+        //		platform supports it; anything else (pipes, devices,
+        //		files which report no size) is read in bulk, as is a
+        //		file whose size or modification time changes while
+        //		it's mapped.
+        //
+        //		A mapped file must not be truncated while the buffer
+        //		is in use: reading the pages past its new end raises
+        //		SIGBUS. Replacing the file by renaming a new one over
+        //		it is safe, the mapping keeps the old contents.
+        //		Throws std::system_error if the file can't be read.
+        //------------------------------------------------------------------
+
+        class FileContents
+        {
+        public:
+            explicit FileContents(const std::string& fileName);
+            FileContents(const FileContents&) = delete;
+            ~FileContents();
+
+            std::string_view data() const
+            {
+                return {m_data, m_size};
+            }
+
+            bool isMapped() const
+            {
+                return m_mapped;
+            }
+
+
+            FileContents& operator=(const FileContents&) = delete;
+
+
+        private:
+            const char* m_data;
+            std::size_t m_size;
+            bool m_mapped;
+            std::string m_buffer;
+        };
     }
 }
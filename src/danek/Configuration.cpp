@@ -24,9 +24,7 @@
 #include "danek/Configuration.h"
 #include "danek/internal/Compat.h"
 #include "danek/internal/ConfigurationImpl.h"
-#include "danek/internal/MBChar.h"
-#include <stdlib.h>
-#include <string.h>
+#include "danek/internal/Utf8.h"
 
 namespace danek
 {
@@ -35,6 +33,16 @@ namespace danek
         return new ConfigurationImpl();
     }
 
+    Configuration* Configuration::create(AllocationMode mode)
+    {
+        return new ConfigurationImpl(mode);
+    }
+
+    Configuration* Configuration::create(std::pmr::memory_resource* resource)
+    {
+        return new ConfigurationImpl(resource);
+    }
+
     void Configuration::destroy()
     {
         delete this;
@@ -59,45 +67,6 @@ namespace danek
 
     int Configuration::mbstrlen(const char* str)
     {
-        char byte;
-        wchar_t wChar;
-        MBChar ch;
-        mbstate_t mbtowcState;
-
-        memset(&mbtowcState, 0, sizeof(mbtowcState));
-        int count = 0;
-        const char* ptr = str;
-        while (*ptr != '\0')
-        {
-            int status = -1;
-            while (status == -1)
-            {
-                byte = *ptr;
-                ptr++;
-                if (byte == '\0' && !ch.isEmpty())
-                {
-                    return -1; // invalid multi-byte string
-                }
-                if (byte == '\0')
-                {
-                    break;
-                }
-                if (!ch.add(byte))
-                {
-                    return -1; // invalid multi-byte string
-                }
-                status = mbrtowc(&wChar, ch.c_str(), ch.length(), &mbtowcState);
-                if (status == -1 && ch.isFull())
-                {
-                    return -1; // invalid multi-byte string
-                }
-            }
-            if (byte != '\0')
-            {
-                ++count;
-            }
-            ch.reset();
-        }
-        return count;
+        return static_cast<int>(utf8::countCodePoints(str));
     }
 }
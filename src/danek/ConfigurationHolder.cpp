@@ -0,0 +1,200 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/ConfigurationHolder.h"
+#include "danek/Configuration.h"
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace danek
+{
+    struct ConfigurationHolder::Version
+    {
+        Configuration* cfg;
+        std::uint64_t number;
+        std::atomic<std::uint64_t> references;
+    };
+
+
+    ConfigurationHolder::Snapshot::Snapshot() noexcept
+        : m_version(nullptr)
+    {
+    }
+
+    ConfigurationHolder::Snapshot::Snapshot(Version* version) noexcept
+        : m_version(version)
+    {
+    }
+
+    ConfigurationHolder::Snapshot::Snapshot(const Snapshot& other) noexcept
+        : m_version(other.m_version)
+    {
+        if (m_version != nullptr)
+        {
+            m_version->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    ConfigurationHolder::Snapshot::Snapshot(Snapshot&& other) noexcept
+        : m_version(std::exchange(other.m_version, nullptr))
+    {
+    }
+
+    ConfigurationHolder::Snapshot::~Snapshot()
+    {
+        release(m_version);
+    }
+
+    const Configuration* ConfigurationHolder::Snapshot::get() const noexcept
+    {
+        return m_version != nullptr ? m_version->cfg : nullptr;
+    }
+
+    std::uint64_t ConfigurationHolder::Snapshot::version() const noexcept
+    {
+        return m_version != nullptr ? m_version->number : 0;
+    }
+
+    ConfigurationHolder::Snapshot& ConfigurationHolder::Snapshot::operator=(Snapshot other) noexcept
+    {
+        std::swap(m_version, other.m_version);
+        return *this;
+    }
+
+
+    ConfigurationHolder::ConfigurationHolder(Configuration* cfg)
+        : m_current(makeVersion(cfg, 1)), m_readIndex(0), m_readers(), m_publishMutex()
+    {
+    }
+
+    ConfigurationHolder::~ConfigurationHolder()
+    {
+        release(m_current.load());
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	acquire()
+    //
+    // Description:	Return a snapshot of the current version.
+    //
+    // Notes:	Between loading the current version and taking a
+    //		reference to it, the reader is registered in one of
+    //		two counters; publish() does not drop its reference to
+    //		a replaced version before both counters drained. The
+    //		reader does not loop or wait on anything.
+    //----------------------------------------------------------------------
+
+    ConfigurationHolder::Snapshot ConfigurationHolder::acquire() const noexcept
+    {
+        auto& readers = m_readers[m_readIndex.load()].count;
+        readers.fetch_add(1);
+
+        const auto version = m_current.load();
+        version->references.fetch_add(1, std::memory_order_relaxed);
+
+        readers.fetch_sub(1, std::memory_order_release);
+        return Snapshot{version};
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	publish()
+    //
+    // Description:	Make cfg the current version. The configuration is
+    //		frozen; the replaced version is destroyed as soon as
+    //		no snapshot refers to it anymore.
+    //----------------------------------------------------------------------
+
+    std::uint64_t ConfigurationHolder::publish(Configuration* cfg)
+    {
+        const std::lock_guard<std::mutex> lock{m_publishMutex};
+        const auto version = makeVersion(cfg, m_current.load()->number + 1);
+        const auto replaced = m_current.exchange(version);
+
+        waitForReaders();
+        release(replaced);
+        return version->number;
+    }
+
+    std::uint64_t ConfigurationHolder::version() const noexcept
+    {
+        return m_current.load()->number;
+    }
+
+    ConfigurationHolder::Version* ConfigurationHolder::makeVersion(Configuration* cfg, std::uint64_t number)
+    {
+        if (cfg == nullptr)
+        {
+            throw std::invalid_argument{"Configuration is null"};
+        }
+        try
+        {
+            cfg->freeze();
+            return new Version{cfg, number, 1};
+        }
+        catch (...)
+        {
+            cfg->destroy();
+            throw;
+        }
+    }
+
+    void ConfigurationHolder::release(Version* version) noexcept
+    {
+        if (version != nullptr && version->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            version->cfg->destroy();
+            delete version;
+        }
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	waitForReaders()
+    //
+    // Description:	Wait until every reader which may have loaded the
+    //		replaced version holds a reference to it.
+    //
+    // Notes:	As in the left-right technique, both counters are
+    //		drained: a reader may have picked its counter before
+    //		the last switch. Readers are only registered for a few
+    //		instructions, so this wait is short.
+    //----------------------------------------------------------------------
+
+    void ConfigurationHolder::waitForReaders()
+    {
+        const auto previous = m_readIndex.load();
+        const auto next = previous ^ 1u;
+
+        while (m_readers[next].count.load() != 0)
+        {
+            std::this_thread::yield();
+        }
+
+        m_readIndex.store(next);
+
+        while (m_readers[previous].count.load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
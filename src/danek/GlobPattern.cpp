@@ -0,0 +1,137 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/GlobPattern.h"
+
+namespace danek
+{
+    namespace
+    {
+        //--------
+        // The pieces between the first and the last "*" may match anywhere
+        // in order; taking the leftmost match of each leaves the most room
+        // for the ones after it.
+        //--------
+        bool matchPieces(std::string_view str, std::string_view prefix, std::string_view middle, std::string_view suffix)
+        {
+            if (str.size() < prefix.size() + suffix.size() || str.starts_with(prefix) == false ||
+                str.ends_with(suffix) == false)
+            {
+                return false;
+            }
+            str = str.substr(prefix.size(), str.size() - prefix.size() - suffix.size());
+
+            while (middle.empty() == false)
+            {
+                const auto end = middle.find('*');
+                const auto piece = middle.substr(0, end);
+
+                if (piece.empty() == false)
+                {
+                    const auto pos = str.find(piece);
+
+                    if (pos == std::string_view::npos)
+                    {
+                        return false;
+                    }
+                    str.remove_prefix(pos + piece.size());
+                }
+                if (end == std::string_view::npos)
+                {
+                    break;
+                }
+                middle.remove_prefix(end + 1);
+            }
+            return true;
+        }
+    }
+
+
+    GlobPattern::GlobPattern(std::string_view pattern)
+        : m_pattern(pattern), m_hasWildcard(false)
+    {
+        split();
+    }
+
+    GlobPattern::GlobPattern(const GlobPattern& other)
+        : m_pattern(other.m_pattern), m_hasWildcard(false)
+    {
+        split();
+    }
+
+    bool GlobPattern::matches(std::string_view str) const
+    {
+        if (m_hasWildcard == false)
+        {
+            return str == m_pattern;
+        }
+        return matchPieces(str, m_prefix, m_middle, m_suffix);
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	matches()
+    //
+    // Description:	Match without preparing the pattern first, for
+    //		patterns which are only used once.
+    //----------------------------------------------------------------------
+
+    bool GlobPattern::matches(std::string_view str, std::string_view pattern)
+    {
+        const auto first = pattern.find('*');
+
+        if (first == std::string_view::npos)
+        {
+            return str == pattern;
+        }
+
+        const auto last = pattern.rfind('*');
+        return matchPieces(str, pattern.substr(0, first), pattern.substr(first + 1, last - first), pattern.substr(last + 1));
+    }
+
+    GlobPattern& GlobPattern::operator=(const GlobPattern& other)
+    {
+        if (this != &other)
+        {
+            m_pattern = other.m_pattern;
+            split();
+        }
+        return *this;
+    }
+
+    void GlobPattern::split()
+    {
+        const std::string_view pattern{m_pattern};
+        const auto first = pattern.find('*');
+
+        m_hasWildcard = (first != std::string_view::npos);
+
+        if (m_hasWildcard == true)
+        {
+            const auto last = pattern.rfind('*');
+
+            m_prefix = pattern.substr(0, first);
+            m_middle = pattern.substr(first + 1, last - first);
+            m_suffix = pattern.substr(last + 1);
+        }
+    }
+}
@@ -22,60 +22,10 @@
 // SOFTWARE.
 
 #include "danek/PatternMatch.h"
-#include "danek/internal/Compat.h"
-#include <stdlib.h>
-#include <string.h>
+#include "danek/GlobPattern.h"
 
 namespace danek
 {
-    namespace
-    {
-        bool patternMatchInternal(const wchar_t* wStr, int wStrIndex, int wStrLen, const wchar_t* wPattern, int wPatternIndex,
-                                  int wPatternLen)
-        {
-            while (wPatternIndex < wPatternLen)
-            {
-                if (wPattern[wPatternIndex] != '*')
-                {
-                    if (wPattern[wPatternIndex] != wStr[wStrIndex])
-                    {
-                        return false;
-                    }
-                    wPatternIndex++;
-                    if (wStrIndex < wStrLen)
-                    {
-                        wStrIndex++;
-                    }
-                }
-                else
-                {
-                    wPatternIndex++;
-                    while (wPattern[wPatternIndex] == '*')
-                    {
-                        wPatternIndex++;
-                    }
-                    if (wPatternIndex == wPatternLen)
-                    {
-                        return true;
-                    }
-                    for (; wStrIndex < wStrLen; wStrIndex++)
-                    {
-                        if (patternMatchInternal(wStr, wStrIndex, wStrLen, wPattern, wPatternIndex, wPatternLen))
-                        {
-                            return true;
-                        }
-                    }
-                }
-            }
-            if (wPattern[wPatternIndex] != wStr[wStrIndex])
-            {
-                return false;
-            }
-            return true;
-        }
-    }
-
-
     //----------------------------------------------------------------------
     // Function:    patternMatch()
     //
@@ -84,32 +34,12 @@ namespace danek
     //
     // Note:    The only wildcard supported is "*". It acts like the
     //          "*" wildcard in UNIX and DOS shells, that is, it
-    //          matches zero or more characters.
+    //          matches zero or more characters. Use a GlobPattern
+    //          to match the same pattern repeatedly.
     //----------------------------------------------------------------------
 
     bool patternMatch(const char* str, const char* pattern)
     {
-        wchar_t* wStr;
-        int wStrLen;
-        wchar_t* wPattern;
-        int wPatternLen;
-        bool result;
-        int strLen;
-        int patternLen;
-
-        strLen = strlen(str);
-        wStr = new wchar_t[strLen + 1];
-        wStrLen = mbstowcs(wStr, str, strLen + 1);
-        compat::checkAssertion(wStrLen != -1);
-
-        patternLen = strlen(pattern);
-        wPattern = new wchar_t[patternLen + 1];
-        wPatternLen = mbstowcs(wPattern, pattern, patternLen + 1);
-        compat::checkAssertion(wPatternLen != -1);
-
-        result = patternMatchInternal(wStr, 0, wStrLen, wPattern, 0, wPatternLen);
-        delete[] wStr;
-        delete[] wPattern;
-        return result;
+        return GlobPattern::matches(str, pattern);
     }
 }
@@ -0,0 +1,288 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/PatternSet.h"
+#include <algorithm>
+#include <deque>
+
+namespace danek
+{
+    namespace
+    {
+        constexpr std::uint32_t root = 0;
+        constexpr std::uint32_t none = 0xFFFFFFFF;
+
+        //--------
+        // Every literal piece of a pattern occurs in each string it
+        // matches, so the longest one is the most selective to look for.
+        //--------
+        std::string_view longestLiteral(std::string_view pattern)
+        {
+            std::string_view longest;
+
+            while (pattern.empty() == false)
+            {
+                const auto end = pattern.find('*');
+                const auto piece = pattern.substr(0, end);
+
+                if (piece.size() > longest.size())
+                {
+                    longest = piece;
+                }
+                if (end == std::string_view::npos)
+                {
+                    break;
+                }
+                pattern.remove_prefix(end + 1);
+            }
+            return longest;
+        }
+
+        //--------
+        // The patterns already verified while scanning one string; sets of
+        // up to 256 patterns don't allocate.
+        //--------
+        class Visited
+        {
+        public:
+            explicit Visited(std::size_t size)
+                : m_inline{}, m_heap((size > 64 * m_inline.size()) ? (size + 63) / 64 : 0)
+            {
+            }
+
+            bool insert(std::size_t index)
+            {
+                std::uint64_t& word = (m_heap.empty() == true) ? m_inline[index / 64] : m_heap[index / 64];
+                const std::uint64_t bit = std::uint64_t{1} << (index % 64);
+                const bool inserted = ((word & bit) == 0);
+
+                word |= bit;
+                return inserted;
+            }
+
+        private:
+            std::array<std::uint64_t, 4> m_inline;
+            std::vector<std::uint64_t> m_heap;
+        };
+    }
+
+
+    PatternSet::PatternSet()
+        : m_rootNext{}
+    {
+    }
+
+    bool PatternSet::matchesAny(std::string_view str) const
+    {
+        return forEachMatch(str, [](std::size_t) { return true; });
+    }
+
+    std::vector<std::size_t> PatternSet::matching(std::string_view str) const
+    {
+        std::vector<std::size_t> indices;
+
+        forEachMatch(str, [&indices](std::size_t index) {
+            indices.push_back(index);
+            return false;
+        });
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    }
+
+    std::size_t PatternSet::size() const
+    {
+        return m_patterns.size();
+    }
+
+    bool PatternSet::empty() const
+    {
+        return m_patterns.empty();
+    }
+
+    void PatternSet::add(std::string_view pattern)
+    {
+        m_patterns.emplace_back(pattern);
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	build()
+    //
+    // Description:	Builds the automaton over the longest literal piece
+    //		of every pattern: a trie first, then the failure and
+    //		output links breadth first, and finally the edges and
+    //		outputs flattened into arrays. The root keeps a full
+    //		table, as nearly every byte of a scan passes through it.
+    //----------------------------------------------------------------------
+
+    void PatternSet::build()
+    {
+        std::vector<std::vector<Edge>> edges(1);
+        std::vector<std::vector<std::uint32_t>> outputs(1);
+
+        for (std::size_t i = 0; i < m_patterns.size(); ++i)
+        {
+            const auto literal = longestLiteral(m_patterns[i].pattern());
+
+            if (literal.empty() == true)
+            {
+                m_withoutLiteral.push_back(i);
+                continue;
+            }
+
+            std::uint32_t state = root;
+
+            for (const char c : literal)
+            {
+                const auto byte = static_cast<unsigned char>(c);
+                auto& stateEdges = edges[state];
+                const auto it = std::find_if(stateEdges.begin(), stateEdges.end(), [byte](const Edge& e) { return e.byte == byte; });
+
+                if (it != stateEdges.end())
+                {
+                    state = it->next;
+                }
+                else
+                {
+                    const auto added = static_cast<std::uint32_t>(edges.size());
+                    stateEdges.push_back(Edge{byte, added});
+                    edges.emplace_back();
+                    outputs.emplace_back();
+                    state = added;
+                }
+            }
+            outputs[state].push_back(static_cast<std::uint32_t>(i));
+        }
+
+        m_states.assign(edges.size(), State{0, 0, root, none, 0, 0});
+
+        for (std::uint32_t s = 0; s < edges.size(); ++s)
+        {
+            auto& stateEdges = edges[s];
+            std::sort(stateEdges.begin(), stateEdges.end(), [](const Edge& a, const Edge& b) { return a.byte < b.byte; });
+
+            m_states[s].firstEdge = static_cast<std::uint32_t>(m_edges.size());
+            m_states[s].numEdges = static_cast<std::uint32_t>(stateEdges.size());
+            m_edges.insert(m_edges.end(), stateEdges.begin(), stateEdges.end());
+
+            m_states[s].firstOutput = static_cast<std::uint32_t>(m_outputs.size());
+            m_states[s].numOutputs = static_cast<std::uint32_t>(outputs[s].size());
+            m_outputs.insert(m_outputs.end(), outputs[s].begin(), outputs[s].end());
+        }
+
+        for (const Edge& e : edges[root])
+        {
+            m_rootNext[e.byte] = e.next;
+        }
+
+        std::deque<std::uint32_t> queue;
+
+        for (const Edge& e : edges[root])
+        {
+            queue.push_back(e.next);
+        }
+
+        while (queue.empty() == false)
+        {
+            const std::uint32_t s = queue.front();
+            queue.pop_front();
+
+            for (const Edge& e : edges[s])
+            {
+                State& child = m_states[e.next];
+
+                child.fail = next(m_states[s].fail, e.byte);
+
+                const State& fail = m_states[child.fail];
+                child.outputLink = (fail.numOutputs > 0) ? child.fail : fail.outputLink;
+                queue.push_back(e.next);
+            }
+        }
+    }
+
+    std::uint32_t PatternSet::next(std::uint32_t state, unsigned char byte) const
+    {
+        while (state != root)
+        {
+            const State& s = m_states[state];
+            const auto first = m_edges.begin() + s.firstEdge;
+            const auto last = first + s.numEdges;
+            const auto it = std::lower_bound(first, last, byte, [](const Edge& e, unsigned char b) { return e.byte < b; });
+
+            if (it != last && it->byte == byte)
+            {
+                return it->next;
+            }
+            state = s.fail;
+        }
+        return m_rootNext[byte];
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	forEachMatch()
+    //
+    // Description:	Calls verify() with the index of every pattern that
+    //		matches str, until it returns true. Returns whether
+    //		it did.
+    //----------------------------------------------------------------------
+
+    template <class Verify>
+    bool PatternSet::forEachMatch(std::string_view str, Verify&& verify) const
+    {
+        for (const std::size_t index : m_withoutLiteral)
+        {
+            if (m_patterns[index].matches(str) == true && verify(index) == true)
+            {
+                return true;
+            }
+        }
+
+        if (m_states.size() <= 1)
+        {
+            return false;
+        }
+
+        Visited visited{m_patterns.size()};
+        std::uint32_t state = root;
+
+        for (const char c : str)
+        {
+            state = next(state, static_cast<unsigned char>(c));
+
+            for (std::uint32_t out = state; out != none; out = m_states[out].outputLink)
+            {
+                const State& s = m_states[out];
+
+                for (std::uint32_t i = s.firstOutput; i < s.firstOutput + s.numOutputs; ++i)
+                {
+                    const std::size_t index = m_outputs[i];
+
+                    if (visited.insert(index) == true && m_patterns[index].matches(str) == true && verify(index) == true)
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+}
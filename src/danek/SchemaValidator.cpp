@@ -290,22 +290,28 @@ namespace danek
     {
         StringBuffer fullyScopedName;
         StringVector itemNames;
+        std::vector<std::string> unexpandedNames;
 
-        // Get a list of the entries in the scope.
+        // Get a list of the entries in the scope, along with their
+        // unexpanded names.
         cfg->mergeNames(scope, localName, fullyScopedName);
-        cfg->listLocallyScopedNames(scope, localName, typeMask, recurseIntoSubscopes, itemNames);
+        cfg->forEachItem(fullyScopedName.str(), typeMask, recurseIntoSubscopes,
+                         [&itemNames, &unexpandedNames](const ItemRef& item) {
+                             itemNames.push_back(std::string{item.name});
+                             unexpandedNames.emplace_back(item.unexpandedName);
+                         });
 
         // Now validte those names
-        validate(cfg, scope, localName, itemNames, forceMode);
+        validate(cfg, scope, localName, itemNames, unexpandedNames, forceMode);
     }
 
     void SchemaValidator::validate(const Configuration* cfg, const char* scope, const char* localName,
-                                   const StringVector& itemNames, ForceMode forceMode) const
+                                   const StringVector& itemNames, const std::vector<std::string>& unexpandedNames,
+                                   ForceMode forceMode) const
     {
         StringBuffer fullyScopedName;
         StringBuffer unlistedName;
         StringBuffer msg;
-        StringBuffer buf;
         const char* prefix = "---- danek::SchemaValidator::validate()";
 
         cfg->mergeNames(scope, localName, fullyScopedName);
@@ -320,7 +326,7 @@ namespace danek
         for (std::size_t i = 0; i < len; ++i)
         {
             const char* iName = itemNames[i].data();
-            const std::string unexpandedName = cfg->unexpandUid(iName, buf);
+            const std::string& unexpandedName = unexpandedNames[i];
             if (shouldIgnore(cfg, scope, iName, unexpandedName.c_str()))
             {
                 if (m_wantDiagnostics)
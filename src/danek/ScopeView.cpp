@@ -0,0 +1,263 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/ScopeView.h"
+#include "danek/internal/ConfigItem.h"
+#include "danek/internal/ConfigurationImpl.h"
+
+namespace danek
+{
+    //----------------------------------------------------------------------
+    // Function:	child()
+    //
+    // Description:	Return a view of the named scope inside this one.
+    //----------------------------------------------------------------------
+
+    ScopeView ScopeView::child(std::string_view localName) const
+    {
+        return m_owner->childView(*this, localName);
+    }
+
+    ConfType ScopeView::type(std::string_view localName) const
+    {
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? item->type() : ConfType::NoValue;
+    }
+
+    std::string_view ScopeView::lookupString(std::string_view localName, std::string_view defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+
+        if (item == nullptr)
+        {
+            return defaultVal;
+        }
+        return m_owner->checkedStringValue(item, name);
+    }
+
+    std::string_view ScopeView::lookupString(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->checkedStringValue(m_owner->lookup(*this, localName), name);
+    }
+
+    void ScopeView::lookupList(std::string_view localName, std::vector<std::string>& data, const char** defaultArray,
+                               int defaultArraySize) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+
+        if (item == nullptr)
+        {
+            data.assign(defaultArray, defaultArray + defaultArraySize);
+            return;
+        }
+        m_owner->checkedListValue(item, name, data);
+    }
+
+    void ScopeView::lookupList(std::string_view localName, std::vector<std::string>& data) const
+    {
+        const util::ScopedName name{m_name, localName};
+        m_owner->checkedListValue(m_owner->lookup(*this, localName), name, data);
+    }
+
+    void ScopeView::lookupList(std::string_view localName, StringVector& list, const StringVector& defaultList) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+
+        if (item == nullptr)
+        {
+            list = defaultList;
+            return;
+        }
+
+        std::vector<std::string> data;
+        m_owner->checkedListValue(item, name, data);
+        list = StringVector{data};
+    }
+
+    void ScopeView::lookupList(std::string_view localName, StringVector& list) const
+    {
+        const util::ScopedName name{m_name, localName};
+        std::vector<std::string> data;
+        m_owner->checkedListValue(m_owner->lookup(*this, localName), name, data);
+        list = StringVector{data};
+    }
+
+    ListView ScopeView::lookupListView(std::string_view localName, ListView defaultList) const
+    {
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->checkedListView(item, {m_name, localName}) : defaultList;
+    }
+
+    ListView ScopeView::lookupListView(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->checkedListView(m_owner->lookup(*this, localName), name);
+    }
+
+    int ScopeView::lookupInt(std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->intValue(item, name, ConfigItem::Conversion::Int) : defaultVal;
+    }
+
+    int ScopeView::lookupInt(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->intValue(m_owner->lookup(*this, localName), name, ConfigItem::Conversion::Int);
+    }
+
+    float ScopeView::lookupFloat(std::string_view localName, float defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->floatValue(item, name) : defaultVal;
+    }
+
+    float ScopeView::lookupFloat(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->floatValue(m_owner->lookup(*this, localName), name);
+    }
+
+    int ScopeView::lookupEnum(std::string_view localName, const char* typeName, const EnumNameAndValue* enumInfo,
+                              int numEnums, const char* defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->enumValue(item, name, typeName, enumInfo, numEnums)
+                               : m_owner->enumValue(name, typeName, defaultVal, enumInfo, numEnums);
+    }
+
+    int ScopeView::lookupEnum(std::string_view localName, const char* typeName, const EnumNameAndValue* enumInfo,
+                              int numEnums, int defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr
+                   ? m_owner->enumValue(item, name, typeName, enumInfo, numEnums)
+                   : defaultVal;
+    }
+
+    int ScopeView::lookupEnum(std::string_view localName, const char* typeName, const EnumNameAndValue* enumInfo,
+                              int numEnums) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->enumValue(m_owner->lookup(*this, localName), name, typeName, enumInfo, numEnums);
+    }
+
+    bool ScopeView::lookupBoolean(std::string_view localName, bool defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->booleanValue(item, name) : defaultVal;
+    }
+
+    bool ScopeView::lookupBoolean(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->booleanValue(m_owner->lookup(*this, localName), name);
+    }
+
+    int ScopeView::lookupDurationMicroseconds(std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->intValue(item, name, ConfigItem::Conversion::DurationMicroseconds) : defaultVal;
+    }
+
+    int ScopeView::lookupDurationMicroseconds(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->intValue(m_owner->lookup(*this, localName), name, ConfigItem::Conversion::DurationMicroseconds);
+    }
+
+    int ScopeView::lookupDurationMilliseconds(std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->intValue(item, name, ConfigItem::Conversion::DurationMilliseconds) : defaultVal;
+    }
+
+    int ScopeView::lookupDurationMilliseconds(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->intValue(m_owner->lookup(*this, localName), name, ConfigItem::Conversion::DurationMilliseconds);
+    }
+
+    int ScopeView::lookupDurationSeconds(std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->intValue(item, name, ConfigItem::Conversion::DurationSeconds) : defaultVal;
+    }
+
+    int ScopeView::lookupDurationSeconds(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->intValue(m_owner->lookup(*this, localName), name, ConfigItem::Conversion::DurationSeconds);
+    }
+
+    int ScopeView::lookupMemorySizeBytes(std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->intValue(item, name, ConfigItem::Conversion::MemorySizeBytes) : defaultVal;
+    }
+
+    int ScopeView::lookupMemorySizeBytes(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->intValue(m_owner->lookup(*this, localName), name, ConfigItem::Conversion::MemorySizeBytes);
+    }
+
+    int ScopeView::lookupMemorySizeKB(std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->intValue(item, name, ConfigItem::Conversion::MemorySizeKB) : defaultVal;
+    }
+
+    int ScopeView::lookupMemorySizeKB(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->intValue(m_owner->lookup(*this, localName), name, ConfigItem::Conversion::MemorySizeKB);
+    }
+
+    int ScopeView::lookupMemorySizeMB(std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{m_name, localName};
+        const ConfigItem* item = m_owner->lookup(*this, localName);
+        return item != nullptr ? m_owner->intValue(item, name, ConfigItem::Conversion::MemorySizeMB) : defaultVal;
+    }
+
+    int ScopeView::lookupMemorySizeMB(std::string_view localName) const
+    {
+        const util::ScopedName name{m_name, localName};
+        return m_owner->intValue(m_owner->lookup(*this, localName), name, ConfigItem::Conversion::MemorySizeMB);
+    }
+}
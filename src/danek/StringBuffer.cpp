@@ -111,6 +111,18 @@ namespace danek
         return *this;
     }
 
+    StringBuffer& StringBuffer::operator<<(std::string_view str)
+    {
+        m_string.append(str);
+        return *this;
+    }
+
+    StringBuffer& StringBuffer::operator<<(const char* str)
+    {
+        m_string.append(str);
+        return *this;
+    }
+
     StringBuffer& StringBuffer::operator<<(int val)
     {
         append(val);
@@ -23,61 +23,117 @@
 
 #include "danek/internal/ConfigItem.h"
 #include "danek/internal/ConfigScope.h"
-#include <regex>
-#include <sstream>
+#include <array>
+#include <stdexcept>
 
 namespace danek
 {
+    namespace
+    {
+        std::pmr::vector<std::pmr::string> makeList(const std::vector<std::string>& v, std::pmr::memory_resource* resource)
+        {
+            std::pmr::vector<std::pmr::string> list{resource};
+            list.reserve(v.size());
+
+            for (const auto& value : v)
+            {
+                list.emplace_back(std::string_view{value});
+            }
+            return list;
+        }
+
+        // Types of the alternatives of ConfigItem::Value, in order
+        constexpr std::array<ConfType, 3> valueTypes{{ConfType::String, ConfType::List, ConfType::Scope}};
+    }
 
-    ConfigItem::ConfigItem(const std::string& name, const std::string& str)
-        : m_type(ConfType::String), m_name(name), m_stringVal(str), m_listVal(), m_scope(nullptr)
+    ConfigItem::ConfigItem(const SymbolTable& symbols, SymbolId name, std::string_view str,
+                           std::pmr::memory_resource* resource)
+        : m_nameId(name), m_name(symbols.name(name)), m_unexpandedName(symbols.unexpandedName(name)),
+          m_value(std::in_place_type<std::pmr::string>, str, resource)
     {
     }
 
-    ConfigItem::ConfigItem(const std::string& name, const std::vector<std::string>& v)
-        : m_type(ConfType::List), m_name(name), m_stringVal(""), m_listVal(v), m_scope(nullptr)
+    ConfigItem::ConfigItem(const SymbolTable& symbols, SymbolId name, const std::vector<std::string>& v,
+                           std::pmr::memory_resource* resource)
+        : m_nameId(name), m_name(symbols.name(name)), m_unexpandedName(symbols.unexpandedName(name)),
+          m_value(makeList(v, resource))
     {
     }
 
-    ConfigItem::ConfigItem(const std::string& name, std::unique_ptr<ConfigScope> scope)
-        : m_type(ConfType::Scope), m_name(name), m_stringVal(""), m_listVal(), m_scope(std::move(scope))
+    ConfigItem::ConfigItem(const SymbolTable& symbols, SymbolId name, ResourcePtr<ConfigScope> scope)
+        : m_nameId(name), m_name(symbols.name(name)), m_unexpandedName(symbols.unexpandedName(name)),
+          m_value(std::move(scope))
     {
     }
 
 
     ConfType ConfigItem::type() const
     {
-        return m_type;
+        return valueTypes[m_value.index()];
     }
 
-    const std::string& ConfigItem::name() const
+    SymbolId ConfigItem::nameId() const
+    {
+        return m_nameId;
+    }
+
+    const std::pmr::string& ConfigItem::name() const
     {
         return m_name;
     }
 
-    const std::string& ConfigItem::stringVal() const
+    const std::pmr::string& ConfigItem::unexpandedName() const
+    {
+        return m_unexpandedName;
+    }
+
+    const std::pmr::string& ConfigItem::stringVal() const
     {
-        checkVariantType(ConfType::String);
-        return m_stringVal;
+        return checkedValue<std::pmr::string>();
     }
 
-    const std::vector<std::string>& ConfigItem::listVal() const
+    const std::pmr::vector<std::pmr::string>& ConfigItem::listVal() const
     {
-        checkVariantType(ConfType::List);
-        return m_listVal;
+        return checkedValue<std::pmr::vector<std::pmr::string>>();
     }
 
     ConfigScope* ConfigItem::scopeVal() const
     {
-        checkVariantType(ConfType::Scope);
-        return m_scope.get();
+        return checkedValue<ResourcePtr<ConfigScope>>().get();
     }
 
-    void ConfigItem::checkVariantType(ConfType expected) const
+    //--------
+    // The cache is a single word, so concurrent lookups always see a
+    // conversion together with its own result. The result only depends
+    // on the immutable string, hence no ordering is needed.
+    //--------
+    bool ConfigItem::cachedValue(Conversion conversion, std::int32_t& value) const
     {
-        if (m_type != expected)
+        const std::uint64_t cache = m_cache.load(std::memory_order_relaxed);
+
+        if ((cache >> 32) != static_cast<std::uint64_t>(conversion))
+        {
+            return false;
+        }
+        value = static_cast<std::int32_t>(static_cast<std::uint32_t>(cache));
+        return true;
+    }
+
+    void ConfigItem::cacheValue(Conversion conversion, std::int32_t value) const
+    {
+        const std::uint64_t cache = (static_cast<std::uint64_t>(conversion) << 32) | static_cast<std::uint32_t>(value);
+        m_cache.store(cache, std::memory_order_relaxed);
+    }
+
+    template <class T>
+    const T& ConfigItem::checkedValue() const
+    {
+        const auto value = std::get_if<T>(&m_value);
+
+        if (value == nullptr)
         {
             throw std::domain_error{"Invalid variant type"};
         }
+        return *value;
     }
 }
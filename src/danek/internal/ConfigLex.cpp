@@ -25,8 +25,7 @@
 
 namespace danek
 {
-    // This array must be kept sorted becaue we do a binary search on it.
-    static LexBase::KeywordInfo keywordInfoArray[] = {
+    static constexpr LexBase::KeywordInfo keywordInfoArray[] = {
         //----------------------------------------------------------------------
         // spelling      symbol
         //----------------------------------------------------------------------
@@ -42,10 +41,9 @@ namespace danek
         {"@remove", ConfigLex::LEX_REMOVE_SYM},
     };
 
-    const static int keywordInfoArraySize = sizeof(keywordInfoArray) / sizeof(keywordInfoArray[0]);
+    static constexpr lex::PerfectHash<LexBase::KeywordInfo> keywords{keywordInfoArray};
 
-    // This array must be kept sorted becaue we do a binary search on it.
-    static LexBase::FuncInfo funcInfoArray[] = {
+    static constexpr LexBase::FuncInfo funcInfoArray[] = {
         //----------------------------------------------------------------------
         // spelling            type             symbol
         //----------------------------------------------------------------------
@@ -65,14 +63,12 @@ namespace danek
         {"split(", FunctionType::List, ConfigLex::LEX_FUNC_SPLIT_SYM},
     };
 
-    const static int funcInfoArraySize = sizeof(funcInfoArray) / sizeof(funcInfoArray[0]);
+    static constexpr lex::PerfectHash<LexBase::FuncInfo> funcs{funcInfoArray};
 
     ConfigLex::ConfigLex(Configuration::SourceType sourceType, const char* source, UidIdentifierProcessor* uidIdentifierProcessor)
         : LexBase(sourceType, source, uidIdentifierProcessor)
     {
-        m_keywordInfoArray = keywordInfoArray;
-        m_keywordInfoArraySize = keywordInfoArraySize;
-        m_funcInfoArray = funcInfoArray;
-        m_funcInfoArraySize = funcInfoArraySize;
+        m_keywords = &keywords;
+        m_funcs = &funcs;
     }
 }
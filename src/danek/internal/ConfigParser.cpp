@@ -82,9 +82,11 @@
 #include "danek/internal/platform/Platform.h"
 #include <ctype.h>
 #include <errno.h>
-#include <fstream>
+#include <memory>
 #include <stdlib.h>
 #include <string.h>
+#include <string_view>
+#include <system_error>
 
 namespace danek
 {
@@ -661,7 +663,7 @@ namespace danek
     {
         StringBuffer fromScopeName;
         StringBuffer prefix;
-        const char* toScopeName;
+        std::string toScopeName;
         StringBuffer msg;
         ConfigScope* fromScope;
         ConfigScope* dummyScope;
@@ -687,13 +689,13 @@ namespace danek
         //--------
         // Sanity check: cannot copy from a parent scope
         //--------
-        toScopeName = m_config->getCurrScope()->scopedName().c_str();
-        if (strcmp(toScopeName, fromScopeName.str().c_str()) == 0)
+        toScopeName = m_config->getCurrScope()->scopedName();
+        if (strcmp(toScopeName.c_str(), fromScopeName.str().c_str()) == 0)
         {
             throw ConfigurationException("copy statement: cannot copy from own scope");
         }
         prefix << fromScopeName << ".";
-        if (strncmp(toScopeName, prefix.str().c_str(), fromScopeNameLen + 1) == 0)
+        if (strncmp(toScopeName.c_str(), prefix.str().c_str(), fromScopeNameLen + 1) == 0)
         {
             throw ConfigurationException("copy statement: cannot copy from a parent scope");
         }
@@ -702,7 +704,7 @@ namespace danek
         // If the scope does not exist and if "@ifExists" was specified
         // then we short-circuit the rest of this function.
         //--------
-        const ConfigItem* item = m_config->lookup(fromScopeName.str().c_str(), fromScopeName.str().c_str(), true);
+        const ConfigItem* item = m_config->lookup({"", fromScopeName.str()});
         if (item == nullptr && ifExistsIsSpecified)
         {
             accept(lex::LEX_SEMICOLON_SYM, "expecting ';'");
@@ -733,7 +735,7 @@ namespace danek
         for (std::size_t i = 0; i < fromNamesVec.size(); ++i)
         {
             const char* newName = &fromNamesVec[i][fromScopeNameLen + 1];
-            item = m_config->lookup(fromNamesVec[i].c_str(), fromNamesVec[i].c_str(), true);
+            item = m_config->lookup({"", fromNamesVec[i]});
             compat::checkAssertion(item != nullptr);
             switch (item->type())
             {
@@ -741,7 +743,8 @@ namespace danek
                     m_config->insertString("", newName, item->stringVal().c_str());
                     break;
                 case ConfType::List:
-                    m_config->insertList(newName, StringVector{item->listVal()});
+                    m_config->insertList(newName, StringVector{std::vector<std::string>(item->listVal().cbegin(),
+                                                                                        item->listVal().cend())});
                     break;
                 case ConfType::Scope:
                     m_config->ensureScopeExists(newName, dummyScope);
@@ -771,7 +774,7 @@ namespace danek
         StringBuffer msg;
 
         accept(ConfigLex::LEX_REMOVE_SYM, "expecting 'remove'");
-        identName = m_token.spelling();
+        identName = std::string{m_token.spelling()};
         accept(lex::LEX_IDENT_SYM, "expecting an identifier");
         if (strchr(identName.str().c_str(), '.') != nullptr)
         {
@@ -820,7 +823,7 @@ namespace danek
         // Create the new scope and put it onto the stack
         //--------
         oldScope = m_config->getCurrScope();
-        m_config->ensureScopeExists(scopeName.spelling().c_str(), newScope);
+        m_config->ensureScopeExists(std::string{scopeName.spelling()}.c_str(), newScope);
         m_config->setCurrScope(newScope);
 
         //--------
@@ -851,7 +854,7 @@ namespace danek
         StringBuffer msg;
         bool doAssign;
 
-        switch (m_config->type(varName.spelling().c_str(), ""))
+        switch (typeInCurrScope(varName.spelling()))
         {
             case ConfType::String:
             case ConfType::List:
@@ -901,7 +904,7 @@ namespace danek
                 // of the variable (it is either a string or a list)
                 // in order to proceed with the parsing.
                 //--------
-                switch (m_config->type(m_token.spelling().c_str(), ""))
+                switch (typeInCurrScope(m_token.spelling()))
                 {
                     case ConfType::String:
                         varType = ConfType::String;
@@ -930,14 +933,14 @@ namespace danek
                 parseStringExpr(stringExpr);
                 if (doAssign)
                 {
-                    m_config->insertString("", varName.spelling().c_str(), stringExpr.str().c_str());
+                    m_config->insertString("", varName.spelling(), stringExpr.str());
                 }
                 break;
             case ConfType::List:
                 parseListExpr(listExpr);
                 if (doAssign)
                 {
-                    m_config->insertList(varName.spelling().c_str(), listExpr);
+                    m_config->insertList("", varName.spelling(), listExpr);
                 }
                 break;
             default:
@@ -1038,7 +1041,7 @@ namespace danek
                 m_lex->nextToken(m_token);
                 parseStringExpr(name);
                 accept(lex::LEX_CLOSE_PAREN_SYM, "expecting ')'");
-                const ConfigItem* item = m_config->lookup(name.str().c_str(), name.str().c_str());
+                const ConfigItem* item = m_config->lookup({"", name.str()}, m_config->getCurrScope());
                 if (item == nullptr)
                 {
                     type = ConfType::NoValue;
@@ -1068,11 +1071,11 @@ namespace danek
             }
             break;
             case lex::LEX_STRING_SYM:
-                str = m_token.spelling();
+                str = std::string{m_token.spelling()};
                 m_lex->nextToken(m_token);
                 break;
             case lex::LEX_IDENT_SYM:
-                m_config->stringValue(m_token.spelling().c_str(), m_token.spelling().c_str(), constStr, type);
+                m_config->stringValue({"", m_token.spelling()}, constStr, type);
                 switch (type)
                 {
                     case ConfType::String:
@@ -1147,7 +1150,7 @@ namespace danek
         StringBuffer msg;
         ConfigScope* currScope;
         StringBuffer siblingName;
-        const char* parentScopeName;
+        std::string parentScopeName;
 
         accept(ConfigLex::LEX_FUNC_SIBLING_SCOPE_SYM, "expecting 'siblingScope('");
         currScope = m_config->getCurrScope();
@@ -1158,10 +1161,10 @@ namespace danek
                   false);
             return;
         }
-        parentScopeName = currScope->parentScope()->scopedName().c_str();
+        parentScopeName = currScope->parentScope()->scopedName();
         parseStringExpr(siblingName);
         accept(lex::LEX_CLOSE_PAREN_SYM, "expecting ')'");
-        Configuration::mergeNames(parentScopeName, siblingName.str().c_str(), str);
+        Configuration::mergeNames(parentScopeName.c_str(), siblingName.str().c_str(), str);
     }
 
     //----------------------------------------------------------------------
@@ -1174,27 +1177,37 @@ namespace danek
     {
         StringBuffer msg;
         StringBuffer fileName;
-        int ch;
-        std::ifstream file;
 
         accept(ConfigLex::LEX_FUNC_READ_FILE_SYM, "expecting 'read.file('");
         parseStringExpr(fileName);
         accept(lex::LEX_CLOSE_PAREN_SYM, "expecting ')'");
         str.clear();
-        file.open(fileName.str());
 
-        if (file.good() == false)
+        std::unique_ptr<platform::FileContents> file;
+        try
+        {
+            file = std::make_unique<platform::FileContents>(fileName.str());
+        }
+        catch (const std::system_error& e)
         {
-            msg << "error reading " << fileName << ": " << strerror(errno);
+            msg << "error reading " << fileName << ": " << e.code().message();
             throw ConfigurationException(msg.str());
         }
-        while ((ch = file.get()) != EOF)
+
+        //--------
+        // Copy the runs between carriage returns, which are dropped
+        //--------
+        std::string_view data = file->data();
+        std::string contents;
+        contents.reserve(data.size());
+
+        for (auto pos = data.find('\r'); pos != std::string_view::npos; pos = data.find('\r'))
         {
-            if (ch != '\r')
-            {
-                str.append(static_cast<char>(ch));
-            }
+            contents.append(data.substr(0, pos));
+            data.remove_prefix(pos + 1);
         }
+        contents.append(data);
+        str = contents;
     }
 
     //----------------------------------------------------------------------
@@ -1417,7 +1430,7 @@ namespace danek
                 //--------
                 // ident_sym: make sure the identifier is a list
                 //--------
-                m_config->listValue(m_token.spelling().c_str(), m_token.spelling().c_str(), expr, type);
+                m_config->listValue({"", m_token.spelling()}, expr, type);
                 if (type != ConfType::List)
                 {
                     msg << "identifier '" << m_token.spelling() << "' is not a list";
@@ -1431,6 +1444,19 @@ namespace danek
         }
     }
 
+    //----------------------------------------------------------------------
+    // Function:	typeInCurrScope()
+    //
+    // Description:	Returns the type of the named entry, resolving the
+    //		name relative to the scope being parsed
+    //----------------------------------------------------------------------
+
+    ConfType ConfigParser::typeInCurrScope(std::string_view name) const
+    {
+        const ConfigItem* item = m_config->lookup({"", name}, m_config->getCurrScope());
+        return item != nullptr ? item->type() : ConfType::NoValue;
+    }
+
     //----------------------------------------------------------------------
     // Function:	getDirectoryOfFile()
     //
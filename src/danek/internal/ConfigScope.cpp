@@ -23,41 +23,122 @@
 
 #include "danek/internal/ConfigScope.h"
 #include "danek/Configuration.h"
-#include "danek/PatternMatch.h"
+#include "danek/PatternSet.h"
 #include "danek/internal/ConfigItem.h"
 #include "danek/internal/ToString.h"
-#include "danek/internal/UidIdentifierProcessor.h"
 #include <algorithm>
-#include <sstream>
+#include <bit>
+#include <limits>
 
 namespace danek
 {
+    namespace
+    {
+        // Scopes up to this size are searched linearly; the index only pays off for larger ones
+        constexpr std::size_t linearScanLimit{8};
+        constexpr std::size_t minIndexSize{16};
+        constexpr std::size_t notFound{std::numeric_limits<std::size_t>::max()};
+
+        // An index slot holds the name's symbol id in the upper half and the item position + 1 (0 marks a free slot)
+        constexpr std::uint64_t freeSlot{0};
+        constexpr std::uint64_t positionMask{0xffffffff};
+        constexpr int symbolShift{32};
+
+
+        std::uint64_t hashOf(SymbolId name)
+        {
+            // Fibonacci hashing spreads the consecutive ids over the table
+            return (std::uint64_t{name} * 0x9e3779b97f4a7c15ULL) >> symbolShift;
+        }
+
+        std::uint64_t makeSlot(SymbolId name, std::size_t pos)
+        {
+            return (std::uint64_t{name} << symbolShift) | (pos + 1);
+        }
+
+        std::size_t slotPosition(std::uint64_t slot)
+        {
+            return (slot & positionMask) - 1;
+        }
+
+        SymbolId slotName(std::uint64_t slot)
+        {
+            return static_cast<SymbolId>(slot >> symbolShift);
+        }
+
+        bool slotMatches(std::uint64_t slot, SymbolId name)
+        {
+            return slotName(slot) == name;
+        }
+    }
 
-    ConfigScope::ConfigScope(ConfigScope* parentScope, const std::string& name)
-        : m_parentScope(parentScope)
+
+    ConfigScope::ConfigScope(ConfigScope* parentScope, const std::string& name, std::pmr::memory_resource* resource)
+        : m_parentScope(parentScope), m_resource(parentScope != nullptr ? parentScope->m_resource : resource),
+          m_ownSymbols(), m_symbols(nullptr), m_nameId(SymbolTable::noSymbol), m_table(m_resource), m_index(m_resource),
+          m_removed(0)
     {
-        if (m_parentScope == nullptr)
+        if (parentScope == nullptr)
         {
             if (name.empty() == false)
             {
                 throw std::invalid_argument("Name is invalid on root element");
             }
-            m_scopedName = "";
+            m_ownSymbols = makeResourcePtr<SymbolTable>(m_resource, m_resource);
+            m_symbols = m_ownSymbols.get();
         }
         else
         {
-            m_scopedName = m_parentScope->m_scopedName;
-            if (m_parentScope->m_parentScope != nullptr)
-            {
-                m_scopedName.append(".");
-            }
-            m_scopedName.append(name);
+            m_symbols = parentScope->m_symbols;
+            m_nameId = m_symbols->intern(name);
+        }
+    }
+
+    std::string ConfigScope::scopedName() const
+    {
+        if (m_parentScope == nullptr)
+        {
+            return "";
+        }
+
+        std::string name = m_parentScope->scopedName();
+        if (m_parentScope->m_parentScope != nullptr)
+        {
+            name.append(".");
+        }
+        name.append(m_symbols->name(m_nameId));
+        return name;
+    }
+
+    std::string ConfigScope::unexpandedScopedName() const
+    {
+        if (m_parentScope == nullptr)
+        {
+            return "";
         }
+
+        std::string name = m_parentScope->unexpandedScopedName();
+        if (m_parentScope->m_parentScope != nullptr)
+        {
+            name.append(".");
+        }
+        name.append(m_symbols->unexpandedName(m_nameId));
+        return name;
+    }
+
+    std::pmr::memory_resource* ConfigScope::resource() const
+    {
+        return m_resource;
+    }
+
+    SymbolTable& ConfigScope::symbols()
+    {
+        return *m_symbols;
     }
 
-    const std::string& ConfigScope::scopedName() const
+    const SymbolTable& ConfigScope::symbols() const
     {
-        return m_scopedName;
+        return *m_symbols;
     }
 
     const ConfigScope* ConfigScope::parentScope() const
@@ -78,20 +159,22 @@ namespace danek
 
     bool ConfigScope::addOrReplaceString(const std::string& name, const std::string& str)
     {
-        auto pos = std::find_if(m_table.begin(), m_table.end(), [&name](const auto& v) { return v->name() == name; });
+        const auto nameId = m_symbols->intern(name);
+        const auto pos = indexOf(nameId);
 
-        if (pos != m_table.cend())
+        if (pos != notFound)
         {
-            if ((*pos)->type() == ConfType::Scope)
+            if (m_table[pos]->type() == ConfType::Scope)
             {
                 return false;
             }
 
-            *pos = std::make_unique<ConfigItem>(name, str);
+            m_table[pos] = makeResourcePtr<ConfigItem>(m_resource, *m_symbols, nameId, str, m_resource);
         }
         else
         {
-            m_table.push_back(std::make_unique<ConfigItem>(name, str));
+            m_table.push_back(makeResourcePtr<ConfigItem>(m_resource, *m_symbols, nameId, str, m_resource));
+            addToIndex(m_table.size() - 1);
         }
 
         return true;
@@ -99,20 +182,22 @@ namespace danek
 
     bool ConfigScope::addOrReplaceList(const std::string& name, const std::vector<std::string>& list)
     {
-        auto pos = std::find_if(m_table.begin(), m_table.end(), [&name](const auto& v) { return v->name() == name; });
+        const auto nameId = m_symbols->intern(name);
+        const auto pos = indexOf(nameId);
 
-        if (pos != m_table.cend())
+        if (pos != notFound)
         {
-            if ((*pos)->type() == ConfType::Scope)
+            if (m_table[pos]->type() == ConfType::Scope)
             {
                 return false;
             }
 
-            *pos = std::make_unique<ConfigItem>(name, list);
+            m_table[pos] = makeResourcePtr<ConfigItem>(m_resource, *m_symbols, nameId, list, m_resource);
         }
         else
         {
-            m_table.push_back(std::make_unique<ConfigItem>(name, list));
+            m_table.push_back(makeResourcePtr<ConfigItem>(m_resource, *m_symbols, nameId, list, m_resource));
+            addToIndex(m_table.size() - 1);
         }
 
         return true;
@@ -120,121 +205,328 @@ namespace danek
 
     bool ConfigScope::ensureScopeExists(const std::string& name, ConfigScope*& scope)
     {
-        auto pos = std::find_if(m_table.cbegin(), m_table.cend(), [&name](const auto& v) { return v->name() == name; });
+        const auto nameId = m_symbols->intern(name);
+        const auto pos = indexOf(nameId);
 
-        if (pos != m_table.cend())
+        if (pos != notFound)
         {
-            if ((*pos)->type() != ConfType::Scope)
+            if (m_table[pos]->type() != ConfType::Scope)
             {
                 scope = nullptr;
                 return false;
             }
 
-            scope = (*pos)->scopeVal();
+            scope = m_table[pos]->scopeVal();
         }
         else
         {
-            auto item = std::make_unique<ConfigItem>(name, std::make_unique<ConfigScope>(this, name));
+            auto item = makeResourcePtr<ConfigItem>(m_resource, *m_symbols, nameId, makeResourcePtr<ConfigScope>(m_resource, this, name));
             scope = item->scopeVal();
             m_table.push_back(std::move(item));
+            addToIndex(m_table.size() - 1);
         }
 
         return true;
     }
 
-    const ConfigItem* ConfigScope::findItem(const std::string& name) const
+    const ConfigItem* ConfigScope::findItem(std::string_view name) const
     {
-        auto pos = std::find_if(m_table.cbegin(), m_table.cend(), [&name](const auto& v) { return v->name() == name; });
+        return findItem(m_symbols->find(name));
+    }
+
+    const ConfigItem* ConfigScope::findItem(SymbolId name) const
+    {
+        const auto pos = indexOf(name);
 
-        if (pos != m_table.cend())
+        if (pos != notFound)
         {
-            return pos->get();
+            return m_table[pos].get();
         }
 
         return nullptr;
     }
 
+    //----------------------------------------------------------------------
+    // Function:	removeItem()
+    //
+    // Description:	Small scopes, which have no index, erase the item.
+    //		Indexed scopes leave an empty position in its place,
+    //		so the positions of the other items stay valid, and
+    //		drop its slot from the index. The empty positions are
+    //		compacted once they make up half of the table.
+    //----------------------------------------------------------------------
+
     bool ConfigScope::removeItem(const std::string& name)
     {
-        auto pos = std::find_if(m_table.cbegin(), m_table.cend(), [&name](const auto& v) { return v->name() == name; });
+        const auto nameId = m_symbols->find(name);
+        const auto pos = indexOf(nameId);
 
-        if (pos != m_table.cend())
+        if (pos == notFound)
         {
-            m_table.erase(pos);
+            return false;
+        }
+
+        if (m_index.empty() == true)
+        {
+            m_table.erase(std::next(m_table.cbegin(), static_cast<std::ptrdiff_t>(pos)));
             return true;
         }
 
-        return false;
+        removeFromIndex(nameId);
+        m_table[pos].reset();
+        ++m_removed;
+
+        if (2 * m_removed >= m_table.size())
+        {
+            rebuildIndex();
+        }
+        return true;
     }
 
-    bool ConfigScope::contains(const std::string& name) const
+    bool ConfigScope::contains(std::string_view name) const
     {
-        return std::find_if(m_table.cbegin(), m_table.cend(), [&name](const auto& v) { return v->name() == name; }) !=
-               m_table.cend();
+        return indexOf(name) != notFound;
     }
 
     std::vector<std::string> ConfigScope::listFullyScopedNames(ConfType typeMask, bool recursive) const
     {
-        return listScopedNamesHelper(m_scopedName, typeMask, recursive, {});
+        return listScopedNamesHelper(true, typeMask, recursive, {});
     }
 
     std::vector<std::string> ConfigScope::listFullyScopedNames(ConfType typeMask, bool recursive,
                                                                const std::vector<std::string>& filterPatterns) const
     {
-        return listScopedNamesHelper(m_scopedName, typeMask, recursive, filterPatterns);
+        return listScopedNamesHelper(true, typeMask, recursive, filterPatterns);
     }
 
     std::vector<std::string> ConfigScope::listLocallyScopedNames(ConfType typeMask, bool recursive,
                                                                  const std::vector<std::string>& filterPatterns) const
     {
-        return listScopedNamesHelper("", typeMask, recursive, filterPatterns);
+        return listScopedNamesHelper(false, typeMask, recursive, filterPatterns);
     }
 
-    std::vector<std::string> ConfigScope::listScopedNamesHelper(const std::string& prefix, ConfType typeMask, bool recursive,
+    //----------------------------------------------------------------------
+    // Function:	listScopedNamesHelper()
+    //
+    // Description:	The filter patterns are matched against the
+    //		unexpanded names, which are built from the spellings
+    //		stored with the symbols.
+    //----------------------------------------------------------------------
+
+    std::vector<std::string> ConfigScope::listScopedNamesHelper(bool fullyScoped, ConfType typeMask, bool recursive,
                                                                 const std::vector<std::string>& filterPatterns) const
     {
         std::vector<std::string> vec;
         vec.reserve(m_table.size());
+        std::string prefix = (fullyScoped == true) ? scopedName() : "";
 
-        std::for_each(
-            m_table.cbegin(), m_table.cend(), [this, typeMask, &filterPatterns, &prefix, &vec, recursive](const auto& v) {
-                std::stringstream scopedName;
-                scopedName << prefix;
-
-                if (prefix.empty() == false)
-                {
-                    scopedName << ".";
-                }
-                scopedName << v->name();
-
-                if ((static_cast<int>(v->type()) & static_cast<int>(typeMask)) &&
-                    this->listFilter(scopedName.str(), filterPatterns))
-                {
-                    vec.push_back(scopedName.str());
-                }
-
-                if (recursive && v->type() == ConfType::Scope)
-                {
-                    const auto result = v->scopeVal()->listScopedNamesHelper(scopedName.str(), typeMask, true, filterPatterns);
-                    vec.insert(vec.cend(), result.cbegin(), result.cend());
-                }
-            });
+        if (filterPatterns.empty() == true)
+        {
+            forEachItem(typeMask, recursive, prefix, [&vec](std::string_view name, const ConfigItem&) { vec.emplace_back(name); });
+            return vec;
+        }
+
+        const PatternSet patterns{filterPatterns};
+        std::string unexpandedPrefix = (fullyScoped == true) ? unexpandedScopedName() : "";
 
+        forEachItem(typeMask, recursive, prefix, unexpandedPrefix,
+                    [&patterns, &vec](std::string_view name, std::string_view unexpandedName, const ConfigItem&) {
+                        if (patterns.matchesAny(unexpandedName) == true)
+                        {
+                            vec.emplace_back(name);
+                        }
+                    });
         return vec;
     }
 
-    bool ConfigScope::listFilter(const std::string& name, const std::vector<std::string>& filterPatterns) const
+    //----------------------------------------------------------------------
+    // Function:	forEachItem()
+    //
+    // Description:	Walk the items in insertion order, each followed by
+    //		the items of its scope if recursive. The scoped names
+    //		are built in place in a single buffer, so the walk
+    //		allocates nothing once the buffer has grown to the
+    //		longest name.
+    //----------------------------------------------------------------------
+
+    void ConfigScope::forEachItem(ConfType typeMask, bool recursive, std::string& name, ItemCallback callback) const
     {
-        if (filterPatterns.empty() == true)
+        const auto prefixLength = name.size();
+
+        for (const auto& item : m_table)
         {
-            return true;
+            if (item == nullptr)
+            {
+                continue;
+            }
+            if (prefixLength != 0)
+            {
+                name.push_back('.');
+            }
+            name.append(item->name());
+
+            if ((static_cast<int>(item->type()) & static_cast<int>(typeMask)) != 0)
+            {
+                callback(name, *item);
+            }
+            if (recursive == true && item->type() == ConfType::Scope)
+            {
+                item->scopeVal()->forEachItem(typeMask, true, name, callback);
+            }
+            name.resize(prefixLength);
         }
+    }
+
+    void ConfigScope::forEachItem(ConfType typeMask, bool recursive, std::string& name, std::string& unexpandedName,
+                                  UnexpandedItemCallback callback) const
+    {
+        const auto prefixLength = name.size();
+        const auto unexpandedPrefixLength = unexpandedName.size();
+
+        for (const auto& item : m_table)
+        {
+            if (item == nullptr)
+            {
+                continue;
+            }
+            if (prefixLength != 0)
+            {
+                name.push_back('.');
+                unexpandedName.push_back('.');
+            }
+            name.append(item->name());
+            unexpandedName.append(item->unexpandedName());
 
-        UidIdentifierProcessor uidProc;
-        const auto unexpandedName = uidProc.unexpand(name);
+            if ((static_cast<int>(item->type()) & static_cast<int>(typeMask)) != 0)
+            {
+                callback(name, unexpandedName, *item);
+            }
+            if (recursive == true && item->type() == ConfType::Scope)
+            {
+                item->scopeVal()->forEachItem(typeMask, true, name, unexpandedName, callback);
+            }
+            name.resize(prefixLength);
+            unexpandedName.resize(unexpandedPrefixLength);
+        }
+    }
+
+    std::size_t ConfigScope::indexOf(std::string_view name) const
+    {
+        return indexOf(m_symbols->find(name));
+    }
 
-        return std::any_of(filterPatterns.cbegin(), filterPatterns.cend(), [&unexpandedName](const auto& value) {
-            return patternMatch(unexpandedName.c_str(), value.c_str());
-        });
+    std::size_t ConfigScope::indexOf(SymbolId name) const
+    {
+        if (name == SymbolTable::noSymbol)
+        {
+            return notFound;
+        }
+
+        if (m_index.empty() == true)
+        {
+            const auto pos = std::find_if(m_table.cbegin(), m_table.cend(), [name](const auto& v) { return v->nameId() == name; });
+            return pos != m_table.cend() ? static_cast<std::size_t>(std::distance(m_table.cbegin(), pos)) : notFound;
+        }
+
+        const auto mask = m_index.size() - 1;
+
+        for (auto i = hashOf(name) & mask; m_index[i] != freeSlot; i = (i + 1) & mask)
+        {
+            if (slotMatches(m_index[i], name) == true)
+            {
+                return slotPosition(m_index[i]);
+            }
+        }
+
+        return notFound;
+    }
+
+    void ConfigScope::addToIndex(std::size_t pos)
+    {
+        if (m_table.size() <= linearScanLimit)
+        {
+            return;
+        }
+
+        if (m_index.size() < 2 * m_table.size())
+        {
+            rebuildIndex();
+            return;
+        }
+
+        const auto name = m_table[pos]->nameId();
+        const auto mask = m_index.size() - 1;
+        auto i = hashOf(name) & mask;
+
+        while (m_index[i] != freeSlot)
+        {
+            i = (i + 1) & mask;
+        }
+        m_index[i] = makeSlot(name, pos);
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	removeFromIndex()
+    //
+    // Description:	Backward-shift deletion: the slots following the
+    //		removed one in its probe run move up into the hole,
+    //		unless that would put them before their home slot.
+    //		The index needs no markers for removed slots.
+    //----------------------------------------------------------------------
+
+    void ConfigScope::removeFromIndex(SymbolId name)
+    {
+        const auto mask = m_index.size() - 1;
+        auto hole = hashOf(name) & mask;
+
+        while (slotMatches(m_index[hole], name) == false)
+        {
+            hole = (hole + 1) & mask;
+        }
+
+        for (auto i = (hole + 1) & mask; m_index[i] != freeSlot; i = (i + 1) & mask)
+        {
+            const auto home = hashOf(slotName(m_index[i])) & mask;
+
+            if (((i - home) & mask) >= ((i - hole) & mask))
+            {
+                m_index[hole] = m_index[i];
+                hole = i;
+            }
+        }
+        m_index[hole] = freeSlot;
+    }
+
+    void ConfigScope::rebuildIndex()
+    {
+        if (m_removed != 0)
+        {
+            std::erase_if(m_table, [](const auto& item) { return item == nullptr; });
+            m_removed = 0;
+        }
+
+        m_index.clear();
+
+        if (m_table.size() <= linearScanLimit)
+        {
+            m_index.shrink_to_fit();
+            return;
+        }
+
+        // Keep the load factor at or below 1/2 until the next rebuild
+        m_index.resize(std::bit_ceil(std::max(minIndexSize, 4 * m_table.size())), freeSlot);
+        const auto mask = m_index.size() - 1;
+
+        for (std::size_t pos = 0; pos < m_table.size(); ++pos)
+        {
+            const auto name = m_table[pos]->nameId();
+            auto i = hashOf(name) & mask;
+
+            while (m_index[i] != freeSlot)
+            {
+                i = (i + 1) & mask;
+            }
+            m_index[i] = makeSlot(name, pos);
+        }
     }
 }
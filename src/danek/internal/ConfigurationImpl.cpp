@@ -22,7 +22,7 @@
 // SOFTWARE.
 
 #include "danek/internal/ConfigurationImpl.h"
-#include "danek/PatternMatch.h"
+#include "danek/PatternSet.h"
 #include "danek/internal/Common.h"
 #include "danek/internal/Compat.h"
 #include "danek/internal/ConfigItem.h"
@@ -32,17 +32,149 @@
 #include "danek/internal/Util.h"
 #include "danek/internal/platform/Platform.h"
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
 #include <ctype.h>
+#include <errno.h>
 #include <sstream>
 #include <stdlib.h>
 #include <string.h>
+#include <string_view>
 
 namespace danek
 {
+    namespace
+    {
+        //--------
+        // Generations are unique across all configuration objects, so
+        // a key can never match a configuration it was not resolved by
+        //--------
+        std::uint64_t nextGeneration()
+        {
+            static std::atomic<std::uint64_t> counter{0};
+            return ++counter;
+        }
+
+        //--------
+        // A scope without empty components ("a..b", "a.") resolves to
+        // the same entries on its own as when merged with a local name
+        //--------
+        bool hasEmptyComponent(std::string_view name)
+        {
+            return name.empty() == true || name.front() == '.' || name.back() == '.' ||
+                   name.find("..") != std::string_view::npos;
+        }
+
+        template <class T>
+        T& destinationOf(LookupRequest& request)
+        {
+            const auto destination = std::get_if<T*>(&request.destination);
+
+            if (destination == nullptr || *destination == nullptr)
+            {
+                throw ConfigurationException("the destination does not match the type of the request");
+            }
+            return **destination;
+        }
+
+        //--------
+        // Parses "<float> <units>" the way "ss >> float >> string" does,
+        // but without the stream and string allocations. The units are
+        // returned as a view into str.
+        //--------
+        bool parseFloatWithUnits(const char* str, float& value, std::string_view& units)
+        {
+            const char* ptr = str;
+            while (isspace(static_cast<unsigned char>(*ptr)))
+            {
+                ++ptr;
+            }
+
+            const char* end = ptr;
+            if (*end == '+' || *end == '-')
+            {
+                ++end;
+            }
+            bool haveDigits = false;
+            while (isdigit(static_cast<unsigned char>(*end)))
+            {
+                ++end;
+                haveDigits = true;
+            }
+            if (*end == '.')
+            {
+                ++end;
+                while (isdigit(static_cast<unsigned char>(*end)))
+                {
+                    ++end;
+                    haveDigits = true;
+                }
+            }
+            if (!haveDigits)
+            {
+                return false;
+            }
+
+            char* parsedEnd;
+            errno = 0;
+            const float parsed = strtof(ptr, &parsedEnd);
+            if (parsedEnd < end || (errno == ERANGE && std::isinf(parsed)))
+            {
+                return false;
+            }
+            if (parsedEnd > end && *end != 'e' && *end != 'E')
+            {
+                // strtof() accepts hex and inf/nan spellings, streams do not
+                return false;
+            }
+
+            const char* unitsBegin = parsedEnd;
+            while (isspace(static_cast<unsigned char>(*unitsBegin)))
+            {
+                ++unitsBegin;
+            }
+            const char* unitsEnd = unitsBegin;
+            while (*unitsEnd != '\0' && !isspace(static_cast<unsigned char>(*unitsEnd)))
+            {
+                ++unitsEnd;
+            }
+            if (unitsBegin == unitsEnd)
+            {
+                return false;
+            }
+
+            value = parsed;
+            units = std::string_view{unitsBegin, static_cast<std::size_t>(unitsEnd - unitsBegin)};
+            return true;
+        }
+    }
+
     ConfigurationImpl::ConfigurationImpl()
-        : m_securityCfg(&DefaultSecurityConfiguration::singleton), m_fileName("<no file>"),
-          m_rootScope(std::make_unique<ConfigScope>(nullptr, "")), m_currScope(m_rootScope.get()), m_fallbackCfg(nullptr),
-          m_amOwnerOfSecurityCfg(false), m_amOwnerOfFallbackCfg(false)
+        : ConfigurationImpl(std::pmr::get_default_resource())
+    {
+    }
+
+    ConfigurationImpl::ConfigurationImpl(Configuration::AllocationMode mode)
+        : ConfigurationImpl(mode == AllocationMode::Arena ? std::make_unique<std::pmr::monotonic_buffer_resource>() : nullptr,
+                            std::pmr::get_default_resource())
+    {
+    }
+
+    ConfigurationImpl::ConfigurationImpl(std::pmr::memory_resource* resource)
+        : ConfigurationImpl(nullptr, resource)
+    {
+    }
+
+    ConfigurationImpl::ConfigurationImpl(std::unique_ptr<std::pmr::monotonic_buffer_resource> arena,
+                                         std::pmr::memory_resource* resource)
+        : m_securityCfg(&DefaultSecurityConfiguration::singleton), m_fileName("<no file>"), m_arena(std::move(arena)),
+          m_resource(m_arena != nullptr ? m_arena.get() : resource),
+          m_rootScope(makeResourcePtr<ConfigScope>(m_resource, nullptr, "", m_resource)), m_currScope(m_rootScope.get()),
+          m_frozenIndex(), m_fallbackCfg(nullptr), m_amOwnerOfSecurityCfg(false), m_amOwnerOfFallbackCfg(false),
+          m_generation(nextGeneration()), m_nameFilter(), m_nameFilterView(nullptr), m_misses(0),
+          m_mergedIndexEnabled(false), m_parsing(false), m_mergedIndex(), m_mergedIndexView(nullptr),
+          m_mergedIndexStale(false)
     {
     }
 
@@ -52,20 +184,20 @@ namespace danek
         {
             m_securityCfg->destroy();
         }
-        if (m_amOwnerOfFallbackCfg)
+        detachFallbackConfiguration();
+
+        for (auto dependent : m_dependentCfgs)
         {
-            m_fallbackCfg->destroy();
+            dependent->m_fallbackCfg = nullptr;
+            dependent->m_amOwnerOfFallbackCfg = false;
+            dependent->modified();
         }
     }
 
     void ConfigurationImpl::setFallbackConfiguration(Configuration* cfg)
     {
-        if (m_amOwnerOfFallbackCfg)
-        {
-            m_fallbackCfg->destroy();
-        }
-        m_fallbackCfg = static_cast<ConfigurationImpl*>(cfg);
-        m_amOwnerOfFallbackCfg = false;
+        detachFallbackConfiguration();
+        attachFallbackConfiguration(static_cast<ConfigurationImpl*>(cfg), false);
     }
 
     void ConfigurationImpl::setFallbackConfiguration(Configuration::SourceType sourceType, const char* source,
@@ -86,12 +218,38 @@ namespace danek
             throw ConfigurationException(msg.str());
         }
 
+        detachFallbackConfiguration();
+        attachFallbackConfiguration(static_cast<ConfigurationImpl*>(cfg), true);
+    }
+
+    void ConfigurationImpl::attachFallbackConfiguration(ConfigurationImpl* cfg, bool takeOwnership)
+    {
+        m_fallbackCfg = cfg;
+        m_amOwnerOfFallbackCfg = takeOwnership;
+
+        if (m_fallbackCfg != nullptr)
+        {
+            m_fallbackCfg->m_dependentCfgs.push_back(this);
+        }
+        modified();
+    }
+
+    void ConfigurationImpl::detachFallbackConfiguration()
+    {
+        if (m_fallbackCfg == nullptr)
+        {
+            return;
+        }
+
+        auto& dependents = m_fallbackCfg->m_dependentCfgs;
+        dependents.erase(std::remove(dependents.begin(), dependents.end(), this), dependents.end());
+
         if (m_amOwnerOfFallbackCfg)
         {
             m_fallbackCfg->destroy();
         }
-        m_fallbackCfg = static_cast<ConfigurationImpl*>(cfg);
-        m_amOwnerOfFallbackCfg = true;
+        m_fallbackCfg = nullptr;
+        m_amOwnerOfFallbackCfg = false;
     }
 
     const Configuration* ConfigurationImpl::getFallbackConfiguration()
@@ -160,6 +318,8 @@ namespace danek
     {
         StringBuffer trustedCmdLine;
 
+        checkNotFrozen();
+
         switch (sourceType)
         {
             case Configuration::SourceType::File:
@@ -197,25 +357,31 @@ namespace danek
                 throw std::exception{}; // Bug!
                 break;
         }
-        ConfigParser parser(sourceType, source, trustedCmdLine.str().c_str(), m_fileName.str().c_str(), this);
-    }
+        modified();
 
-    ConfType ConfigurationImpl::type(const char* scope, const char* localName) const
-    {
-        ConfType result;
-        StringBuffer fullyScopedName;
-
-        mergeNames(scope, localName, fullyScopedName);
-        const ConfigItem* item = lookup(fullyScopedName.str().c_str(), localName);
-        if (item == nullptr)
+        //--------
+        // Lookups while parsing may build the name filter of a partial tree.
+        // The merged index is not rebuilt until the parse is complete.
+        //--------
+        m_parsing = true;
+        try
         {
-            result = ConfType::NoValue;
+            ConfigParser parser(sourceType, source, trustedCmdLine.str().c_str(), m_fileName.str().c_str(), this);
         }
-        else
+        catch (...)
         {
-            result = item->type();
+            m_parsing = false;
+            resetLookupCaches();
+            throw;
         }
-        return result;
+        m_parsing = false;
+        resetLookupCaches();
+    }
+
+    ConfType ConfigurationImpl::type(const char* scope, const char* localName) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+        return item != nullptr ? item->type() : ConfType::NoValue;
     }
 
     //----------------------------------------------------------------------
@@ -225,10 +391,9 @@ namespace danek
     //		entry. Indicates success/failure via the "status" parameter.
     //----------------------------------------------------------------------
 
-    void ConfigurationImpl::stringValue(const char* fullyScopedName, const char* localName, const char*& str,
-                                        ConfType& type) const
+    void ConfigurationImpl::stringValue(const util::ScopedName& name, const char*& str, ConfType& type) const
     {
-        const ConfigItem* item = lookup(fullyScopedName, localName);
+        const ConfigItem* item = lookup(name, m_currScope);
         if (item == nullptr)
         {
             type = ConfType::NoValue;
@@ -255,10 +420,9 @@ namespace danek
     //		entry.
     //----------------------------------------------------------------------
 
-    void ConfigurationImpl::listValue(const char* fullyScopedName, const char* localName, StringVector& list,
-                                      ConfType& type) const
+    void ConfigurationImpl::listValue(const util::ScopedName& name, StringVector& list, ConfType& type) const
     {
-        const ConfigItem* item = lookup(fullyScopedName, localName);
+        const ConfigItem* item = lookup(name, m_currScope);
         if (item == nullptr)
         {
             type = ConfType::NoValue;
@@ -269,7 +433,7 @@ namespace danek
             type = item->type();
             if (type == ConfType::List)
             {
-                list = StringVector{item->listVal()};
+                list = StringVector{std::vector<std::string>(item->listVal().cbegin(), item->listVal().cend())};
             }
             else
             {
@@ -284,10 +448,9 @@ namespace danek
     // Description:	Return the list, if any, associated with the named entry.
     //----------------------------------------------------------------------
 
-    void ConfigurationImpl::listValue(const char* fullyScopedName, const char* localName, std::vector<std::string>& data,
-                                      ConfType& type) const
+    void ConfigurationImpl::listValue(const util::ScopedName& name, std::vector<std::string>& data, ConfType& type) const
     {
-        const ConfigItem* item = lookup(fullyScopedName, localName);
+        const ConfigItem* item = lookup(name, m_currScope);
         if (item == nullptr)
         {
             type = ConfType::NoValue;
@@ -298,7 +461,7 @@ namespace danek
             type = item->type();
             if (type == ConfType::List)
             {
-                data = item->listVal();
+                data.assign(item->listVal().cbegin(), item->listVal().cend());
             }
             else
             {
@@ -316,19 +479,25 @@ namespace danek
     //----------------------------------------------------------------------
 
     void ConfigurationImpl::insertString(const char* scope, const char* localName, const char* str)
+    {
+        insertString(std::string_view{scope}, std::string_view{localName}, std::string_view{str});
+    }
+
+    void ConfigurationImpl::insertString(std::string_view scope, std::string_view localName, std::string_view str)
     {
         ConfigScope* scopeObj;
-        StringBuffer fullyScopedName;
+        const std::string fullyScopedName = util::ScopedName{scope, localName}.str();
 
-        mergeNames(scope, localName, fullyScopedName);
-        StringVector vec{util::splitScopes(fullyScopedName.str())};
+        checkNotFrozen();
+        StringVector vec{util::splitScopes(fullyScopedName)};
         const auto len = vec.size();
+        modified();
         ensureScopeExists(vec, 0, len - 2, scopeObj);
-        if (!scopeObj->addOrReplaceString(vec[len - 1].c_str(), str))
+        if (!scopeObj->addOrReplaceString(vec[len - 1], std::string{str}))
         {
             std::stringstream msg;
             msg << fileName() << ": "
-                << "variable '" << fullyScopedName.str() << "' was previously used as a scope";
+                << "variable '" << fullyScopedName << "' was previously used as a scope";
             throw ConfigurationException(msg.str());
         }
     }
@@ -351,20 +520,26 @@ namespace danek
     //----------------------------------------------------------------------
 
     void ConfigurationImpl::insertList(const char* scope, const char* localName, std::vector<std::string> data)
+    {
+        insertList(std::string_view{scope}, std::string_view{localName}, std::move(data));
+    }
+
+    void ConfigurationImpl::insertList(std::string_view scope, std::string_view localName, std::vector<std::string> data)
     {
         ConfigScope* scopeObj;
-        StringBuffer fullyScopedName;
+        const std::string fullyScopedName = util::ScopedName{scope, localName}.str();
 
-        mergeNames(scope, localName, fullyScopedName);
-        StringVector vec{util::splitScopes(fullyScopedName.str())};
+        checkNotFrozen();
+        StringVector vec{util::splitScopes(fullyScopedName)};
         const auto len = vec.size();
+        modified();
         ensureScopeExists(vec, 0, len - 2, scopeObj);
 
-        if (!scopeObj->addOrReplaceList(vec[len - 1].c_str(), data))
+        if (!scopeObj->addOrReplaceList(vec[len - 1], data))
         {
             std::stringstream msg;
             msg << fileName() << ": "
-                << "variable '" << fullyScopedName.str() << "' was previously used as a scope";
+                << "variable '" << fullyScopedName << "' was previously used as a scope";
             throw ConfigurationException(msg.str());
         }
     }
@@ -382,6 +557,11 @@ namespace danek
         insertList(scope, localName, vec.get());
     }
 
+    void ConfigurationImpl::insertList(std::string_view scope, std::string_view localName, const StringVector& vec)
+    {
+        insertList(scope, localName, vec.get());
+    }
+
     //----------------------------------------------------------------------
     // Function:	insertList()
     //
@@ -394,8 +574,10 @@ namespace danek
     {
         ConfigScope* scope;
 
+        checkNotFrozen();
         StringVector vec{util::splitScopes(name)};
         const auto len = vec.size();
+        modified();
         ensureScopeExists(vec, 0, len - 2, scope);
 
         if (!scope->addOrReplaceList(vec[len - 1].c_str(), list.get()))
@@ -419,6 +601,8 @@ namespace danek
         std::size_t i;
 
         ConfigScope* scopeObj = m_currScope;
+        checkNotFrozen();
+        modified();
         mergeNames(scope, localName, fullyScopedName);
         StringVector vec{util::splitScopes(fullyScopedName.str())};
         const std::size_t len = vec.size();
@@ -447,84 +631,222 @@ namespace danek
     //----------------------------------------------------------------------
     // Function:	empty()
     //
-    // Description:	Re-initialize the configuration object
+    // Description:	Re-initialize the configuration object. An arena is
+    //		released as a whole once the old tree is destroyed. A
+    //		frozen configuration becomes writable again.
     //----------------------------------------------------------------------
 
     void ConfigurationImpl::empty()
     {
         m_fileName = "<no file>";
-        m_rootScope = std::make_unique<ConfigScope>(nullptr, "");
+        modified();
+        m_frozenIndex.reset();
+        m_currScope = nullptr;
+        m_rootScope.reset();
+
+        if (m_arena != nullptr)
+        {
+            m_arena->release();
+        }
+        m_rootScope = makeResourcePtr<ConfigScope>(m_resource, nullptr, "", m_resource);
         m_currScope = m_rootScope.get();
     }
 
-    const ConfigItem* ConfigurationImpl::lookup(const char* fullyScopedName, const char* localName, bool startInRoot) const
+    //----------------------------------------------------------------------
+    // Function:	freeze()
+    //
+    // Description:	Index all items by their fully scoped name, so
+    //		lookups need a single probe instead of walking the
+    //		scopes. The configuration is read-only from now on;
+    //		freezing it again has no effect.
+    //----------------------------------------------------------------------
+
+    void ConfigurationImpl::freeze()
+    {
+        if (m_frozenIndex == nullptr)
+        {
+            compat::checkAssertion(m_currScope == m_rootScope.get());
+            m_frozenIndex = makeResourcePtr<FrozenIndex>(m_resource, *m_rootScope, m_resource);
+        }
+    }
+
+    bool ConfigurationImpl::isFrozen() const
+    {
+        return m_frozenIndex != nullptr;
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	setMergedIndex()
+    //
+    // Description:	Index the items of this configuration and of its
+    //		fallback configurations together. Unlike freeze(), this
+    //		keeps the configuration writable: any change to either
+    //		side drops the index and the next lookup rebuilds it.
+    //----------------------------------------------------------------------
+
+    void ConfigurationImpl::setMergedIndex(bool enabled)
+    {
+        m_mergedIndexEnabled = enabled;
+        resetLookupCaches();
+        mergedIndex();
+    }
+
+    bool ConfigurationImpl::isMergedIndexEnabled() const
+    {
+        return m_mergedIndexEnabled;
+    }
+
+    void ConfigurationImpl::checkNotFrozen() const
     {
-        StringVector vec;
-        const ConfigScope* scope;
+        if (isFrozen() == true)
+        {
+            std::stringstream msg;
+            msg << fileName() << ": the configuration is frozen and cannot be modified";
+            throw ConfigurationException(msg.str());
+        }
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	lookup()
+    //
+    // Description:	Find the named entry in the root scope, and finally
+    //		in the fallback configuration.
+    //
+    // Notes:	This is on the path of every lookup*() operation, so
+    //		it works on views of the names and does not allocate.
+    //		It only reads the configuration (in particular not the
+    //		current scope of the parser), so any number of threads
+    //		may call it concurrently while no one modifies the
+    //		configuration.
+    //----------------------------------------------------------------------
 
-        if (fullyScopedName[0] == '\0')
+    const ConfigItem* ConfigurationImpl::lookup(const util::ScopedName& name) const
+    {
+        if (name.empty() == true)
         {
             return nullptr;
         }
-        if (fullyScopedName[0] == '.')
+
+        const util::ScopedName relativeName = (name.isAbsolute() == true ? name.relativeName() : name);
+        const ConfigItem* item = nullptr;
+        const FrozenIndex* merged = mergedIndex();
+
+        //--------
+        // The index resolves the fallback by the local name as it is, so
+        // leave names which are not taken verbatim to the fallback lookup
+        //--------
+        if (merged != nullptr && hasEmptyComponent(name.localName()) == false)
+        {
+            return merged->findWithFallback(relativeName);
+        }
+        if (merged != nullptr)
         {
-            //--------
-            // Search only in the root scope and skip over '.'
-            //--------
-            vec = StringVector{util::splitScopes(&fullyScopedName[1])};
-            scope = m_rootScope.get();
+            item = merged->find(relativeName);
         }
-        else if (startInRoot)
+        else if (m_frozenIndex != nullptr)
         {
-            //--------
-            // Search only in the root scope
-            //--------
-            vec = StringVector{util::splitScopes(fullyScopedName)};
-            scope = m_rootScope.get();
+            item = m_frozenIndex->find(relativeName);
         }
-        else
+        else if (mayExist(relativeName) == true)
+        {
+            item = lookupInScope(m_rootScope.get(), relativeName);
+
+            if (item == nullptr)
+            {
+                noteMiss();
+            }
+        }
+
+        if (item == nullptr)
+        {
+            item = lookupInFallback(name.localName());
+        }
+        return item;
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	lookup()
+    //
+    // Description:	Find the named entry, starting in the given scope
+    //		and moving outwards, and finally in the fallback
+    //		configuration. The parser uses this to resolve names
+    //		relative to the scope it is in.
+    //----------------------------------------------------------------------
+
+    const ConfigItem* ConfigurationImpl::lookup(const util::ScopedName& name, const ConfigScope* startScope) const
+    {
+        if (name.empty() == true)
+        {
+            return nullptr;
+        }
+        if (name.isAbsolute() == true)
         {
             //--------
-            // Start search from the current scope
+            // Search only in the root scope and skip over '.'
             //--------
-            vec = StringVector{util::splitScopes(fullyScopedName)};
-            scope = m_currScope;
+            return lookupHelper(m_rootScope.get(), name.relativeName(), name.localName());
         }
+        return lookupHelper(startScope, name, name.localName());
+    }
+
+    const ConfigItem* ConfigurationImpl::lookupHelper(const ConfigScope* startScope, const util::ScopedName& name,
+                                                      std::string_view localName) const
+    {
         const ConfigItem* item = nullptr;
-        while (scope != nullptr)
+
+        for (const ConfigScope* scope = startScope; scope != nullptr && item == nullptr; scope = scope->parentScope())
         {
-            item = lookupHelper(scope, vec);
-            if (item != nullptr)
-            {
-                break;
-            }
-            scope = scope->parentScope();
+            item = lookupInScope(scope, name);
         }
         if (item == nullptr && m_fallbackCfg != nullptr)
         {
-            item = m_fallbackCfg->lookup(localName, localName, true);
+            item = m_fallbackCfg->lookup({"", localName});
         }
         return item;
     }
 
-    const ConfigItem* ConfigurationImpl::lookupHelper(const ConfigScope* scope, const StringVector& vec) const
+    const ConfigItem* ConfigurationImpl::lookupInScope(const ConfigScope* scope, const util::ScopedName& name) const
     {
-        std::size_t i;
-        const std::size_t len = vec.size();
+        util::ScopedName::Tokenizer tokenizer{name};
+        std::string_view component;
+        const ConfigItem* item = nullptr;
 
-        for (i = 0; i < len - 1; ++i)
+        while (tokenizer.next(component) == true)
         {
-            const ConfigItem* item = scope->findItem(vec[i].c_str());
-            if (item == nullptr || item->type() != ConfType::Scope)
+            if (item != nullptr)
+            {
+                if (item->type() != ConfType::Scope)
+                {
+                    return nullptr;
+                }
+                scope = item->scopeVal();
+                compat::checkAssertion(scope != nullptr);
+            }
+
+            item = scope->findItem(component);
+
+            if (item == nullptr)
             {
                 return nullptr;
             }
-            scope = item->scopeVal();
-            compat::checkAssertion(scope != nullptr);
         }
-        compat::checkAssertion(i == len - 1);
-        compat::checkAssertion(scope != nullptr);
-        return scope->findItem(vec[i].c_str());
+        return item;
+    }
+
+    const ConfigItem* ConfigurationImpl::lookupInFallback(std::string_view localName) const
+    {
+        if (m_fallbackCfg == nullptr)
+        {
+            return nullptr;
+        }
+
+        const FrozenIndex* merged = mergedIndex();
+
+        if (merged != nullptr && hasEmptyComponent(localName) == false)
+        {
+            return merged->findInFallback({"", localName});
+        }
+        return m_fallbackCfg->lookup({"", localName});
     }
 
     //----------------------------------------------------------------------
@@ -557,7 +879,7 @@ namespace danek
         }
         else
         {
-            const ConfigItem* item = lookup(fullyScopedName.str().c_str(), localName, true);
+            const ConfigItem* item = lookup({scope, localName});
             if (item == nullptr)
             {
                 std::stringstream msg;
@@ -591,26 +913,7 @@ namespace danek
                                                  const StringVector& filterPatterns, StringVector& names) const
 
     {
-        StringBuffer fullyScopedName;
-        ConfigScope* scopeObj;
-
-        mergeNames(scope, localName, fullyScopedName);
-        if (strcmp(fullyScopedName.str().c_str(), "") == 0)
-        {
-            scopeObj = m_rootScope.get();
-        }
-        else
-        {
-            const ConfigItem* item = lookup(fullyScopedName.str().c_str(), localName, true);
-            if (item == nullptr || item->type() != ConfType::Scope)
-            {
-                std::stringstream msg;
-                msg << fileName() << ": "
-                    << "'" << fullyScopedName.str() << "' is not a scope";
-                throw ConfigurationException(msg.str());
-            }
-            scopeObj = item->scopeVal();
-        }
+        const ConfigScope* scopeObj = listedScope({scope, localName});
         auto v = scopeObj->listFullyScopedNames(typeMask, recursive, filterPatterns.get());
         std::sort(v.begin(), v.end());
         names = StringVector{v};
@@ -637,285 +940,158 @@ namespace danek
                                                    const StringVector& filterPatterns, StringVector& names) const
 
     {
-        StringBuffer fullyScopedName;
-        ConfigScope* scopeObj;
+        const ConfigScope* scopeObj = listedScope({scope, localName});
+        auto v = scopeObj->listLocallyScopedNames(typeMask, recursive, filterPatterns.get());
+        std::sort(v.begin(), v.end());
+        names = StringVector{v};
+    }
 
-        mergeNames(scope, localName, fullyScopedName);
-        if (strcmp(fullyScopedName.str().c_str(), "") == 0)
-        {
-            scopeObj = m_rootScope.get();
-        }
-        else
-        {
-            const ConfigItem* item = lookup(fullyScopedName.str().c_str(), localName, true);
-            if (item == nullptr || item->type() != ConfType::Scope)
-            {
-                std::stringstream msg;
-                msg << fileName() << ": "
-                    << "'" << fullyScopedName.str() << "' is not a scope";
-                throw ConfigurationException(msg.str());
+    //----------------------------------------------------------------------
+    // Function:	forEachItem()
+    //
+    // Description:	Call back for the items of the scope, with their
+    //		names relative to it.
+    //----------------------------------------------------------------------
+
+    void ConfigurationImpl::forEachItem(std::string_view scope, ConfType typeMask, bool recursive,
+                                        FunctionRef<void(const ItemRef&)> callback) const
+    {
+        const ConfigScope* scopeObj = listedScope({scope, ""});
+        std::string name;
+        std::string unexpandedName;
+
+        const auto passItem = [&callback](std::string_view localName, std::string_view unexpandedLocalName,
+                                          const ConfigItem& item) {
+            ItemRef ref{localName, unexpandedLocalName, item.type(), {}, {}};
+
+            if (ref.type == ConfType::String)
+            {
+                ref.stringValue = item.stringVal();
             }
-            scopeObj = item->scopeVal();
-        }
-        auto v = scopeObj->listLocallyScopedNames(typeMask, recursive, filterPatterns.get());
-        std::sort(v.begin(), v.end());
-        names = StringVector{v};
+            else if (ref.type == ConfType::List)
+            {
+                ref.listValue = ListView{item.listVal()};
+            }
+            callback(ref);
+        };
+        scopeObj->forEachItem(typeMask, recursive, name, unexpandedName, passItem);
     }
 
-    const char* ConfigurationImpl::lookupString(const char* scope, const char* localName, const char* defaultVal) const
+    //----------------------------------------------------------------------
+    // Function:	listedScope()
+    //
+    // Description:	Return the scope whose items are listed, which is
+    //		the root scope for an empty name.
+    //----------------------------------------------------------------------
+
+    const ConfigScope* ConfigurationImpl::listedScope(const util::ScopedName& name) const
     {
-        ConfType type;
-        std::stringstream msg;
-        const char* str;
-        StringBuffer fullyScopedName;
+        if (name.empty() == true)
+        {
+            return m_rootScope.get();
+        }
 
-        mergeNames(scope, localName, fullyScopedName);
-        stringValue(fullyScopedName.str().c_str(), localName, str, type);
-        switch (type)
+        const ConfigItem* item = lookup(name);
+
+        if (item == nullptr || item->type() != ConfType::Scope)
         {
-            case ConfType::String:
-                break;
-            case ConfType::NoValue:
-                str = defaultVal;
-                break;
-            case ConfType::Scope:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a scope instead of a string";
-                throw ConfigurationException(msg.str());
-            case ConfType::List:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a list instead of a string";
-                throw ConfigurationException(msg.str());
-            default:
-                throw std::exception{}; // Bug
+            std::stringstream msg;
+            msg << fileName() << ": "
+                << "'" << name.str() << "' is not a scope";
+            throw ConfigurationException(msg.str());
         }
-        return str;
+        return item->scopeVal();
     }
 
-    const char* ConfigurationImpl::lookupString(const char* scope, const char* localName) const
+    const char* ConfigurationImpl::lookupString(const char* scope, const char* localName, const char* defaultVal) const
     {
-        ConfType type;
-        std::stringstream msg;
-        const char* str;
-        StringBuffer fullyScopedName;
+        const ConfigItem* item = lookup({scope, localName});
 
-        mergeNames(scope, localName, fullyScopedName);
-        stringValue(fullyScopedName.str().c_str(), localName, str, type);
-        switch (type)
+        if (item == nullptr)
         {
-            case ConfType::String:
-                break;
-            case ConfType::NoValue:
-                msg << fileName() << ": no value specified for '" << fullyScopedName.str() << "'";
-                throw ConfigurationException(msg.str());
-            case ConfType::Scope:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a scope instead of a string";
-                throw ConfigurationException(msg.str());
-            case ConfType::List:
-                msg << fileName() << ": "
-                    << "'" << fullyScopedName.str() << "' is a list instead of a string";
-                throw ConfigurationException(msg.str());
-            default:
-                throw std::exception{}; // Bug
+            return defaultVal;
         }
-        return str;
+        return checkedStringValue(item, {scope, localName}).c_str();
+    }
+
+    const char* ConfigurationImpl::lookupString(const char* scope, const char* localName) const
+    {
+        return checkedStringValue(lookup({scope, localName}), {scope, localName}).c_str();
     }
 
     void ConfigurationImpl::lookupList(const char* scope, const char* localName, std::vector<std::string>& data,
                                        const char** defaultArray, int defaultArraySize) const
     {
-        ConfType type;
-        std::stringstream msg;
-        StringBuffer fullyScopedName;
+        const ConfigItem* item = lookup({scope, localName});
 
-        mergeNames(scope, localName, fullyScopedName);
-        listValue(fullyScopedName.str().c_str(), localName, data, type);
-        switch (type)
+        if (item == nullptr)
         {
-            case ConfType::List:
-                break;
-            case ConfType::NoValue:
-                std::vector<std::string>(defaultArraySize).swap(data);
-                for (std::size_t i = 0; i < static_cast<std::size_t>(defaultArraySize); i++)
-                {
-                    data[i] = defaultArray[i];
-                }
-                break;
-            case ConfType::Scope:
-                msg << fileName() << ": "
-                    << "'" << fullyScopedName.str() << "' is a scope instead of a list";
-                throw ConfigurationException(msg.str());
-            case ConfType::String:
-                msg << fileName() << ": "
-                    << "'" << fullyScopedName.str() << "' is a string instead of a list";
-                throw ConfigurationException(msg.str());
-            default:
-                throw std::exception{}; // Bug
+            data.assign(defaultArray, defaultArray + defaultArraySize);
+            return;
         }
+        checkedListValue(item, {scope, localName}, data);
     }
 
     void ConfigurationImpl::lookupList(const char* scope, const char* localName, std::vector<std::string>& data) const
     {
-        ConfType type;
-        std::stringstream msg;
-        StringBuffer fullyScopedName;
-
-        mergeNames(scope, localName, fullyScopedName);
-        listValue(fullyScopedName.str().c_str(), localName, data, type);
-        switch (type)
-        {
-            case ConfType::List:
-                break;
-            case ConfType::NoValue:
-                msg << fileName() << ": no value specified for '" << fullyScopedName.str() << "'";
-                throw ConfigurationException(msg.str());
-            case ConfType::Scope:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a scope instead of a list";
-                throw ConfigurationException(msg.str());
-            case ConfType::String:
-                msg << fileName() << ": "
-                    << "'" << fullyScopedName.str() << "' is a string instead of a list";
-                throw ConfigurationException(msg.str());
-            default:
-                throw std::exception{}; // Bug
-        }
+        checkedListValue(lookup({scope, localName}), {scope, localName}, data);
     }
 
     void ConfigurationImpl::lookupList(const char* scope, const char* localName, StringVector& list,
                                        const StringVector& defaultList) const
     {
-        ConfType type;
-        std::stringstream msg;
-        StringBuffer fullyScopedName;
-        std::vector<std::string> data;
+        const ConfigItem* item = lookup({scope, localName});
 
-        mergeNames(scope, localName, fullyScopedName);
-        listValue(fullyScopedName.str().c_str(), localName, data, type);
-        switch (type)
+        if (item == nullptr)
         {
-            case ConfType::List:
-                list = StringVector{data};
-                break;
-            case ConfType::NoValue:
-                list = defaultList;
-                break;
-            case ConfType::Scope:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a scope instead of a list";
-                throw ConfigurationException(msg.str());
-            case ConfType::String:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a string instead of a list";
-                throw ConfigurationException(msg.str());
-            default:
-                throw std::exception{}; // Bug
+            list = defaultList;
+            return;
         }
+
+        std::vector<std::string> data;
+        checkedListValue(item, {scope, localName}, data);
+        list = StringVector{data};
     }
 
     void ConfigurationImpl::lookupList(const char* scope, const char* localName, StringVector& list) const
     {
-        ConfType type;
-        std::stringstream msg;
-        StringBuffer fullyScopedName;
         std::vector<std::string> data;
-
-        mergeNames(scope, localName, fullyScopedName);
-        listValue(fullyScopedName.str().c_str(), localName, data, type);
-        switch (type)
-        {
-            case ConfType::List:
-                list = StringVector{data};
-                break;
-            case ConfType::NoValue:
-                msg << fileName() << ": no value specified for '" << fullyScopedName.str() << "'";
-                throw ConfigurationException(msg.str());
-                break;
-            case ConfType::Scope:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a scope instead of a list";
-                throw ConfigurationException(msg.str());
-            case ConfType::String:
-                msg << fileName() << ": "
-                    << "'" << fullyScopedName.str() << "' is a string instead of a list";
-                throw ConfigurationException(msg.str());
-            default:
-                throw std::exception{}; // Bug
-        }
+        checkedListValue(lookup({scope, localName}), {scope, localName}, data);
+        list = StringVector{data};
     }
 
     int ConfigurationImpl::lookupEnum(const char* scope, const char* localName, const char* typeName,
                                       const EnumNameAndValue* enumInfo, int numEnums, const char* defaultVal) const
     {
-        int result;
-        StringBuffer fullyScopedName;
-        std::stringstream msg;
-
-        const char* strValue = lookupString(scope, localName, defaultVal);
-
-        //--------
-        // Check if the value matches anything in the enumInfo list.
-        //--------
-        if (!enumVal(strValue, enumInfo, numEnums, result))
-        {
-            mergeNames(scope, localName, fullyScopedName);
-            msg << fileName() << ": bad " << typeName << " value ('" << strValue << "') specified for '" << fullyScopedName.str()
-                << "'; should be one of:";
-            for (int i = 0; i < numEnums; i++)
-            {
-                if (i < numEnums - 1)
-                {
-                    msg << " '" << enumInfo[i].name << "',";
-                }
-                else
-                {
-                    msg << " '" << enumInfo[i].name << "'";
-                }
-            }
-            throw ConfigurationException(msg.str());
-        }
-        return result;
+        const ConfigItem* item = lookup({scope, localName});
+        return item != nullptr ? enumValue(item, {scope, localName}, typeName, enumInfo, numEnums)
+                               : enumValue({scope, localName}, typeName, defaultVal, enumInfo, numEnums);
     }
 
     int ConfigurationImpl::lookupEnum(const char* scope, const char* localName, const char* typeName,
                                       const EnumNameAndValue* enumInfo, int numEnums, int defaultVal) const
     {
-        int result;
-        StringBuffer fullyScopedName;
-
-        if (type(scope, localName) == ConfType::NoValue)
-        {
-            return defaultVal;
-        }
-
-        const char* strValue = lookupString(scope, localName);
-
-        //--------
-        // Check if the value matches anything in the enumInfo list.
-        //--------
-        if (!enumVal(strValue, enumInfo, numEnums, result))
-        {
-            std::stringstream msg;
-            mergeNames(scope, localName, fullyScopedName);
-            msg << fileName() << ": bad " << typeName << " value ('" << strValue << "') specified for '" << fullyScopedName.str()
-                << "'; should be one of:";
-            for (int i = 0; i < numEnums; i++)
-            {
-                if (i < numEnums - 1)
-                {
-                    msg << " '" << enumInfo[i].name << "',";
-                }
-                else
-                {
-                    msg << " '" << enumInfo[i].name << "'";
-                }
-            }
-            throw ConfigurationException(msg.str());
-        }
-        return result;
+        const ConfigItem* item = lookup({scope, localName});
+        return item != nullptr ? enumValue(item, {scope, localName}, typeName, enumInfo, numEnums) : defaultVal;
     }
 
     int ConfigurationImpl::lookupEnum(const char* scope, const char* localName, const char* typeName,
                                       const EnumNameAndValue* enumInfo, int numEnums) const
     {
-        int result;
-        StringBuffer fullyScopedName;
+        return enumValue(lookup({scope, localName}), {scope, localName}, typeName, enumInfo, numEnums);
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	enumValue()
+    //
+    // Description:	Return the value of the enumerated spelling or throw
+    //		an exception listing the allowed spellings.
+    //----------------------------------------------------------------------
 
-        const char* strValue = lookupString(scope, localName);
+    int ConfigurationImpl::enumValue(const util::ScopedName& name, const char* typeName, const char* strValue,
+                                     const EnumNameAndValue* enumInfo, int numEnums) const
+    {
+        int result;
 
         //--------
         // Check if the value matches anything in the enumInfo list.
@@ -923,8 +1099,7 @@ namespace danek
         if (!enumVal(strValue, enumInfo, numEnums, result))
         {
             std::stringstream msg;
-            mergeNames(scope, localName, fullyScopedName);
-            msg << fileName() << ": bad " << typeName << " value ('" << strValue << "') specified for '" << fullyScopedName.str()
+            msg << fileName() << ": bad " << typeName << " value ('" << strValue << "') specified for '" << name.str()
                 << "'; should be one of:";
             for (int i = 0; i < numEnums; i++)
             {
@@ -971,73 +1146,176 @@ namespace danek
 
     int countBoolInfo = sizeof(boolInfo) / sizeof(boolInfo[0]);
 
-    bool ConfigurationImpl::lookupBoolean(const char* scope, const char* localName, bool defaultVal) const
+    //----------------------------------------------------------------------
+    // Function:	intValue()
+    //
+    // Description:	Convert the string of the (possibly missing) item,
+    //		or return the result of the previous such conversion.
+    //----------------------------------------------------------------------
+
+    int ConfigurationImpl::intValue(const ConfigItem* item, const util::ScopedName& name,
+                                    ConfigItem::Conversion conversion) const
     {
-        const char* defaultStrVal;
+        using Conversion = ConfigItem::Conversion;
+        int value;
 
-        if (defaultVal)
+        if (item != nullptr && item->cachedValue(conversion, value) == true)
         {
-            defaultStrVal = "true";
+            return value;
         }
-        else
+
+        const char* str = checkedStringValue(item, name).c_str();
+
+        switch (conversion)
         {
-            defaultStrVal = "false";
+            case Conversion::Int:
+                value = stringToInt(name, str);
+                break;
+            case Conversion::DurationMicroseconds:
+                value = stringToDurationMicroseconds(name, str);
+                break;
+            case Conversion::DurationMilliseconds:
+                value = stringToDurationMilliseconds(name, str);
+                break;
+            case Conversion::DurationSeconds:
+                value = stringToDurationSeconds(name, str);
+                break;
+            case Conversion::MemorySizeBytes:
+                value = stringToMemorySizeBytes(name, str);
+                break;
+            case Conversion::MemorySizeKB:
+                value = stringToMemorySizeKB(name, str);
+                break;
+            case Conversion::MemorySizeMB:
+                value = stringToMemorySizeMB(name, str);
+                break;
+            default:
+                throw std::exception{}; // Bug
         }
-        int intVal = lookupEnum(scope, localName, "boolean", boolInfo, countBoolInfo, defaultStrVal);
-        return intVal != 0;
+        item->cacheValue(conversion, value);
+        return value;
     }
 
-    bool ConfigurationImpl::lookupBoolean(const char* scope, const char* localName) const
+    float ConfigurationImpl::floatValue(const ConfigItem* item, const util::ScopedName& name) const
     {
-        int intVal = lookupEnum(scope, localName, "boolean", boolInfo, countBoolInfo);
-        return intVal != 0;
-    }
+        int bits;
 
-    int ConfigurationImpl::lookupInt(const char* scope, const char* localName, int defaultVal) const
-    {
-        const char* strValue;
-        char defaultStrVal[64]; // Big enough
+        if (item != nullptr && item->cachedValue(ConfigItem::Conversion::Float, bits) == true)
+        {
+            return std::bit_cast<float>(bits);
+        }
 
-        sprintf(defaultStrVal, "%d", defaultVal);
-        strValue = lookupString(scope, localName, defaultStrVal);
-        const int result = stringToInt(scope, localName, strValue);
-        return result;
+        const float value = stringToFloat(name, checkedStringValue(item, name).c_str());
+        item->cacheValue(ConfigItem::Conversion::Float, std::bit_cast<int>(value));
+        return value;
     }
 
-    int ConfigurationImpl::lookupInt(const char* scope, const char* localName) const
+    bool ConfigurationImpl::booleanValue(const ConfigItem* item, const util::ScopedName& name) const
     {
-        const char* strValue;
-        strValue = lookupString(scope, localName);
-        const int result = stringToInt(scope, localName, strValue);
-        return result;
-    }
+        int value;
 
-    bool ConfigurationImpl::isInt(const char* str) const
-    {
-        int intValue;
-        char dummy;
+        if (item != nullptr && item->cachedValue(ConfigItem::Conversion::Boolean, value) == true)
+        {
+            return value != 0;
+        }
 
-        const int i = sscanf(str, "%d%c", &intValue, &dummy);
-        return i == 1;
+        value = enumValue(name, "boolean", checkedStringValue(item, name).c_str(), boolInfo, countBoolInfo);
+        item->cacheValue(ConfigItem::Conversion::Boolean, value);
+        return value != 0;
     }
 
-    int ConfigurationImpl::stringToInt(const char* scope, const char* localName, const char* str) const
+    //----------------------------------------------------------------------
+    // Function:	enumValue()
+    //
+    // Description:	Like enumValue() of a string, but the position of
+    //		the spelling in enumInfo is cached. As the table may
+    //		differ between calls, a cached position is only used if
+    //		it still has the spelling of the item.
+    //----------------------------------------------------------------------
+
+    int ConfigurationImpl::enumValue(const ConfigItem* item, const util::ScopedName& name, const char* typeName,
+                                     const EnumNameAndValue* enumInfo, int numEnums) const
     {
-        int result;
-        char dummy;
-        StringBuffer fullyScopedName;
+        const char* str = checkedStringValue(item, name).c_str();
+        int index;
 
-        // Convert the string value into an int value.
-        const int i = sscanf(str, "%d%c", &result, &dummy);
+        if (item->cachedValue(ConfigItem::Conversion::Enum, index) == true && index < numEnums &&
+            strcmp(str, enumInfo[index].name) == 0)
+        {
+            return enumInfo[index].value;
+        }
 
-        if (i != 1)
+        for (index = 0; index < numEnums; ++index)
+        {
+            if (strcmp(str, enumInfo[index].name) == 0)
+            {
+                item->cacheValue(ConfigItem::Conversion::Enum, index);
+                return enumInfo[index].value;
+            }
+        }
+        return enumValue(name, typeName, str, enumInfo, numEnums);
+    }
+
+    bool ConfigurationImpl::lookupBoolean(const char* scope, const char* localName, bool defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+        return item != nullptr ? booleanValue(item, {scope, localName}) : defaultVal;
+    }
+
+    bool ConfigurationImpl::lookupBoolean(const char* scope, const char* localName) const
+    {
+        return booleanValue(lookup({scope, localName}), {scope, localName});
+    }
+
+    int ConfigurationImpl::lookupInt(const char* scope, const char* localName, int defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+
+        if (item != nullptr)
+        {
+            return intValue(item, {scope, localName}, ConfigItem::Conversion::Int);
+        }
+
+        char defaultStrVal[64]; // Big enough
+
+        sprintf(defaultStrVal, "%d", defaultVal);
+        return stringToInt(scope, localName, defaultStrVal);
+    }
+
+    int ConfigurationImpl::lookupInt(const char* scope, const char* localName) const
+    {
+        return intValue(lookup({scope, localName}), {scope, localName}, ConfigItem::Conversion::Int);
+    }
+
+    bool ConfigurationImpl::isInt(const char* str) const
+    {
+        int intValue;
+        char dummy;
+
+        const int i = sscanf(str, "%d%c", &intValue, &dummy);
+        return i == 1;
+    }
+
+    int ConfigurationImpl::stringToInt(const char* scope, const char* localName, const char* str) const
+    {
+        return stringToInt({scope, localName}, str);
+    }
+
+    int ConfigurationImpl::stringToInt(const util::ScopedName& name, const char* str) const
+    {
+        int result;
+        char dummy;
+
+        // Convert the string value into an int value.
+        const int i = sscanf(str, "%d%c", &result, &dummy);
+
+        if (i != 1)
         {
             //--------
             // The number is badly formatted. Report an error.
             //--------
-            mergeNames(scope, localName, fullyScopedName);
             std::stringstream msg;
-            msg << fileName() << ": non-integer value for '" << fullyScopedName.str() << "'";
+            msg << fileName() << ": non-integer value for '" << name.str() << "'";
             throw ConfigurationException(msg.str());
         }
         return result;
@@ -1053,19 +1331,22 @@ namespace danek
     }
 
     float ConfigurationImpl::stringToFloat(const char* scope, const char* localName, const char* str) const
+    {
+        return stringToFloat({scope, localName}, str);
+    }
+
+    float ConfigurationImpl::stringToFloat(const util::ScopedName& name, const char* str) const
     {
         float result;
         char dummy;
-        StringBuffer fullyScopedName;
 
         // Convert the string value into a float value.
         const int i = sscanf(str, "%f%c", &result, &dummy);
         if (i != 1)
         {
             // The number is badly formatted. Report an error.
-            mergeNames(scope, localName, fullyScopedName);
             std::stringstream msg;
-            msg << fileName() << ": non-numeric value for '" << fullyScopedName.str() << "'";
+            msg << fileName() << ": non-numeric value for '" << name.str() << "'";
             throw ConfigurationException(msg.str());
         }
         return result;
@@ -1149,13 +1430,10 @@ namespace danek
     bool ConfigurationImpl::isFloatWithUnits(const char* str, const char** allowedUnits, int allowedUnitsSize) const
     {
         // See if it is in the form "<float> <units>"
-        std::stringstream ss{str};
         float fVal;
-        std::string unitSpelling;
+        std::string_view unitSpelling;
 
-        ss >> fVal >> unitSpelling;
-
-        if (ss.fail() == true)
+        if (!parseFloatWithUnits(str, fVal, unitSpelling))
         {
             return false;
         }
@@ -1164,7 +1442,7 @@ namespace danek
         // what the specified units are.
         for (int i = 0; i < allowedUnitsSize; ++i)
         {
-            if (strcmp(unitSpelling.c_str(), allowedUnits[i]) == 0)
+            if (unitSpelling == allowedUnits[i])
             {
                 return true;
             }
@@ -1647,19 +1925,21 @@ namespace danek
                                                    const char* str, const char** allowedUnits, int allowedUnitsSize,
                                                    float& floatResult, const char*& unitsResult) const
     {
-        StringBuffer fullyScopedName;
-        std::stringstream msg;
+        stringToFloatWithUnits({scope, localName}, typeName, str, allowedUnits, allowedUnitsSize, floatResult, unitsResult);
+    }
 
+    void ConfigurationImpl::stringToFloatWithUnits(const util::ScopedName& name, const char* typeName, const char* str,
+                                                   const char** allowedUnits, int allowedUnitsSize, float& floatResult,
+                                                   const char*& unitsResult) const
+    {
         // See if the string is in the form "<float> <units>"
-        std::stringstream ss{str};
         float fVal;
-        std::string unitSpelling;
-        ss >> fVal >> unitSpelling;
+        std::string_view unitSpelling;
 
-        if (ss.fail() == true)
+        if (!parseFloatWithUnits(str, fVal, unitSpelling))
         {
-            mergeNames(scope, localName, fullyScopedName);
-            msg << fileName() << ": invalid " << typeName << " ('" << str << "') specified for '" << fullyScopedName.str()
+            std::stringstream msg;
+            msg << fileName() << ": invalid " << typeName << " ('" << str << "') specified for '" << name.str()
                 << "': should be"
                 << " '<float> <units>' where <units> are";
             for (int i = 0; i < allowedUnitsSize; ++i)
@@ -1677,7 +1957,7 @@ namespace danek
         // what the specified units are.
         for (int i = 0; i < allowedUnitsSize; ++i)
         {
-            if (strcmp(unitSpelling.c_str(), allowedUnits[i]) == 0)
+            if (unitSpelling == allowedUnits[i])
             {
                 // Success!
                 floatResult = fVal;
@@ -1687,8 +1967,8 @@ namespace danek
         }
 
         // Error: an unknown unit was specified.
-        mergeNames(scope, localName, fullyScopedName);
-        msg << fileName() << ": invalid " << typeName << " ('" << str << "') specified for '" << fullyScopedName.str()
+        std::stringstream msg;
+        msg << fileName() << ": invalid " << typeName << " ('" << str << "') specified for '" << name.str()
             << "': should be"
             << " '<float> <units>' where <units> are";
         for (int i = 0; i < allowedUnitsSize; ++i)
@@ -1703,6 +1983,11 @@ namespace danek
     }
 
     int ConfigurationImpl::stringToDurationMicroseconds(const char* scope, const char* localName, const char* str) const
+    {
+        return stringToDurationMicroseconds({scope, localName}, str);
+    }
+
+    int ConfigurationImpl::stringToDurationMicroseconds(const util::ScopedName& name, const char* str) const
     {
         float floatVal;
         const char* units;
@@ -1718,7 +2003,7 @@ namespace danek
         // Use stringToFloatWithUnits()
         try
         {
-            stringToFloatWithUnits(scope, localName, "durationMicroseconds", str, allowedDurationMicrosecondsUnits,
+            stringToFloatWithUnits(name, "durationMicroseconds", str, allowedDurationMicrosecondsUnits,
                                    countAllowedDurationMicrosecondsUnits, floatVal, units);
         }
         catch (const ConfigurationException& ex)
@@ -1743,6 +2028,11 @@ namespace danek
     }
 
     int ConfigurationImpl::stringToDurationMilliseconds(const char* scope, const char* localName, const char* str) const
+    {
+        return stringToDurationMilliseconds({scope, localName}, str);
+    }
+
+    int ConfigurationImpl::stringToDurationMilliseconds(const util::ScopedName& name, const char* str) const
     {
         float floatVal;
         const char* units;
@@ -1758,7 +2048,7 @@ namespace danek
         // Use stringToFloatWithUnits()
         try
         {
-            stringToFloatWithUnits(scope, localName, "durationMilliseconds", str, allowedDurationMillisecondsUnits,
+            stringToFloatWithUnits(name, "durationMilliseconds", str, allowedDurationMillisecondsUnits,
                                    countAllowedDurationMillisecondsUnits, floatVal, units);
         }
         catch (const ConfigurationException& ex)
@@ -1782,251 +2072,1146 @@ namespace danek
         return result;
     }
 
-    int ConfigurationImpl::stringToDurationSeconds(const char* scope, const char* localName, const char* str) const
+    int ConfigurationImpl::stringToDurationSeconds(const char* scope, const char* localName, const char* str) const
+    {
+        return stringToDurationSeconds({scope, localName}, str);
+    }
+
+    int ConfigurationImpl::stringToDurationSeconds(const util::ScopedName& name, const char* str) const
+    {
+        float floatVal;
+        const char* units;
+        int i;
+        int unitsVal;
+
+        // Is the duration "infinite"?
+        if (!strcmp(str, "infinite"))
+        {
+            return -1;
+        }
+
+        // Use stringToFloatWithUnits()
+        try
+        {
+            stringToFloatWithUnits(name, "durationSeconds", str, allowedDurationSecondsUnits,
+                                   countAllowedDurationSecondsUnits, floatVal, units);
+        }
+        catch (const ConfigurationException& ex)
+        {
+            std::stringstream msg;
+            msg << ex.message() << "; alternatively, you can use 'infinite'";
+            throw ConfigurationException(msg.str());
+        }
+        compat::checkAssertion(countDurationSecondsInfo == countAllowedDurationSecondsUnits);
+        int result = -1; // avoid compiler warning about an unitialized variable
+        for (i = 0; i < countDurationSecondsInfo; ++i)
+        {
+            if (strcmp(durationSecondsUnitsInfo[i].spelling, units) == 0)
+            {
+                unitsVal = durationSecondsUnitsInfo[i].val;
+                result = static_cast<int>(floatVal * unitsVal);
+                break;
+            }
+        }
+        compat::checkAssertion(i < countDurationSecondsInfo);
+        return result;
+    }
+
+    int ConfigurationImpl::lookupDurationMicroseconds(const char* scope, const char* localName, int defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+
+        if (item != nullptr)
+        {
+            return intValue(item, {scope, localName}, ConfigItem::Conversion::DurationMicroseconds);
+        }
+
+        char defaultStrValue[128]; // big enough
+
+        if (defaultVal == -1)
+        {
+            sprintf(defaultStrValue, "infinite");
+        }
+        else
+        {
+            sprintf(defaultStrValue, "%d microseconds", defaultVal);
+        }
+        return stringToDurationMicroseconds(scope, localName, defaultStrValue);
+    }
+
+    int ConfigurationImpl::lookupDurationMicroseconds(const char* scope, const char* localName) const
+    {
+        return intValue(lookup({scope, localName}), {scope, localName}, ConfigItem::Conversion::DurationMicroseconds);
+    }
+
+    int ConfigurationImpl::lookupDurationMilliseconds(const char* scope, const char* localName, int defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+
+        if (item != nullptr)
+        {
+            return intValue(item, {scope, localName}, ConfigItem::Conversion::DurationMilliseconds);
+        }
+
+        char defaultStrValue[128]; // big enough
+
+        if (defaultVal == -1)
+        {
+            sprintf(defaultStrValue, "infinite");
+        }
+        else
+        {
+            sprintf(defaultStrValue, "%d milliseconds", defaultVal);
+        }
+        return stringToDurationMilliseconds(scope, localName, defaultStrValue);
+    }
+
+    int ConfigurationImpl::lookupDurationMilliseconds(const char* scope, const char* localName) const
+    {
+        return intValue(lookup({scope, localName}), {scope, localName}, ConfigItem::Conversion::DurationMilliseconds);
+    }
+
+    int ConfigurationImpl::lookupDurationSeconds(const char* scope, const char* localName, int defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+
+        if (item != nullptr)
+        {
+            return intValue(item, {scope, localName}, ConfigItem::Conversion::DurationSeconds);
+        }
+
+        char defaultStrValue[128]; // big enough
+
+        if (defaultVal == -1)
+        {
+            sprintf(defaultStrValue, "infinite");
+        }
+        else
+        {
+            sprintf(defaultStrValue, "%d seconds", defaultVal);
+        }
+        return stringToDurationSeconds(scope, localName, defaultStrValue);
+    }
+
+    int ConfigurationImpl::lookupDurationSeconds(const char* scope, const char* localName) const
+    {
+        return intValue(lookup({scope, localName}), {scope, localName}, ConfigItem::Conversion::DurationSeconds);
+    }
+
+    int ConfigurationImpl::stringToMemorySizeGeneric(const char* typeName, SpellingAndValue unitsInfo[], int unitsInfoSize,
+                                                     const char* allowedUnits[], const util::ScopedName& name,
+                                                     const char* str) const
+    {
+        float floatVal;
+        const char* units;
+        int result;
+        int unitsVal;
+
+        stringToFloatWithUnits(name, typeName, str, allowedUnits, unitsInfoSize, floatVal, units);
+        result = -1; // avoid compiler warning about an unitialized variable
+        int i = 0;
+        for (i = 0; i < unitsInfoSize; ++i)
+        {
+            if (strcmp(unitsInfo[i].spelling, units) == 0)
+            {
+                unitsVal = unitsInfo[i].val;
+                result = static_cast<int>(floatVal * unitsVal);
+                break;
+            }
+        }
+        compat::checkAssertion(i < unitsInfoSize);
+        return result;
+    }
+
+    int ConfigurationImpl::stringToMemorySizeBytes(const char* scope, const char* localName, const char* str) const
+    {
+        return stringToMemorySizeBytes({scope, localName}, str);
+    }
+
+    int ConfigurationImpl::stringToMemorySizeBytes(const util::ScopedName& name, const char* str) const
+    {
+        static const char* allowedUnits[] = {"byte", "bytes", "KB", "MB", "GB"};
+        return stringToMemorySizeGeneric("memorySizeBytes", MemorySizeBytesUnitsInfo, 5, allowedUnits, name, str);
+    }
+
+    int ConfigurationImpl::stringToMemorySizeKB(const char* scope, const char* localName, const char* str) const
+    {
+        return stringToMemorySizeKB({scope, localName}, str);
+    }
+
+    int ConfigurationImpl::stringToMemorySizeKB(const util::ScopedName& name, const char* str) const
+    {
+        static const char* allowedUnits[] = {"KB", "MB", "GB", "TB"};
+        return stringToMemorySizeGeneric("memorySizeKB", MemorySizeKBUnitsInfo, 4, allowedUnits, name, str);
+    }
+
+    int ConfigurationImpl::stringToMemorySizeMB(const char* scope, const char* localName, const char* str) const
+    {
+        return stringToMemorySizeMB({scope, localName}, str);
+    }
+
+    int ConfigurationImpl::stringToMemorySizeMB(const util::ScopedName& name, const char* str) const
+    {
+        static const char* allowedUnits[] = {"MB", "GB", "TB", "PB"};
+        return stringToMemorySizeGeneric("memorySizeMB", MemorySizeMBUnitsInfo, 4, allowedUnits, name, str);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeBytes(const char* scope, const char* localName, int defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+
+        if (item != nullptr)
+        {
+            return intValue(item, {scope, localName}, ConfigItem::Conversion::MemorySizeBytes);
+        }
+
+        char defaultStrValue[64]; // big enough
+
+        sprintf(defaultStrValue, "%d milliseconds", defaultVal);
+        return stringToMemorySizeBytes(scope, localName, defaultStrValue);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeBytes(const char* scope, const char* localName) const
+    {
+        return intValue(lookup({scope, localName}), {scope, localName}, ConfigItem::Conversion::MemorySizeBytes);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeKB(const char* scope, const char* localName, int defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+
+        if (item != nullptr)
+        {
+            return intValue(item, {scope, localName}, ConfigItem::Conversion::MemorySizeKB);
+        }
+
+        char defaultStrValue[64]; // big enough
+
+        sprintf(defaultStrValue, "%d KB", defaultVal);
+        return stringToMemorySizeKB(scope, localName, defaultStrValue);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeKB(const char* scope, const char* localName) const
+    {
+        return intValue(lookup({scope, localName}), {scope, localName}, ConfigItem::Conversion::MemorySizeKB);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeMB(const char* scope, const char* localName, int defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+
+        if (item != nullptr)
+        {
+            return intValue(item, {scope, localName}, ConfigItem::Conversion::MemorySizeMB);
+        }
+
+        char defaultStrValue[64]; // big enough
+
+        sprintf(defaultStrValue, "%d MB", defaultVal);
+        return stringToMemorySizeMB(scope, localName, defaultStrValue);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeMB(const char* scope, const char* localName) const
+    {
+        return intValue(lookup({scope, localName}), {scope, localName}, ConfigItem::Conversion::MemorySizeMB);
+    }
+
+    float ConfigurationImpl::lookupFloat(const char* scope, const char* localName, float defaultVal) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+
+        if (item != nullptr)
+        {
+            return floatValue(item, {scope, localName});
+        }
+
+        char defaultStrVal[64]; // Big enough
+
+        sprintf(defaultStrVal, "%g", defaultVal);
+        return stringToFloat(scope, localName, defaultStrVal);
+    }
+
+    float ConfigurationImpl::lookupFloat(const char* scope, const char* localName) const
+    {
+        return floatValue(lookup({scope, localName}), {scope, localName});
+    }
+
+    void ConfigurationImpl::lookupScope(const char* scope, const char* localName) const
+    {
+        const ConfType entryType = type(scope, localName);
+
+        if (entryType == ConfType::Scope)
+        {
+            return;
+        }
+
+        std::stringstream msg;
+        StringBuffer fullyScopedName;
+
+        mergeNames(scope, localName, fullyScopedName);
+        switch (entryType)
+        {
+            case ConfType::String:
+                msg << fileName() << ": '" << fullyScopedName.str() << "' is a string instead of a scope";
+                throw ConfigurationException(msg.str());
+            case ConfType::List:
+                msg << fileName() << ": '" << fullyScopedName.str() << "' is a list instead of a scope";
+                throw ConfigurationException(msg.str());
+            case ConfType::NoValue:
+                msg << fileName() << ": scope '" << fullyScopedName.str() << "' does not exist";
+                throw ConfigurationException(msg.str());
+            default:
+                throw std::exception{}; // Bug
+        }
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	resolveKey()
+    //
+    // Description:	Resolve the named entry once, so that lookups
+    //		through the returned key skip the name resolution.
+    //----------------------------------------------------------------------
+
+    ConfigKey ConfigurationImpl::resolveKey(const char* scope, const char* localName) const
+    {
+        static_assert(ConfigKey::noSymbol == SymbolTable::noSymbol);
+
+        const ConfigItem* item = lookup({scope, localName});
+        // Entries found in the fallback configuration were interned by its symbol table
+        const SymbolId symbol = (item != nullptr ? m_rootScope->symbols().find(item->name()) : SymbolTable::noSymbol);
+        return ConfigKey{this, generation(), item, symbol, scope, localName};
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	lookup()
+    //
+    // Description:	Return the entry the key was resolved to, unless the
+    //		configuration has been modified since. Stale or foreign
+    //		keys are resolved by name again.
+    //----------------------------------------------------------------------
+
+    const ConfigItem* ConfigurationImpl::lookup(const ConfigKey& key) const
+    {
+        if (key.m_owner == this && key.m_generation == generation())
+        {
+            return key.m_item;
+        }
+
+        return lookup({key.scope(), key.localName()});
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	checkedStringValue()
+    //
+    // Description:	Return the string of the (possibly missing) item or
+    //		throw an exception describing why there is none.
+    //----------------------------------------------------------------------
+
+    const std::pmr::string& ConfigurationImpl::checkedStringValue(const ConfigItem* item, const util::ScopedName& name) const
+    {
+        const ConfType type = (item != nullptr ? item->type() : ConfType::NoValue);
+
+        if (type == ConfType::String)
+        {
+            return item->stringVal();
+        }
+
+        std::stringstream msg;
+        const std::string fullyScopedName = name.str();
+
+        switch (type)
+        {
+            case ConfType::NoValue:
+                msg << fileName() << ": no value specified for '" << fullyScopedName << "'";
+                break;
+            case ConfType::Scope:
+                msg << fileName() << ": '" << fullyScopedName << "' is a scope instead of a string";
+                break;
+            case ConfType::List:
+                msg << fileName() << ": '" << fullyScopedName << "' is a list instead of a string";
+                break;
+            default:
+                throw std::exception{}; // Bug
+        }
+        throw ConfigurationException(msg.str());
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	checkedListValue()
+    //
+    // Description:	Copy the list of the (possibly missing) item or
+    //		throw an exception describing why there is none.
+    //----------------------------------------------------------------------
+
+    void ConfigurationImpl::checkedListValue(const ConfigItem* item, const util::ScopedName& name,
+                                             std::vector<std::string>& data) const
+    {
+        const ListView list = checkedListView(item, name);
+        data.assign(list.begin(), list.end());
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	checkedListView()
+    //
+    // Description:	Return a view of the list of the (possibly missing)
+    //		item or throw an exception describing why there is none.
+    //----------------------------------------------------------------------
+
+    ListView ConfigurationImpl::checkedListView(const ConfigItem* item, const util::ScopedName& name) const
+    {
+        const ConfType type = (item != nullptr ? item->type() : ConfType::NoValue);
+
+        if (type == ConfType::List)
+        {
+            return ListView{item->listVal()};
+        }
+
+        std::stringstream msg;
+        const std::string fullyScopedName = name.str();
+
+        switch (type)
+        {
+            case ConfType::NoValue:
+                msg << fileName() << ": no value specified for '" << fullyScopedName << "'";
+                break;
+            case ConfType::Scope:
+                msg << fileName() << ": '" << fullyScopedName << "' is a scope instead of a list";
+                break;
+            case ConfType::String:
+                msg << fileName() << ": '" << fullyScopedName << "' is a string instead of a list";
+                break;
+            default:
+                throw std::exception{}; // Bug
+        }
+        throw ConfigurationException(msg.str());
+    }
+
+    ConfType ConfigurationImpl::type(const ConfigKey& key) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? item->type() : ConfType::NoValue;
+    }
+
+    const char* ConfigurationImpl::lookupString(const ConfigKey& key, const char* defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+
+        if (item == nullptr)
+        {
+            return defaultVal;
+        }
+        return checkedStringValue(item, {key.scope(), key.localName()}).c_str();
+    }
+
+    const char* ConfigurationImpl::lookupString(const ConfigKey& key) const
+    {
+        return checkedStringValue(lookup(key), {key.scope(), key.localName()}).c_str();
+    }
+
+    void ConfigurationImpl::lookupList(const ConfigKey& key, std::vector<std::string>& data, const char** defaultArray,
+                                       int defaultArraySize) const
+    {
+        const ConfigItem* item = lookup(key);
+
+        if (item == nullptr)
+        {
+            data.assign(defaultArray, defaultArray + defaultArraySize);
+            return;
+        }
+        checkedListValue(item, {key.scope(), key.localName()}, data);
+    }
+
+    void ConfigurationImpl::lookupList(const ConfigKey& key, std::vector<std::string>& data) const
+    {
+        checkedListValue(lookup(key), {key.scope(), key.localName()}, data);
+    }
+
+    ListView ConfigurationImpl::lookupListView(const ConfigKey& key, ListView defaultList) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? checkedListView(item, {key.scope(), key.localName()}) : defaultList;
+    }
+
+    ListView ConfigurationImpl::lookupListView(const ConfigKey& key) const
+    {
+        return checkedListView(lookup(key), {key.scope(), key.localName()});
+    }
+
+    int ConfigurationImpl::lookupInt(const ConfigKey& key, int defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? intValue(item, {key.scope(), key.localName()}, ConfigItem::Conversion::Int) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupInt(const ConfigKey& key) const
+    {
+        return intValue(lookup(key), {key.scope(), key.localName()}, ConfigItem::Conversion::Int);
+    }
+
+    float ConfigurationImpl::lookupFloat(const ConfigKey& key, float defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? floatValue(item, {key.scope(), key.localName()}) : defaultVal;
+    }
+
+    float ConfigurationImpl::lookupFloat(const ConfigKey& key) const
+    {
+        return floatValue(lookup(key), {key.scope(), key.localName()});
+    }
+
+    int ConfigurationImpl::lookupEnum(const ConfigKey& key, const char* typeName, const EnumNameAndValue* enumInfo,
+                                      int numEnums, int defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? enumValue(item, {key.scope(), key.localName()}, typeName, enumInfo, numEnums) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupEnum(const ConfigKey& key, const char* typeName, const EnumNameAndValue* enumInfo,
+                                      int numEnums) const
+    {
+        return enumValue(lookup(key), {key.scope(), key.localName()}, typeName, enumInfo, numEnums);
+    }
+
+    bool ConfigurationImpl::lookupBoolean(const ConfigKey& key, bool defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? booleanValue(item, {key.scope(), key.localName()}) : defaultVal;
+    }
+
+    bool ConfigurationImpl::lookupBoolean(const ConfigKey& key) const
+    {
+        return booleanValue(lookup(key), {key.scope(), key.localName()});
+    }
+
+    int ConfigurationImpl::lookupDurationMicroseconds(const ConfigKey& key, int defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? intValue(item, {key.scope(), key.localName()}, ConfigItem::Conversion::DurationMicroseconds) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupDurationMicroseconds(const ConfigKey& key) const
+    {
+        return intValue(lookup(key), {key.scope(), key.localName()}, ConfigItem::Conversion::DurationMicroseconds);
+    }
+
+    int ConfigurationImpl::lookupDurationMilliseconds(const ConfigKey& key, int defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? intValue(item, {key.scope(), key.localName()}, ConfigItem::Conversion::DurationMilliseconds) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupDurationMilliseconds(const ConfigKey& key) const
+    {
+        return intValue(lookup(key), {key.scope(), key.localName()}, ConfigItem::Conversion::DurationMilliseconds);
+    }
+
+    int ConfigurationImpl::lookupDurationSeconds(const ConfigKey& key, int defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? intValue(item, {key.scope(), key.localName()}, ConfigItem::Conversion::DurationSeconds) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupDurationSeconds(const ConfigKey& key) const
+    {
+        return intValue(lookup(key), {key.scope(), key.localName()}, ConfigItem::Conversion::DurationSeconds);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeBytes(const ConfigKey& key, int defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? intValue(item, {key.scope(), key.localName()}, ConfigItem::Conversion::MemorySizeBytes) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupMemorySizeBytes(const ConfigKey& key) const
+    {
+        return intValue(lookup(key), {key.scope(), key.localName()}, ConfigItem::Conversion::MemorySizeBytes);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeKB(const ConfigKey& key, int defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? intValue(item, {key.scope(), key.localName()}, ConfigItem::Conversion::MemorySizeKB) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupMemorySizeKB(const ConfigKey& key) const
+    {
+        return intValue(lookup(key), {key.scope(), key.localName()}, ConfigItem::Conversion::MemorySizeKB);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeMB(const ConfigKey& key, int defaultVal) const
+    {
+        const ConfigItem* item = lookup(key);
+        return item != nullptr ? intValue(item, {key.scope(), key.localName()}, ConfigItem::Conversion::MemorySizeMB) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupMemorySizeMB(const ConfigKey& key) const
+    {
+        return intValue(lookup(key), {key.scope(), key.localName()}, ConfigItem::Conversion::MemorySizeMB);
+    }
+
+    //----------------------------------------------------------------------
+    // Lookups by std::string_view names. The names need not be
+    // nul-terminated, so they are never passed on as C strings.
+    //----------------------------------------------------------------------
+
+    ConfType ConfigurationImpl::type(std::string_view scope, std::string_view localName) const
+    {
+        const ConfigItem* item = lookup({scope, localName});
+        return item != nullptr ? item->type() : ConfType::NoValue;
+    }
+
+    std::string_view ConfigurationImpl::lookupString(std::string_view scope, std::string_view localName,
+                                                     std::string_view defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+
+        if (item == nullptr)
+        {
+            return defaultVal;
+        }
+        return checkedStringValue(item, name);
+    }
+
+    std::string_view ConfigurationImpl::lookupString(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return checkedStringValue(lookup(name), name);
+    }
+
+    void ConfigurationImpl::lookupList(std::string_view scope, std::string_view localName, std::vector<std::string>& data,
+                                       const char** defaultArray, int defaultArraySize) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+
+        if (item == nullptr)
+        {
+            data.assign(defaultArray, defaultArray + defaultArraySize);
+            return;
+        }
+        checkedListValue(item, name, data);
+    }
+
+    void ConfigurationImpl::lookupList(std::string_view scope, std::string_view localName, std::vector<std::string>& data) const
+    {
+        const util::ScopedName name{scope, localName};
+        checkedListValue(lookup(name), name, data);
+    }
+
+    void ConfigurationImpl::lookupList(std::string_view scope, std::string_view localName, StringVector& list,
+                                       const StringVector& defaultList) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+
+        if (item == nullptr)
+        {
+            list = defaultList;
+            return;
+        }
+
+        std::vector<std::string> data;
+        checkedListValue(item, name, data);
+        list = StringVector{data};
+    }
+
+    void ConfigurationImpl::lookupList(std::string_view scope, std::string_view localName, StringVector& list) const
+    {
+        const util::ScopedName name{scope, localName};
+        std::vector<std::string> data;
+        checkedListValue(lookup(name), name, data);
+        list = StringVector{data};
+    }
+
+    ListView ConfigurationImpl::lookupListView(std::string_view scope, std::string_view localName,
+                                               ListView defaultList) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? checkedListView(item, name) : defaultList;
+    }
+
+    ListView ConfigurationImpl::lookupListView(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return checkedListView(lookup(name), name);
+    }
+
+    int ConfigurationImpl::lookupInt(std::string_view scope, std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? intValue(item, name, ConfigItem::Conversion::Int) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupInt(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return intValue(lookup(name), name, ConfigItem::Conversion::Int);
+    }
+
+    float ConfigurationImpl::lookupFloat(std::string_view scope, std::string_view localName, float defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? floatValue(item, name) : defaultVal;
+    }
+
+    float ConfigurationImpl::lookupFloat(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return floatValue(lookup(name), name);
+    }
+
+    int ConfigurationImpl::lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                                      const EnumNameAndValue* enumInfo, int numEnums, const char* defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? enumValue(item, name, typeName, enumInfo, numEnums)
+                               : enumValue(name, typeName, defaultVal, enumInfo, numEnums);
+    }
+
+    int ConfigurationImpl::lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                                      const EnumNameAndValue* enumInfo, int numEnums, int defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? enumValue(item, name, typeName, enumInfo, numEnums)
+                               : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupEnum(std::string_view scope, std::string_view localName, const char* typeName,
+                                      const EnumNameAndValue* enumInfo, int numEnums) const
+    {
+        const util::ScopedName name{scope, localName};
+        return enumValue(lookup(name), name, typeName, enumInfo, numEnums);
+    }
+
+    bool ConfigurationImpl::lookupBoolean(std::string_view scope, std::string_view localName, bool defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? booleanValue(item, name) : defaultVal;
+    }
+
+    bool ConfigurationImpl::lookupBoolean(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return booleanValue(lookup(name), name);
+    }
+
+    int ConfigurationImpl::lookupDurationMicroseconds(std::string_view scope, std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? intValue(item, name, ConfigItem::Conversion::DurationMicroseconds) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupDurationMicroseconds(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return intValue(lookup(name), name, ConfigItem::Conversion::DurationMicroseconds);
+    }
+
+    int ConfigurationImpl::lookupDurationMilliseconds(std::string_view scope, std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? intValue(item, name, ConfigItem::Conversion::DurationMilliseconds) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupDurationMilliseconds(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return intValue(lookup(name), name, ConfigItem::Conversion::DurationMilliseconds);
+    }
+
+    int ConfigurationImpl::lookupDurationSeconds(std::string_view scope, std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? intValue(item, name, ConfigItem::Conversion::DurationSeconds) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupDurationSeconds(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return intValue(lookup(name), name, ConfigItem::Conversion::DurationSeconds);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeBytes(std::string_view scope, std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? intValue(item, name, ConfigItem::Conversion::MemorySizeBytes) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupMemorySizeBytes(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return intValue(lookup(name), name, ConfigItem::Conversion::MemorySizeBytes);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeKB(std::string_view scope, std::string_view localName, int defaultVal) const
+    {
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? intValue(item, name, ConfigItem::Conversion::MemorySizeKB) : defaultVal;
+    }
+
+    int ConfigurationImpl::lookupMemorySizeKB(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return intValue(lookup(name), name, ConfigItem::Conversion::MemorySizeKB);
+    }
+
+    int ConfigurationImpl::lookupMemorySizeMB(std::string_view scope, std::string_view localName, int defaultVal) const
     {
-        float floatVal;
-        const char* units;
-        int i;
-        int unitsVal;
+        const util::ScopedName name{scope, localName};
+        const ConfigItem* item = lookup(name);
+        return item != nullptr ? intValue(item, name, ConfigItem::Conversion::MemorySizeMB) : defaultVal;
+    }
 
-        // Is the duration "infinite"?
-        if (!strcmp(str, "infinite"))
-        {
-            return -1;
-        }
+    int ConfigurationImpl::lookupMemorySizeMB(std::string_view scope, std::string_view localName) const
+    {
+        const util::ScopedName name{scope, localName};
+        return intValue(lookup(name), name, ConfigItem::Conversion::MemorySizeMB);
+    }
 
-        // Use stringToFloatWithUnits()
-        try
-        {
-            stringToFloatWithUnits(scope, localName, "durationSeconds", str, allowedDurationSecondsUnits,
-                                   countAllowedDurationSecondsUnits, floatVal, units);
-        }
-        catch (const ConfigurationException& ex)
-        {
-            std::stringstream msg;
-            msg << ex.message() << "; alternatively, you can use 'infinite'";
-            throw ConfigurationException(msg.str());
-        }
-        compat::checkAssertion(countDurationSecondsInfo == countAllowedDurationSecondsUnits);
-        int result = -1; // avoid compiler warning about an unitialized variable
-        for (i = 0; i < countDurationSecondsInfo; ++i)
+    //----------------------------------------------------------------------
+    // Function:	lookupBatch()
+    //
+    // Description:	Look up a number of entries of the same scope. The
+    //		scope is resolved once, and each entry is then looked
+    //		up in it directly (or in the fallback configuration).
+    //
+    // Notes:	Errors are reported in the status and error of each
+    //		entry rather than thrown, so one missing entry does not
+    //		stop the others from being filled in.
+    //----------------------------------------------------------------------
+
+    std::size_t ConfigurationImpl::lookupBatch(std::string_view scope, std::span<LookupRequest> requests) const
+    {
+        const ConfigScope* scopeObj = nullptr;
+        const bool resolved = resolveScope(scope, scopeObj);
+        std::size_t failures{0};
+
+        for (auto& request : requests)
         {
-            if (strcmp(durationSecondsUnitsInfo[i].spelling, units) == 0)
+            const util::ScopedName name{scope, request.localName};
+            const ConfigItem* item = (resolved == true ? lookupInResolvedScope(scopeObj, name, request.localName)
+                                                       : lookup(name));
+
+            try
             {
-                unitsVal = durationSecondsUnitsInfo[i].val;
-                result = static_cast<int>(floatVal * unitsVal);
-                break;
+                if (item == nullptr && request.required == false)
+                {
+                    request.status = LookupRequest::Status::Defaulted;
+                }
+                else
+                {
+                    storeValue(request, item, name);
+                    request.status = LookupRequest::Status::Found;
+                }
+                request.error.clear();
+            }
+            catch (const ConfigurationException& ex)
+            {
+                request.status = (item == nullptr ? LookupRequest::Status::Missing : LookupRequest::Status::Invalid);
+                request.error = ex.message();
+                ++failures;
             }
         }
-        compat::checkAssertion(i < countDurationSecondsInfo);
-        return result;
+        return failures;
     }
 
-    int ConfigurationImpl::lookupDurationMicroseconds(const char* scope, const char* localName, int defaultVal) const
-    {
-        char defaultStrValue[128]; // big enough
+    //----------------------------------------------------------------------
+    // Function:	resolveScope()
+    //
+    // Description:	Find the scope that entries are looked up in
+    //		relative to; scopeObj is nullptr if it does not exist
+    //		in this configuration. Returns false if the scope can
+    //		not be resolved separately from the local names.
+    //----------------------------------------------------------------------
 
-        if (defaultVal == -1)
+    bool ConfigurationImpl::resolveScope(std::string_view scope, const ConfigScope*& scopeObj) const
+    {
+        if (scope.empty() == true)
         {
-            sprintf(defaultStrValue, "infinite");
+            scopeObj = m_rootScope.get();
+            return true;
         }
-        else
+        if (scope.front() == '.')
         {
-            sprintf(defaultStrValue, "%d microseconds", defaultVal);
+            scope.remove_prefix(1);
+        }
+        if (hasEmptyComponent(scope) == true)
+        {
+            return false;
         }
-        const char* strValue = lookupString(scope, localName, defaultStrValue);
-        const int result = stringToDurationMicroseconds(scope, localName, strValue);
-        return result;
-    }
 
-    int ConfigurationImpl::lookupDurationMicroseconds(const char* scope, const char* localName) const
-    {
-        const char* strValue = lookupString(scope, localName);
-        const int result = stringToDurationMicroseconds(scope, localName, strValue);
-        return result;
+        const ConfigItem* item = lookupInScope(m_rootScope.get(), {scope, ""});
+        scopeObj = (item != nullptr && item->type() == ConfType::Scope ? item->scopeVal() : nullptr);
+        return true;
     }
 
-    int ConfigurationImpl::lookupDurationMilliseconds(const char* scope, const char* localName, int defaultVal) const
-    {
-        char defaultStrValue[128]; // big enough
+    //----------------------------------------------------------------------
+    // Function:	lookupInResolvedScope()
+    //
+    // Description:	Find the entry named by the scope of a previous
+    //		resolveScope() and localName. This is the same entry
+    //		lookup(name) finds, but only localName is resolved.
+    //----------------------------------------------------------------------
 
-        if (defaultVal == -1)
+    const ConfigItem* ConfigurationImpl::lookupInResolvedScope(const ConfigScope* scopeObj, const util::ScopedName& name,
+                                                               std::string_view localName) const
+    {
+        if (hasEmptyComponent(localName) == true)
         {
-            sprintf(defaultStrValue, "infinite");
+            return lookup(name);
         }
-        else
+
+        const ConfigItem* item = (scopeObj != nullptr ? lookupInScope(scopeObj, {"", localName}) : nullptr);
+
+        if (item == nullptr)
         {
-            sprintf(defaultStrValue, "%d milliseconds", defaultVal);
+            item = lookupInFallback(localName);
         }
-        const char* strValue = lookupString(scope, localName, defaultStrValue);
-        const int result = stringToDurationMilliseconds(scope, localName, strValue);
-        return result;
-    }
-
-    int ConfigurationImpl::lookupDurationMilliseconds(const char* scope, const char* localName) const
-    {
-        const char* strValue = lookupString(scope, localName);
-        const int result = stringToDurationMilliseconds(scope, localName, strValue);
-        return result;
+        return item;
     }
 
-    int ConfigurationImpl::lookupDurationSeconds(const char* scope, const char* localName, int defaultVal) const
+    void ConfigurationImpl::storeValue(LookupRequest& request, const ConfigItem* item, const util::ScopedName& name) const
     {
-        char defaultStrValue[128]; // big enough
+        using Type = LookupRequest::Type;
+        using Conversion = ConfigItem::Conversion;
 
-        if (defaultVal == -1)
-        {
-            sprintf(defaultStrValue, "infinite");
-        }
-        else
+        switch (request.type)
         {
-            sprintf(defaultStrValue, "%d seconds", defaultVal);
+            case Type::String:
+                destinationOf<std::string_view>(request) = checkedStringValue(item, name);
+                break;
+            case Type::List:
+                checkedListValue(item, name, destinationOf<std::vector<std::string>>(request));
+                break;
+            case Type::Int:
+                destinationOf<int>(request) = intValue(item, name, Conversion::Int);
+                break;
+            case Type::Float:
+                destinationOf<float>(request) = floatValue(item, name);
+                break;
+            case Type::Boolean:
+                destinationOf<bool>(request) = booleanValue(item, name);
+                break;
+            case Type::DurationMicroseconds:
+                destinationOf<int>(request) = intValue(item, name, Conversion::DurationMicroseconds);
+                break;
+            case Type::DurationMilliseconds:
+                destinationOf<int>(request) = intValue(item, name, Conversion::DurationMilliseconds);
+                break;
+            case Type::DurationSeconds:
+                destinationOf<int>(request) = intValue(item, name, Conversion::DurationSeconds);
+                break;
+            case Type::MemorySizeBytes:
+                destinationOf<int>(request) = intValue(item, name, Conversion::MemorySizeBytes);
+                break;
+            case Type::MemorySizeKB:
+                destinationOf<int>(request) = intValue(item, name, Conversion::MemorySizeKB);
+                break;
+            case Type::MemorySizeMB:
+                destinationOf<int>(request) = intValue(item, name, Conversion::MemorySizeMB);
+                break;
+            default:
+                throw std::exception{}; // Bug
         }
-        const char* strValue = lookupString(scope, localName, defaultStrValue);
-        const int result = stringToDurationSeconds(scope, localName, strValue);
-        return result;
     }
 
-    int ConfigurationImpl::lookupDurationSeconds(const char* scope, const char* localName) const
+    //----------------------------------------------------------------------
+    // Function:	scopeView()
+    //
+    // Description:	Resolve the scope for lookups relative to it.
+    //----------------------------------------------------------------------
+
+    ScopeView ConfigurationImpl::scopeView(std::string_view scope) const
     {
-        const char* strValue = lookupString(scope, localName);
-        const int result = stringToDurationSeconds(scope, localName, strValue);
-        return result;
+        const ConfigScope* scopeObj = nullptr;
+        const bool resolved = resolveScope(scope, scopeObj);
+        return makeScopeView(std::string{scope}, scopeObj, resolved);
     }
 
-    int ConfigurationImpl::stringToMemorySizeGeneric(const char* typeName, SpellingAndValue unitsInfo[], int unitsInfoSize,
-                                                     const char* allowedUnits[], const char* scope, const char* localName,
-                                                     const char* str) const
+    //----------------------------------------------------------------------
+    // Function:	childView()
+    //
+    // Description:	Resolve a scope nested in the one of the parent
+    //		view, starting from the parent scope if possible.
+    //----------------------------------------------------------------------
+
+    ScopeView ConfigurationImpl::childView(const ScopeView& parent, std::string_view localName) const
     {
-        float floatVal;
-        const char* units;
-        int result;
-        int unitsVal;
+        std::string name = util::ScopedName{parent.scope(), localName}.str();
 
-        stringToFloatWithUnits(scope, localName, typeName, str, allowedUnits, unitsInfoSize, floatVal, units);
-        result = -1; // avoid compiler warning about an unitialized variable
-        int i = 0;
-        for (i = 0; i < unitsInfoSize; ++i)
+        if (parent.m_owner == this && parent.m_generation == generation() && parent.m_resolved == true &&
+            hasEmptyComponent(localName) == false)
         {
-            if (strcmp(unitsInfo[i].spelling, units) == 0)
-            {
-                unitsVal = unitsInfo[i].val;
-                result = static_cast<int>(floatVal * unitsVal);
-                break;
-            }
+            const ConfigItem* item = (parent.m_scope != nullptr ? lookupInScope(parent.m_scope, {"", localName}) : nullptr);
+            const ConfigScope* scopeObj = (item != nullptr && item->type() == ConfType::Scope ? item->scopeVal() : nullptr);
+            return makeScopeView(std::move(name), scopeObj, true);
         }
-        compat::checkAssertion(i < unitsInfoSize);
-        return result;
-    }
 
-    int ConfigurationImpl::stringToMemorySizeBytes(const char* scope, const char* localName, const char* str) const
-    {
-        static const char* allowedUnits[] = {"byte", "bytes", "KB", "MB", "GB"};
-        return stringToMemorySizeGeneric("memorySizeBytes", MemorySizeBytesUnitsInfo, 5, allowedUnits, scope, localName, str);
+        const ConfigScope* scopeObj = nullptr;
+        const bool resolved = resolveScope(name, scopeObj);
+        return makeScopeView(std::move(name), scopeObj, resolved);
     }
 
-    int ConfigurationImpl::stringToMemorySizeKB(const char* scope, const char* localName, const char* str) const
-    {
-        static const char* allowedUnits[] = {"KB", "MB", "GB", "TB"};
-        return stringToMemorySizeGeneric("memorySizeKB", MemorySizeKBUnitsInfo, 4, allowedUnits, scope, localName, str);
-    }
+    //----------------------------------------------------------------------
+    // Function:	makeScopeView()
+    //
+    // Description:	Create a view of the named scope. Unless it was
+    //		found in this configuration, make sure the scope
+    //		exists (e.g. in the fallback configuration).
+    //----------------------------------------------------------------------
 
-    int ConfigurationImpl::stringToMemorySizeMB(const char* scope, const char* localName, const char* str) const
+    ScopeView ConfigurationImpl::makeScopeView(std::string name, const ConfigScope* scopeObj, bool resolved) const
     {
-        static const char* allowedUnits[] = {"MB", "GB", "TB", "PB"};
-        return stringToMemorySizeGeneric("memorySizeMB", MemorySizeMBUnitsInfo, 4, allowedUnits, scope, localName, str);
+        if (scopeObj == nullptr)
+        {
+            lookupScope("", name.c_str());
+        }
+        return ScopeView{this, generation(), scopeObj, resolved, std::move(name)};
     }
 
-    int ConfigurationImpl::lookupMemorySizeBytes(const char* scope, const char* localName, int defaultVal) const
+    //----------------------------------------------------------------------
+    // Function:	lookup()
+    //
+    // Description:	Find the entry relative to the scope of the view.
+    //		Stale or foreign views are resolved by name again.
+    //----------------------------------------------------------------------
+
+    const ConfigItem* ConfigurationImpl::lookup(const ScopeView& view, std::string_view localName) const
     {
-        char defaultStrValue[64]; // big enough
+        const util::ScopedName name{view.scope(), localName};
 
-        sprintf(defaultStrValue, "%d milliseconds", defaultVal);
-        const char* strValue = lookupString(scope, localName, defaultStrValue);
-        const int result = stringToMemorySizeBytes(scope, localName, strValue);
-        return result;
+        if (view.m_owner == this && view.m_generation == generation() && view.m_resolved == true)
+        {
+            return lookupInResolvedScope(view.m_scope, name, localName);
+        }
+        return lookup(name);
     }
 
-    int ConfigurationImpl::lookupMemorySizeBytes(const char* scope, const char* localName) const
+    //----------------------------------------------------------------------
+    // Function:	mayExist()
+    //
+    // Description:	Return false if the name (relative to the root
+    //		scope) is known not to exist in this configuration.
+    //----------------------------------------------------------------------
+
+    bool ConfigurationImpl::mayExist(const util::ScopedName& name) const
     {
-        const char* strValue = lookupString(scope, localName);
-        const int result = stringToMemorySizeBytes(scope, localName, strValue);
-        return result;
+        const NameFilter* filter = m_nameFilterView.load(std::memory_order_acquire);
+        return filter == nullptr || filter->mayContain(name.hash());
     }
 
-    int ConfigurationImpl::lookupMemorySizeKB(const char* scope, const char* localName, int defaultVal) const
+    //----------------------------------------------------------------------
+    // Function:	noteMiss()
+    //
+    // Description:	Count a lookup of an absent name. Once they add up,
+    //		build the name filter so later ones are answered
+    //		without walking the scopes.
+    //
+    // Notes:	Exactly one lookup reaches the threshold, so the
+    //		filter is built once and concurrent lookups only see it
+    //		after it is complete.
+    //----------------------------------------------------------------------
+
+    void ConfigurationImpl::noteMiss() const
     {
-        char defaultStrValue[64]; // big enough
+        constexpr std::uint32_t missesBeforeFilter{16};
 
-        sprintf(defaultStrValue, "%d KB", defaultVal);
-        const char* strValue = lookupString(scope, localName, defaultStrValue);
-        const int result = stringToMemorySizeKB(scope, localName, strValue);
-        return result;
+        if (m_nameFilterView.load(std::memory_order_relaxed) == nullptr &&
+            m_misses.fetch_add(1, std::memory_order_relaxed) + 1 == missesBeforeFilter)
+        {
+            m_nameFilter = std::make_unique<NameFilter>(*m_rootScope);
+            m_nameFilterView.store(m_nameFilter.get(), std::memory_order_release);
+        }
     }
 
-    int ConfigurationImpl::lookupMemorySizeKB(const char* scope, const char* localName) const
-    {
-        const char* strValue = lookupString(scope, localName);
-        const int result = stringToMemorySizeKB(scope, localName, strValue);
-        return result;
-    }
+    //----------------------------------------------------------------------
+    // Function:	mergedIndex()
+    //
+    // Description:	Return the merged index, building it if it is
+    //		enabled but out of date, or nullptr.
+    //
+    // Notes:	Only the lookup which clears the stale flag builds
+    //		the index; concurrent lookups take the ordinary path
+    //		until it is published.
+    //----------------------------------------------------------------------
 
-    int ConfigurationImpl::lookupMemorySizeMB(const char* scope, const char* localName, int defaultVal) const
+    const FrozenIndex* ConfigurationImpl::mergedIndex() const
     {
-        char defaultStrValue[64]; // big enough
+        const FrozenIndex* index = m_mergedIndexView.load(std::memory_order_acquire);
 
-        sprintf(defaultStrValue, "%d MB", defaultVal);
-        const char* strValue = lookupString(scope, localName, defaultStrValue);
-        const int result = stringToMemorySizeMB(scope, localName, strValue);
-        return result;
-    }
+        if (index == nullptr && m_mergedIndexStale.load(std::memory_order_relaxed) == true &&
+            m_mergedIndexStale.exchange(false, std::memory_order_relaxed) == true)
+        {
+            std::vector<const ConfigScope*> fallbackRoots;
 
-    int ConfigurationImpl::lookupMemorySizeMB(const char* scope, const char* localName) const
-    {
-        const char* strValue = lookupString(scope, localName);
-        const int result = stringToMemorySizeMB(scope, localName, strValue);
-        return result;
+            for (const ConfigurationImpl* cfg = m_fallbackCfg; cfg != nullptr; cfg = cfg->m_fallbackCfg)
+            {
+                fallbackRoots.push_back(cfg->m_rootScope.get());
+            }
+            m_mergedIndex = std::make_unique<FrozenIndex>(*m_rootScope, fallbackRoots);
+            index = m_mergedIndex.get();
+            m_mergedIndexView.store(index, std::memory_order_release);
+        }
+        return index;
     }
 
-    float ConfigurationImpl::lookupFloat(const char* scope, const char* localName, float defaultVal) const
+    //----------------------------------------------------------------------
+    // Function:	resetLookupCaches()
+    //
+    // Description:	Drop the name filter and the merged index, which
+    //		refer to the tree as it was when they were built.
+    //----------------------------------------------------------------------
+
+    void ConfigurationImpl::resetLookupCaches()
     {
-        char defaultStrVal[64]; // Big enough
+        m_nameFilterView.store(nullptr, std::memory_order_relaxed);
+        m_nameFilter.reset();
+        m_misses.store(0, std::memory_order_relaxed);
 
-        sprintf(defaultStrVal, "%g", defaultVal);
-        const char* strValue = lookupString(scope, localName, defaultStrVal);
-        const float result = stringToFloat(scope, localName, strValue);
-        return result;
+        m_mergedIndexView.store(nullptr, std::memory_order_relaxed);
+        m_mergedIndex.reset();
+        m_mergedIndexStale.store(m_mergedIndexEnabled == true && m_parsing == false, std::memory_order_relaxed);
     }
 
-    float ConfigurationImpl::lookupFloat(const char* scope, const char* localName) const
+    //----------------------------------------------------------------------
+    // Function:	generation()
+    //
+    // Description:	Return a stamp that changes whenever this
+    //		configuration or its fallback configuration is modified.
+    //----------------------------------------------------------------------
+
+    std::uint64_t ConfigurationImpl::generation() const
     {
-        const char* strValue = lookupString(scope, localName);
-        const float result = stringToFloat(scope, localName, strValue);
-        return result;
+        return m_generation;
     }
 
-    void ConfigurationImpl::lookupScope(const char* scope, const char* localName) const
+    //----------------------------------------------------------------------
+    // Function:	modified()
+    //
+    // Description:	Invalidate all keys resolved against this
+    //		configuration and those using it as a fallback.
+    //----------------------------------------------------------------------
+
+    void ConfigurationImpl::modified()
     {
-        std::stringstream msg;
-        StringBuffer fullyScopedName;
+        m_generation = nextGeneration();
+        resetLookupCaches();
 
-        mergeNames(scope, localName, fullyScopedName);
-        switch (type(scope, localName))
+        for (auto dependent : m_dependentCfgs)
         {
-            case ConfType::Scope:
-                // Okay
-                break;
-            case ConfType::String:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a string instead of a scope";
-                throw ConfigurationException(msg.str());
-            case ConfType::List:
-                msg << fileName() << ": '" << fullyScopedName.str() << "' is a list instead of a scope";
-                throw ConfigurationException(msg.str());
-            case ConfType::NoValue:
-                msg << fileName() << ": scope '" << fullyScopedName.str() << "' does not exist";
-                throw ConfigurationException(msg.str());
-            default:
-                throw std::exception{}; // Bug
+            dependent->modified();
         }
     }
 
@@ -2088,6 +3273,8 @@ namespace danek
     {
         std::stringstream msg;
 
+        checkNotFrozen();
+        modified();
         scope = m_currScope;
         for (int i = firstIndex; i <= lastIndex; ++i)
         {
@@ -2111,8 +3298,6 @@ namespace danek
 
     bool ConfigurationImpl::isExecAllowed(const char* cmdLine, StringBuffer& trustedCmdLine)
     {
-        StringVector allowPatterns;
-        StringVector denyPatterns;
         StringVector trustedDirs;
         StringBuffer cmd;
         const char* ptr;
@@ -2123,50 +3308,43 @@ namespace danek
         }
         const char* scope = m_securityCfgScope.str().c_str();
 
-        m_securityCfg->lookupList(scope, "allow_patterns", allowPatterns);
-        m_securityCfg->lookupList(scope, "deny_patterns", denyPatterns);
+        const PatternSet allowPatterns{m_securityCfg->lookupListView(scope, "allow_patterns")};
+        const PatternSet denyPatterns{m_securityCfg->lookupListView(scope, "deny_patterns")};
         m_securityCfg->lookupList(scope, "trusted_directories", trustedDirs);
 
         // Check if there is any rule to deny execution.
-        const int len = denyPatterns.size();
-        for (int i = 0; i < len; ++i)
+        if (denyPatterns.matchesAny(cmdLine) == true)
         {
-            if (patternMatch(cmdLine, denyPatterns[i].c_str()))
-            {
-                return false;
-            }
+            return false;
         }
 
         // Check if there is any rule to allow execution *and* the
         // command can be found in trusted_directories.
-        const int len2 = allowPatterns.size();
-        for (int i = 0; i < len2; ++i)
+        if (allowPatterns.matchesAny(cmdLine) == false)
         {
-            if (!patternMatch(cmdLine, allowPatterns[i].c_str()))
-            {
-                continue;
-            }
-            // Found cmdLine in allow_patterns. Now extract the
-            // first word from cmdLine to get the actual command.
-            cmd = "";
-            ptr = cmdLine;
-            while (*ptr != '\0' && !isspace(*ptr))
-            {
-                cmd.append(*ptr);
-                ++ptr;
-            }
+            return false;
+        }
+
+        // Found cmdLine in allow_patterns. Now extract the
+        // first word from cmdLine to get the actual command.
+        cmd = "";
+        ptr = cmdLine;
+        while (*ptr != '\0' && !isspace(*ptr))
+        {
+            cmd.append(*ptr);
+            ++ptr;
+        }
 
-            // Check if cmd resides in a directory in
-            // trusted_directories.
-            for (std::size_t j = 0; j < trustedDirs.size(); ++j)
+        // Check if cmd resides in a directory in
+        // trusted_directories.
+        for (std::size_t j = 0; j < trustedDirs.size(); ++j)
+        {
+            if (platform::isCmdInDir(cmd.str(), trustedDirs[j]))
             {
-                if (platform::isCmdInDir(cmd.str(), trustedDirs[j]))
-                {
-                    trustedCmdLine = "";
-                    trustedCmdLine << trustedDirs[j].c_str() << platform::directorySeparator() << cmd
-                                   << &cmdLine[strlen(cmd.str().c_str())];
-                    return true;
-                }
+                trustedCmdLine = "";
+                trustedCmdLine << trustedDirs[j].c_str() << platform::directorySeparator() << cmd
+                               << &cmdLine[strlen(cmd.str().c_str())];
+                return true;
             }
         }
         return false;
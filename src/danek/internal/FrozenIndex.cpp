@@ -0,0 +1,223 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/internal/FrozenIndex.h"
+#include "danek/internal/ConfigItem.h"
+#include "danek/internal/ConfigScope.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+
+namespace danek
+{
+    namespace
+    {
+        constexpr std::size_t minIndexSize{8};
+
+
+        // The merged name of a ScopedName as (up to three) pieces, without copying them. A
+        // trailing '.' is dropped, as ScopedName::hash() does.
+        class NamePieces
+        {
+        public:
+            explicit NamePieces(const util::ScopedName& name)
+                : m_pieces{{name.part(0)}}, m_count(1)
+            {
+                if (name.numParts() == 2)
+                {
+                    m_pieces[1] = ".";
+                    m_pieces[2] = name.part(1);
+                    m_count = 3;
+                }
+
+                auto& last = m_pieces[m_count - 1];
+
+                if (last.empty() == false && last.back() == '.')
+                {
+                    last.remove_suffix(1);
+                }
+            }
+
+            bool equals(std::string_view str) const
+            {
+                for (std::size_t i = 0; i < m_count; ++i)
+                {
+                    const auto piece = m_pieces[i];
+
+                    if (str.substr(0, piece.size()) != piece)
+                    {
+                        return false;
+                    }
+                    str.remove_prefix(piece.size());
+                }
+                return str.empty();
+            }
+
+        private:
+            std::array<std::string_view, 3> m_pieces;
+            std::size_t m_count;
+        };
+    }
+
+
+    FrozenIndex::FrozenIndex(const ConfigScope& root, std::pmr::memory_resource* resource)
+        : FrozenIndex(root, {}, resource)
+    {
+    }
+
+    FrozenIndex::FrozenIndex(const ConfigScope& root, std::span<const ConfigScope* const> fallbackRoots,
+                             std::pmr::memory_resource* resource)
+        : m_names(resource), m_slots(resource), m_size(0)
+    {
+        collect(root, false);
+
+        for (const auto fallbackRoot : fallbackRoots)
+        {
+            collect(*fallbackRoot, true);
+        }
+
+        if (m_names.size() > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::length_error{"Names exceed the size of the index"};
+        }
+
+        //--------
+        // Collect stores the entries in the table unhashed; rehash them
+        // into a table which is at most half full.
+        //--------
+        std::pmr::vector<Slot> entries{std::move(m_slots), resource};
+        m_slots.assign(std::bit_ceil(std::max(minIndexSize, 2 * entries.size())), Slot{0, 0, 0, nullptr, nullptr});
+
+        for (const auto& entry : entries)
+        {
+            insert(entry);
+        }
+    }
+
+    const ConfigItem* FrozenIndex::find(const util::ScopedName& name) const
+    {
+        const Slot* slot = probe(name);
+        return slot != nullptr ? slot->item : nullptr;
+    }
+
+    const ConfigItem* FrozenIndex::findInFallback(const util::ScopedName& name) const
+    {
+        const Slot* slot = probe(name);
+        return slot != nullptr ? slot->fallbackItem : nullptr;
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	findWithFallback()
+    //
+    // Description:	Find the item of the root, or else the item the
+    //		fallback configurations have for the local name.
+    //
+    // Notes:	If the name has no scope, both are in the same slot.
+    //----------------------------------------------------------------------
+
+    const ConfigItem* FrozenIndex::findWithFallback(const util::ScopedName& name) const
+    {
+        const Slot* slot = probe(name);
+
+        if (slot != nullptr && slot->item != nullptr)
+        {
+            return slot->item;
+        }
+        if (name.numParts() == 1 && name.part(0) == name.localName())
+        {
+            return slot != nullptr ? slot->fallbackItem : nullptr;
+        }
+        return findInFallback({"", name.localName()});
+    }
+
+    std::size_t FrozenIndex::size() const
+    {
+        return m_size;
+    }
+
+    void FrozenIndex::collect(const ConfigScope& root, bool fallback)
+    {
+        std::string name;
+
+        root.forEachItem(ConfType::ScopesAndVars, true, name, [this, fallback](std::string_view scopedName, const ConfigItem& item) {
+            const auto offset = m_names.size();
+
+            m_names.append(scopedName);
+            m_slots.push_back(Slot{util::hashName(scopedName), static_cast<std::uint32_t>(offset),
+                                   static_cast<std::uint32_t>(scopedName.size()), fallback ? nullptr : &item,
+                                   fallback ? &item : nullptr});
+        });
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	insert()
+    //
+    // Description:	Add an entry to the table. An entry for a name which
+    //		is already there only fills in the items it has not got
+    //		yet, so the root takes precedence over its fallbacks and
+    //		a nearer fallback over a farther one.
+    //----------------------------------------------------------------------
+
+    void FrozenIndex::insert(const Slot& entry)
+    {
+        const auto mask = m_slots.size() - 1;
+        auto i = entry.hash & mask;
+
+        for (; m_slots[i].used() == true; i = (i + 1) & mask)
+        {
+            auto& slot = m_slots[i];
+
+            if (slot.hash == entry.hash && key(slot) == key(entry))
+            {
+                slot.item = (slot.item != nullptr ? slot.item : entry.item);
+                slot.fallbackItem = (slot.fallbackItem != nullptr ? slot.fallbackItem : entry.fallbackItem);
+                return;
+            }
+        }
+        m_slots[i] = entry;
+        ++m_size;
+    }
+
+    const FrozenIndex::Slot* FrozenIndex::probe(const util::ScopedName& name) const
+    {
+        const NamePieces pieces{name};
+        const auto hash = name.hash();
+        const auto mask = m_slots.size() - 1;
+
+        for (auto i = hash & mask; m_slots[i].used() == true; i = (i + 1) & mask)
+        {
+            if (m_slots[i].hash == hash && pieces.equals(key(m_slots[i])) == true)
+            {
+                return &m_slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    std::string_view FrozenIndex::key(const Slot& slot) const
+    {
+        return std::string_view{m_names}.substr(slot.offset, slot.length);
+    }
+}
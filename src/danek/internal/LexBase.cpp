@@ -22,77 +22,270 @@
 // SOFTWARE.
 
 #include "danek/internal/LexBase.h"
-#include "danek/internal/Compat.h"
+#include "danek/internal/LexScan.h"
 #include "danek/internal/UidIdentifierDummyProcessor.h"
+#include "danek/internal/Utf8.h"
 #include "danek/internal/platform/Platform.h"
-#include <ctype.h>
-#include <errno.h>
-#include <stdio.h>
-#include <stdlib.h>
+#include <array>
+#include <cstdint>
 #include <string.h>
-#include <wchar.h>
+#include <string>
+#include <utility>
 
 namespace danek
 {
-    extern "C" int danek_keywordInfoCmp(const void* ptr1, const void* ptr2)
+    namespace
     {
-        const auto sas1 = static_cast<const LexBase::KeywordInfo*>(ptr1);
-        const auto sas2 = static_cast<const LexBase::KeywordInfo*>(ptr2);
-        return strcmp(sas1->m_spelling, sas2->m_spelling);
-    }
-
-    void LexBase::searchForKeyword(const char* spelling, bool& found, short& symbol)
-    {
-        LexBase::KeywordInfo searchItem;
-        LexBase::KeywordInfo* result = nullptr;
+        //--------
+        // The token recogniser is a DFA over character classes. Strings,
+        // block strings and comments are recognised by their opening
+        // chars and then consumed by dedicated routines.
+        //--------
+        enum class CharClass : std::uint8_t
+        {
+            Space,
+            Letter,     // may appear in keywords and identifiers
+            IdentChar,  // may appear in identifiers only
+            Question,   // may appear in identifiers, but not first
+            At,
+            Quote,
+            Hash,
+            Less,
+            Percent,
+            Equals,
+            Bang,
+            Amp,
+            Bar,
+            Plus,
+            Semicolon,
+            Comma,
+            OpenBracket,
+            CloseBracket,
+            OpenBrace,
+            CloseBrace,
+            OpenParen,
+            CloseParen,
+            Other,
+            EndOfInput,
+            Count
+        };
+
+        enum class State : std::uint8_t
+        {
+            Start,
+            Ident,
+            Function,
+            Keyword,
+            Question,
+            QuestionEquals,
+            Bang,
+            NotEquals,
+            Equals,
+            EqualsEquals,
+            Amp,
+            And,
+            Bar,
+            Or,
+            Less,
+            BlockString,
+            Plus,
+            Semicolon,
+            Comma,
+            OpenBracket,
+            CloseBracket,
+            OpenBrace,
+            CloseBrace,
+            OpenParen,
+            CloseParen,
+            String,
+            Comment,
+            Unknown,
+            Stop,
+            Count
+        };
 
-        searchItem.m_spelling = spelling;
-        if (m_keywordInfoArraySize == 0)
+        //--------
+        // What to do with the chars consumed when the DFA stops in a
+        // state. Token states report their symbol with the consumed
+        // chars as spelling; Incomplete ones (a "?", "&" or "|" not
+        // followed by the rest of their operator) report an unknown
+        // symbol whose spelling includes the lookahead char.
+        //--------
+        enum class Action : std::uint8_t
         {
-            found = false;
-            return;
-        }
-        result = static_cast<LexBase::KeywordInfo*>(
-            bsearch(&searchItem, m_keywordInfoArray, m_keywordInfoArraySize, sizeof(searchItem), danek_keywordInfoCmp));
-        if (result == nullptr)
+            Token,
+            Incomplete,
+            Identifier,
+            Function,
+            Keyword,
+            String,
+            BlockString,
+            Comment
+        };
+
+        struct Accept
         {
-            found = false;
+            Action action;
+            short symbol;
+        };
+
+        constexpr std::size_t index(CharClass cls)
+        {
+            return static_cast<std::size_t>(cls);
         }
-        else
+
+        constexpr std::size_t index(State state)
         {
-            found = true;
-            symbol = result->m_symbol;
+            return static_cast<std::size_t>(state);
         }
-    }
 
-    extern "C" int danek_funcInfoCmp_c(const void* ptr1, const void* ptr2)
-    {
-        const auto sas1 = static_cast<const LexBase::FuncInfo*>(ptr1);
-        const auto sas2 = static_cast<const LexBase::FuncInfo*>(ptr2);
-        return strcmp(sas1->m_spelling, sas2->m_spelling);
-    }
+        //--------
+        // Classes of the bytes of the input. Carriage returns and
+        // non-ASCII bytes are in classes which end every run, so that
+        // nextChar() skips or decodes them.
+        //--------
+        constexpr auto byteClasses = [] {
+            std::array<CharClass, 256> table{};
+            table.fill(CharClass::Other);
 
-    void LexBase::searchForFunction(const char* spelling, bool& found, FunctionType& funcType, short& symbol)
-    {
-        FuncInfo searchItem;
+            for (int ch = 'a'; ch <= 'z'; ++ch)
+            {
+                table[static_cast<std::size_t>(ch)] = CharClass::Letter;
+                table[static_cast<std::size_t>(ch - 'a' + 'A')] = CharClass::Letter;
+            }
+            for (int ch = '0'; ch <= '9'; ++ch)
+            {
+                table[static_cast<std::size_t>(ch)] = CharClass::IdentChar;
+            }
+            for (const char ch : {'-', '_', '.', ':', '$', '/', '\\'})
+            {
+                table[static_cast<unsigned char>(ch)] = CharClass::IdentChar;
+            }
+            for (const char ch : {' ', '\t', '\n', '\v', '\f', '\r'})
+            {
+                table[static_cast<unsigned char>(ch)] = CharClass::Space;
+            }
+            const std::pair<char, CharClass> punctuation[] = {
+                {'?', CharClass::Question},     {'@', CharClass::At},           {'"', CharClass::Quote},
+                {'#', CharClass::Hash},         {'<', CharClass::Less},         {'%', CharClass::Percent},
+                {'=', CharClass::Equals},       {'!', CharClass::Bang},         {'&', CharClass::Amp},
+                {'|', CharClass::Bar},          {'+', CharClass::Plus},         {';', CharClass::Semicolon},
+                {',', CharClass::Comma},        {'[', CharClass::OpenBracket},  {']', CharClass::CloseBracket},
+                {'{', CharClass::OpenBrace},    {'}', CharClass::CloseBrace},   {'(', CharClass::OpenParen},
+                {')', CharClass::CloseParen}};
+            for (const auto& [ch, cls] : punctuation)
+            {
+                table[static_cast<unsigned char>(ch)] = cls;
+            }
+            return table;
+        }();
 
-        if (m_funcInfoArraySize == 0)
-        {
-            found = false;
-            return;
-        }
-        searchItem.m_spelling = spelling;
-        FuncInfo* result = static_cast<FuncInfo*>(
-            bsearch(&searchItem, m_funcInfoArray, m_funcInfoArraySize, sizeof(searchItem), danek_funcInfoCmp_c));
-        if (result == nullptr)
+        constexpr auto transitions = [] {
+            std::array<std::array<State, index(CharClass::Count)>, index(State::Count)> table{};
+
+            for (auto& row : table)
+            {
+                row.fill(State::Stop);
+            }
+            const auto set = [&table](State from, CharClass cls, State to) { table[index(from)][index(cls)] = to; };
+
+            set(State::Start, CharClass::Letter, State::Ident);
+            set(State::Start, CharClass::IdentChar, State::Ident);
+            set(State::Ident, CharClass::Letter, State::Ident);
+            set(State::Ident, CharClass::IdentChar, State::Ident);
+            set(State::Ident, CharClass::Question, State::Ident);
+            set(State::Ident, CharClass::OpenParen, State::Function);
+
+            set(State::Start, CharClass::At, State::Keyword);
+            set(State::Keyword, CharClass::Letter, State::Keyword);
+
+            set(State::Start, CharClass::Question, State::Question);
+            set(State::Question, CharClass::Equals, State::QuestionEquals);
+            set(State::Start, CharClass::Bang, State::Bang);
+            set(State::Bang, CharClass::Equals, State::NotEquals);
+            set(State::Start, CharClass::Equals, State::Equals);
+            set(State::Equals, CharClass::Equals, State::EqualsEquals);
+            set(State::Start, CharClass::Amp, State::Amp);
+            set(State::Amp, CharClass::Amp, State::And);
+            set(State::Start, CharClass::Bar, State::Bar);
+            set(State::Bar, CharClass::Bar, State::Or);
+            set(State::Start, CharClass::Less, State::Less);
+            set(State::Less, CharClass::Percent, State::BlockString);
+
+            set(State::Start, CharClass::Plus, State::Plus);
+            set(State::Start, CharClass::Semicolon, State::Semicolon);
+            set(State::Start, CharClass::Comma, State::Comma);
+            set(State::Start, CharClass::OpenBracket, State::OpenBracket);
+            set(State::Start, CharClass::CloseBracket, State::CloseBracket);
+            set(State::Start, CharClass::OpenBrace, State::OpenBrace);
+            set(State::Start, CharClass::CloseBrace, State::CloseBrace);
+            set(State::Start, CharClass::OpenParen, State::OpenParen);
+            set(State::Start, CharClass::CloseParen, State::CloseParen);
+
+            set(State::Start, CharClass::Quote, State::String);
+            set(State::Start, CharClass::Hash, State::Comment);
+            set(State::Start, CharClass::Percent, State::Unknown);
+            set(State::Start, CharClass::Other, State::Unknown);
+            return table;
+        }();
+
+        constexpr auto accepts = [] {
+            std::array<Accept, index(State::Count)> table{};
+            table.fill({Action::Token, lex::LEX_UNKNOWN_SYM});
+
+            const auto set = [&table](State state, Action action, short symbol) { table[index(state)] = {action, symbol}; };
+
+            set(State::Ident, Action::Identifier, lex::LEX_IDENT_SYM);
+            set(State::Function, Action::Function, lex::LEX_UNKNOWN_FUNC_SYM);
+            set(State::Keyword, Action::Keyword, lex::LEX_UNKNOWN_SYM);
+            set(State::Question, Action::Incomplete, lex::LEX_UNKNOWN_SYM);
+            set(State::QuestionEquals, Action::Token, lex::LEX_QUESTION_EQUALS_SYM);
+            set(State::Bang, Action::Token, lex::LEX_NOT_SYM);
+            set(State::NotEquals, Action::Token, lex::LEX_NOT_EQUALS_SYM);
+            set(State::Equals, Action::Token, lex::LEX_EQUALS_SYM);
+            set(State::EqualsEquals, Action::Token, lex::LEX_EQUALS_EQUALS_SYM);
+            set(State::Amp, Action::Incomplete, lex::LEX_UNKNOWN_SYM);
+            set(State::And, Action::Token, lex::LEX_AND_SYM);
+            set(State::Bar, Action::Incomplete, lex::LEX_UNKNOWN_SYM);
+            set(State::Or, Action::Token, lex::LEX_OR_SYM);
+            set(State::BlockString, Action::BlockString, lex::LEX_STRING_SYM);
+            set(State::Plus, Action::Token, lex::LEX_PLUS_SYM);
+            set(State::Semicolon, Action::Token, lex::LEX_SEMICOLON_SYM);
+            set(State::Comma, Action::Token, lex::LEX_COMMA_SYM);
+            set(State::OpenBracket, Action::Token, lex::LEX_OPEN_BRACKET_SYM);
+            set(State::CloseBracket, Action::Token, lex::LEX_CLOSE_BRACKET_SYM);
+            set(State::OpenBrace, Action::Token, lex::LEX_OPEN_BRACE_SYM);
+            set(State::CloseBrace, Action::Token, lex::LEX_CLOSE_BRACE_SYM);
+            set(State::OpenParen, Action::Token, lex::LEX_OPEN_PAREN_SYM);
+            set(State::CloseParen, Action::Token, lex::LEX_CLOSE_PAREN_SYM);
+            set(State::String, Action::String, lex::LEX_STRING_SYM);
+            set(State::Comment, Action::Comment, lex::LEX_UNKNOWN_SYM);
+            return table;
+        }();
+
+        CharClass classOf(const MBChar& ch, bool atEOF)
         {
-            found = false;
+            if (atEOF == true)
+            {
+                return CharClass::EndOfInput;
+            }
+            if (ch.codePoint() < 0x80)
+            {
+                return byteClasses[ch.codePoint()];
+            }
+            return (ch.isSpace() == true) ? CharClass::Space : CharClass::IdentChar;
         }
-        else
+
+        constexpr bool loops(State state)
         {
-            found = true;
-            funcType = result->m_funcType;
-            symbol = result->m_symbol;
+            for (const State next : transitions[index(state)])
+            {
+                if (next == state)
+                {
+                    return true;
+                }
+            }
+            return false;
         }
     }
 
@@ -100,13 +293,8 @@ namespace danek
     {
         StringBuffer msg;
 
-        // Initialize state for the multi-byte functions in the C library.
-        memset(&m_mbtowcState, 0, sizeof(mbstate_t));
-
-        m_keywordInfoArray = nullptr;
-        m_keywordInfoArraySize = 0;
-        m_funcInfoArray = nullptr;
-        m_funcInfoArraySize = 0;
+        m_keywords = nullptr;
+        m_funcs = nullptr;
 
         m_uidIdentifierProcessor = uidIdentifierProcessor;
         m_amOwnerOfUidIdentifierProcessor = false;
@@ -114,27 +302,35 @@ namespace danek
         m_source = source;
         m_lineNum = 1;
         m_ptr = nullptr;
+        m_end = nullptr;
         m_atEOF = false;
         switch (sourceType)
         {
             case Configuration::SourceType::File:
             {
-                m_file.open(source);
-                if (m_file.good() == false)
+                try
                 {
-                    msg << "cannot open " << source << ": " << strerror(errno);
+                    m_file = std::make_unique<platform::FileContents>(source);
+                }
+                catch (const std::system_error& e)
+                {
+                    msg << "cannot open " << source << ": " << e.code().message();
                     throw ConfigurationException(msg.str());
                 }
+                m_ptr = m_file->data().data();
+                m_end = m_ptr + m_file->data().size();
             }
             break;
             case Configuration::SourceType::String:
                 m_ptr = m_source;
+                m_end = m_ptr + strlen(m_ptr);
                 break;
             case Configuration::SourceType::Exec:
             {
                 const auto output = platform::execCmd(source);
                 m_execOutput = output;
                 m_ptr = m_execOutput.str().c_str();
+                m_end = m_ptr + strlen(m_ptr);
             }
             break;
             default:
@@ -149,13 +345,8 @@ namespace danek
     {
         StringBuffer msg;
 
-        // Initialize state for the multi-byte functions in the C library.
-        memset(&m_mbtowcState, 0, sizeof(mbstate_t));
-
-        m_keywordInfoArray = nullptr;
-        m_keywordInfoArraySize = 0;
-        m_funcInfoArray = nullptr;
-        m_funcInfoArraySize = 0;
+        m_keywords = nullptr;
+        m_funcs = nullptr;
 
         m_uidIdentifierProcessor = new UidIdentifierDummyProcessor();
         m_amOwnerOfUidIdentifierProcessor = true;
@@ -163,6 +354,7 @@ namespace danek
         m_source = str;
         m_lineNum = 1;
         m_ptr = m_source;
+        m_end = m_ptr + strlen(m_ptr);
         m_atEOF = false;
         nextChar(); // initialize m_ch
     }
@@ -176,114 +368,94 @@ namespace danek
     }
 
     //----------------------------------------------------------------------
-    // Function:	nextByte()
+    // Function:	nextChar()
     //
-    // Description:	Read the next byte from the input source
+    // Description:	Read the next char from the input source. The input
+    //		is decoded as UTF-8 regardless of the C locale; ASCII
+    //		characters take a single comparison. Carriage returns
+    //		are skipped.
     //----------------------------------------------------------------------
 
-    char LexBase::nextByte()
+    void LexBase::nextChar()
     {
-        int ch;
+        while (m_ptr != m_end && *m_ptr == '\r')
+        {
+            ++m_ptr;
+        }
 
-        if (m_sourceType == Configuration::SourceType::File)
+        m_atEOF = (m_ptr == m_end);
+        if (m_atEOF)
         {
-            do
-            {
-                ch = m_file.get();
-            } while (ch == '\r');
+            m_ch.reset();
+            return;
         }
-        else
+
+        const auto byte = static_cast<unsigned char>(*m_ptr);
+
+        if (byte < 0x80)
         {
-            do
+            m_ch.assign(m_ptr, 1, byte);
+            ++m_ptr;
+
+            if (byte == '\n')
             {
-                ch = *m_ptr;
-                if (ch == '\0')
-                {
-                    ch = EOF;
-                }
-                else
-                {
-                    m_ptr++;
-                }
-            } while (ch == '\r');
+                m_lineNum++;
+            }
+            return;
         }
-        m_atEOF = (ch == EOF);
-        if (m_atEOF)
+
+        const char* start = m_ptr;
+        char32_t codePoint;
+
+        if (utf8::decode(m_ptr, m_end, codePoint) == false)
         {
-            ch = 0;
+            StringBuffer msg;
+            msg << "Invalid multi-byte character on line " << m_lineNum;
+            throw ConfigurationException(msg.str());
         }
-        return static_cast<char>(ch);
+        m_ch.assign(start, static_cast<int>(m_ptr - start), codePoint);
     }
 
     //----------------------------------------------------------------------
-    // Function:	nextChar()
+    // Function:	skipWhiteSpace()
     //
-    // Description:	Read the next char from the input file
+    // Description:	Skip white space, starting with the lookahead char.
+    //		Runs of ASCII white space are skipped in bulk, counting
+    //		the newlines among them; anything else, including the
+    //		Unicode spaces, goes through nextChar().
     //----------------------------------------------------------------------
 
-    void LexBase::nextChar()
+    void LexBase::skipWhiteSpace()
     {
-        m_ch.reset();
-        int status = -1;
-        while (status == -1)
+        while (classOf(m_ch, m_atEOF) == CharClass::Space)
         {
-            wchar_t wChar;
-            char ch = nextByte();
-            if (m_atEOF && !m_ch.isEmpty())
-            {
-                StringBuffer msg;
-                msg << "Invalid multi-byte character on line " << m_lineNum;
-                throw ConfigurationException(msg.str());
-            }
-            if (m_atEOF)
-            {
-                //--------
-                // At EOF. Our work is done.
-                //--------
-                break;
-            }
-            if (!m_ch.add(ch))
-            {
-                StringBuffer msg;
-                msg << "Invalid multi-byte character on line " << m_lineNum;
-                throw ConfigurationException(msg.str());
-            }
+            const char* stop = lex::skipSpace(m_ptr, m_end);
 
-            status = mbrtowc(&wChar, m_ch.c_str(), m_ch.length(), &m_mbtowcState);
-            if (status == -1 && m_ch.isFull())
+            if (stop != m_ptr)
             {
-                StringBuffer msg;
-                msg << "Invalid multi-byte character on line " << m_lineNum;
-                throw ConfigurationException(msg.str());
+                m_lineNum += lex::countNewlines(m_ptr, stop);
+                m_ptr = stop;
             }
-            m_ch.setWChar(wChar);
-        }
-
-        if (m_ch == '\n')
-        {
-            m_lineNum++;
+            nextChar();
         }
     }
 
     //----------------------------------------------------------------------
     // Function:	nextToken()
     //
-    // Description:	Analyse the next token from the input file
+    // Description:	Analyse the next token from the input file. The
+    //		DFA consumes chars until it has no transition on the
+    //		lookahead char; in states with a transition to
+    //		themselves it first moves over the raw bytes which stay
+    //		in that state in one go.
     //----------------------------------------------------------------------
 
     void LexBase::nextToken(LexToken& token)
     {
-        StringBuffer spelling;
-        bool found;
-        short symbol;
-
         //--------
         // Skip leading white space
         //--------
-        while (m_ch.isSpace())
-        {
-            nextChar();
-        }
+        skipWhiteSpace();
 
         //--------
         // Check for EOF.
@@ -292,11 +464,11 @@ namespace danek
         {
             if (m_sourceType == Configuration::SourceType::String)
             {
-                token.reset(lex::LEX_EOF_SYM, m_lineNum, "<end of string>");
+                token.resetView(lex::LEX_EOF_SYM, m_lineNum, "<end of string>");
             }
             else
             {
-                token.reset(lex::LEX_EOF_SYM, m_lineNum, "<end of file>");
+                token.resetView(lex::LEX_EOF_SYM, m_lineNum, "<end of file>");
             }
             return;
         }
@@ -307,152 +479,137 @@ namespace danek
         const int lineNum = m_lineNum;
 
         //--------
-        // Miscellaneous kinds of tokens.
+        // The token's chars start with the lookahead char. They are
+        // contiguous in the source unless nextChar() skipped carriage
+        // returns among them, in which case a copy without them is
+        // made.
         //--------
-        switch (m_ch.c_str()[0])
+        const char* begin = lookaheadPos();
+        std::size_t length = 0;
+
+        State state = State::Start;
+        for (;;)
         {
-            case '?':
-                nextChar();
-                if (m_ch == '=')
-                {
-                    nextChar();
-                    token.reset(lex::LEX_QUESTION_EQUALS_SYM, lineNum, "?=");
-                }
-                else
-                {
-                    token.reset(lex::LEX_UNKNOWN_SYM, lineNum, spelling.str().c_str());
-                }
-                return;
-            case '!':
-                nextChar();
-                if (m_ch == '=')
-                {
-                    nextChar();
-                    token.reset(lex::LEX_NOT_EQUALS_SYM, lineNum, "!=");
-                }
-                else
+            const State next = transitions[index(state)][index(classOf(m_ch, m_atEOF))];
+
+            if (next == State::Stop)
+            {
+                break;
+            }
+            state = next;
+            length += static_cast<std::size_t>(m_ch.length());
+
+            if (loops(state) == true)
+            {
+                const auto& row = transitions[index(state)];
+                const char* run = m_ptr;
+
+                while (run != m_end && row[index(byteClasses[static_cast<unsigned char>(*run)])] == state)
                 {
-                    token.reset(lex::LEX_NOT_SYM, lineNum, "!");
+                    ++run;
                 }
+                length += static_cast<std::size_t>(run - m_ptr);
+                m_ptr = run;
+            }
+            nextChar();
+        }
+
+        std::string copy;
+        std::string_view spelling{begin, length};
+
+        if (memchr(begin, '\r', length) != nullptr)
+        {
+            copy = withoutCarriageReturns(begin, lookaheadPos());
+            spelling = copy;
+        }
+        const auto setToken = [&](short symbol, FunctionType funcType) {
+            if (spelling.data() == begin)
+            {
+                token.resetView(symbol, lineNum, spelling, funcType);
+            }
+            else
+            {
+                token.reset(symbol, lineNum, std::move(copy), funcType);
+            }
+        };
+
+        const Accept accept = accepts[index(state)];
+
+        switch (accept.action)
+        {
+            case Action::Token:
+                setToken(accept.symbol, FunctionType::None);
                 return;
-            case '@':
-                spelling.append(m_ch.c_str());
-                nextChar();
-                while (!m_atEOF && isKeywordChar(m_ch))
-                {
-                    spelling.append(m_ch.c_str());
-                    nextChar();
-                }
-                searchForKeyword(spelling.str().c_str(), found, symbol);
-                if (found)
-                {
-                    token.reset(symbol, lineNum, spelling.str().c_str());
-                }
-                else
-                {
-                    token.reset(lex::LEX_UNKNOWN_SYM, lineNum, spelling.str().c_str());
-                }
+            case Action::Incomplete:
+                token.reset(accept.symbol, lineNum, std::string{spelling}.append(m_ch.c_str()));
                 return;
-            case '+':
-                nextChar();
-                token.reset(lex::LEX_PLUS_SYM, lineNum, "+");
+            case Action::Keyword:
+            {
+                const KeywordInfo* keyword = (m_keywords != nullptr) ? m_keywords->find(spelling) : nullptr;
+                setToken((keyword != nullptr) ? keyword->m_symbol : accept.symbol, FunctionType::None);
                 return;
-            case '&':
-                nextChar();
-                if (m_ch == '&')
+            }
+            case Action::Function:
+            {
+                const FuncInfo* func = (m_funcs != nullptr) ? m_funcs->find(spelling) : nullptr;
+
+                if (func != nullptr)
                 {
-                    nextChar();
-                    token.reset(lex::LEX_AND_SYM, lineNum, "&&");
+                    setToken(func->m_symbol, func->m_funcType);
                 }
                 else
                 {
-                    spelling << '&' << m_ch.c_str();
-                    token.reset(lex::LEX_UNKNOWN_SYM, lineNum, spelling.str().c_str());
+                    setToken(accept.symbol, FunctionType::None);
                 }
                 return;
-            case '|':
-                nextChar();
-                if (m_ch == '|')
+            }
+            case Action::Identifier:
+                //--------
+                // Better check it's a legal identifier.
+                //--------
+                if (spelling == ".")
                 {
-                    nextChar();
-                    token.reset(lex::LEX_OR_SYM, lineNum, "||");
+                    setToken(lex::LEX_SOLE_DOT_IDENT_SYM, FunctionType::None);
                 }
-                else
+                else if (spelling.find("..") != std::string_view::npos)
                 {
-                    spelling << '|' << m_ch.c_str();
-                    token.reset(lex::LEX_UNKNOWN_SYM, lineNum, spelling.str().c_str());
+                    setToken(lex::LEX_TWO_DOTS_IDENT_SYM, FunctionType::None);
                 }
-                return;
-            case '=':
-                nextChar();
-                if (m_ch == '=')
+                else if (m_uidIdentifierProcessor->needsExpanding(spelling) == true)
                 {
-                    nextChar();
-                    token.reset(lex::LEX_EQUALS_EQUALS_SYM, lineNum, "==");
+                    try
+                    {
+                        token.reset(accept.symbol, lineNum, m_uidIdentifierProcessor->expand(std::string{spelling}));
+                    }
+                    catch (const ConfigurationException&)
+                    {
+                        setToken(lex::LEX_ILLEGAL_IDENT_SYM, FunctionType::None);
+                    }
                 }
                 else
                 {
-                    token.reset(lex::LEX_EQUALS_SYM, lineNum, "=");
+                    setToken(accept.symbol, FunctionType::None);
                 }
                 return;
-            case ';':
-                nextChar();
-                token.reset(lex::LEX_SEMICOLON_SYM, lineNum, ";");
-                return;
-            case '[':
-                nextChar();
-                token.reset(lex::LEX_OPEN_BRACKET_SYM, lineNum, "[");
-                return;
-            case ']':
-                nextChar();
-                token.reset(lex::LEX_CLOSE_BRACKET_SYM, lineNum, "]");
-                return;
-            case '{':
-                nextChar();
-                token.reset(lex::LEX_OPEN_BRACE_SYM, lineNum, "{");
-                return;
-            case '}':
-                nextChar();
-                token.reset(lex::LEX_CLOSE_BRACE_SYM, lineNum, "}");
-                return;
-            case '(':
-                nextChar();
-                token.reset(lex::LEX_OPEN_PAREN_SYM, lineNum, "(");
-                return;
-            case ')':
-                nextChar();
-                token.reset(lex::LEX_CLOSE_PAREN_SYM, lineNum, ")");
-                return;
-            case ',':
-                nextChar();
-                token.reset(lex::LEX_COMMA_SYM, lineNum, ",");
-                return;
-            case '"':
+            case Action::String:
                 consumeString(token);
                 return;
-                ;
-            case '<':
-                nextChar();
-                if (m_ch != '%')
-                {
-                    token.reset(lex::LEX_UNKNOWN_SYM, lineNum, "<");
-                    return;
-                }
-                nextChar(); // skip over '%'
+            case Action::BlockString:
                 consumeBlockString(token);
                 return;
-            case '#':
+            case Action::Comment:
                 //--------
                 // A comment. Consume it and immediately following
                 // comments (without resorting to recursion).
                 //--------
-                while (m_ch == '#')
+                for (;;)
                 {
                     //--------
                     // Skip to the end of line
                     //--------
                     while (!m_atEOF && m_ch != '\n')
                     {
+                        m_ptr = lex::findLineEnd(m_ptr, m_end);
                         nextChar();
                     }
                     if (m_ch == '\n')
@@ -462,14 +619,16 @@ namespace danek
                     //--------
                     // Skip leading white space on the next line
                     //--------
-                    while (m_ch.isSpace())
+                    skipWhiteSpace();
+                    if (m_ch != '#')
                     {
-                        nextChar();
+                        break;
                     }
                     //--------
-                    // Potentially loop around again to consume
-                    // more comment lines that follow immediately.
+                    // Loop around again to consume more comment lines
+                    // that follow immediately.
                     //--------
+                    nextChar();
                 }
                 //--------
                 // Now use (a guaranteed single level of) recursion
@@ -478,156 +637,95 @@ namespace danek
                 nextToken(token);
                 return;
         }
-
-        //--------
-        // Is it a function or identifier?
-        //--------
-        if (isIdentifierChar(m_ch))
-        {
-            //--------
-            // Consume all the identifier characters
-            // but not an immediately following "(", if any
-            //--------
-            spelling.append(m_ch.c_str());
-            nextChar();
-            while (!m_atEOF && isIdentifierChar(m_ch))
-            {
-                spelling.append(m_ch.c_str());
-                nextChar();
-            }
-
-            //--------
-            // If "(" follows immediately then it is (supposed to be)
-            // a function.
-            //--------
-            if (m_ch == '(')
-            {
-                FunctionType funcType;
-                spelling.append(m_ch.c_str());
-                nextChar();
-                searchForFunction(spelling.str().c_str(), found, funcType, symbol);
-                if (found)
-                {
-                    token.reset(symbol, lineNum, spelling.str().c_str(), funcType);
-                }
-                else
-                {
-                    token.reset(lex::LEX_UNKNOWN_FUNC_SYM, lineNum, spelling.str().c_str());
-                }
-                return;
-            }
-
-            //--------
-            // It's not a function so it looks like an identifier.
-            // Better check it's a legal identifier.
-            //--------
-            if (strcmp(spelling.str().c_str(), ".") == 0)
-            {
-                token.reset(lex::LEX_SOLE_DOT_IDENT_SYM, lineNum, spelling.str().c_str());
-            }
-            else if (strstr(spelling.str().c_str(), "..") != nullptr)
-            {
-                token.reset(lex::LEX_TWO_DOTS_IDENT_SYM, lineNum, spelling.str().c_str());
-            }
-            else
-            {
-                try
-                {
-                    spelling = m_uidIdentifierProcessor->expand(spelling.str());
-                    token.reset(lex::LEX_IDENT_SYM, lineNum, spelling.str());
-                }
-                catch (const ConfigurationException&)
-                {
-                    token.reset(lex::LEX_ILLEGAL_IDENT_SYM, lineNum, spelling.str());
-                }
-            }
-            return;
-        }
-
-        //--------
-        // None of the above
-        //--------
-        spelling << m_ch.c_str();
-        nextChar();
-        token.reset(lex::LEX_UNKNOWN_SYM, lineNum, spelling.str());
     }
 
     //----------------------------------------------------------------------
     // Function:	consumeBlockString()
     //
     // Description:	Consume a string from the input file and return the
-    //		relevant token.
+    //		relevant token. Its spelling refers to the source.
     //----------------------------------------------------------------------
 
     void LexBase::consumeBlockString(LexToken& token)
     {
-        StringBuffer spelling;
-        MBChar prevCh;
-        int lineNum;
-
         //--------
         // Note the line number at the start of the string
         //--------
-        lineNum = m_lineNum;
+        const int lineNum = m_lineNum;
+        const char* begin = lookaheadPos();
+        const char* percent = nullptr;
 
         //--------
         // Consume chars until we get to "%>"
         //--------
-        prevCh = ' ';
-        while (!(prevCh == '%' && m_ch == '>'))
+        while (!(percent != nullptr && m_ch == '>'))
         {
             if (m_atEOF)
             {
-                token.reset(lex::LEX_BLOCK_STRING_WITH_EOF_SYM, lineNum, spelling.str().c_str());
+                resetFromSource(token, lex::LEX_BLOCK_STRING_WITH_EOF_SYM, lineNum, begin, m_end);
                 return;
             }
-            spelling << m_ch.c_str();
-            prevCh = m_ch;
+            if (m_ch == '%')
+            {
+                percent = lookaheadPos();
+            }
+            else
+            {
+                //--------
+                // Skip the run up to the next '%' in one go.
+                //--------
+                const char* stop = lex::findBlockStringSpecial(m_ptr, m_end);
+                m_lineNum += lex::countNewlines(m_ptr, stop);
+                m_ptr = stop;
+                percent = nullptr;
+            }
             nextChar();
         }
 
         //--------
-        // Spelling contains the string followed by '%'.
-        // Remove that unwanted terminating character.
-        //--------
-        spelling.deleteLastChar();
-        nextChar(); // consumer the '>'
-
-        //--------
-        // At the end of the string.
+        // At the end of the string, which is followed by "%>".
         //--------
-        token.reset(lex::LEX_STRING_SYM, lineNum, spelling.str());
-        return;
+        resetFromSource(token, lex::LEX_STRING_SYM, lineNum, begin, percent);
+        nextChar(); // consume the '>'
     }
 
     //----------------------------------------------------------------------
     // Function:	consumeString()
     //
     // Description:	Consume a string from the input file and return the
-    //		relevant token.
+    //		relevant token. The opening double quote has been
+    //		consumed already. The spelling refers to the source
+    //		until an escape sequence is met; from there on it is
+    //		built up as a copy.
     //----------------------------------------------------------------------
 
     void LexBase::consumeString(LexToken& token)
     {
-        StringBuffer spelling;
+        std::string spelling;
+        bool isCopy = false;
         StringBuffer msg;
 
-        compat::checkAssertion(m_ch == '"');
-
         //--------
         // Note the line number at the start of the string
         //--------
         const int lineNum = m_lineNum;
+        const char* begin = lookaheadPos();
 
         //--------
         // Consume chars until we get to the end of the sting
         //--------
-        nextChar();
         while (m_ch != '"')
         {
             if (m_atEOF || m_ch.c_str()[0] == '\n')
             {
-                token.reset(lex::LEX_STRING_WITH_EOL_SYM, lineNum, spelling.str().c_str());
+                if (isCopy == true)
+                {
+                    token.reset(lex::LEX_STRING_WITH_EOL_SYM, lineNum, std::move(spelling));
+                }
+                else
+                {
+                    resetFromSource(token, lex::LEX_STRING_WITH_EOL_SYM, lineNum, begin, lookaheadPos());
+                }
                 return;
             }
             switch (m_ch.c_str()[0])
@@ -636,25 +734,30 @@ namespace danek
                     //--------
                     // Escape char in string
                     //--------
+                    if (isCopy == false)
+                    {
+                        spelling = withoutCarriageReturns(begin, lookaheadPos());
+                        isCopy = true;
+                    }
                     nextChar();
                     if (m_atEOF || m_ch.c_str()[0] == '\n')
                     {
-                        token.reset(lex::LEX_STRING_WITH_EOL_SYM, lineNum, spelling.str().c_str());
+                        token.reset(lex::LEX_STRING_WITH_EOL_SYM, lineNum, std::move(spelling));
                         return;
                     }
                     switch (m_ch.c_str()[0])
                     {
                         case 't':
-                            spelling << '\t';
+                            spelling += '\t';
                             break;
                         case 'n':
-                            spelling << '\n';
+                            spelling += '\n';
                             break;
                         case '%':
-                            spelling << '%';
+                            spelling += '%';
                             break;
                         case '"':
-                            spelling << '"';
+                            spelling += '"';
                             break;
                         default:
                             msg << "Invalid escape sequence (%" << m_ch.c_str()[0] << ") in string on line " << m_lineNum;
@@ -662,70 +765,73 @@ namespace danek
                     }
                     break;
                 default:
+                {
                     //--------
-                    // Typical char in string
+                    // Typical char in string, and the run of typical
+                    // chars following it
                     //--------
-                    spelling << m_ch.c_str();
+                    const char* stop = lex::findStringSpecial(m_ptr, m_end);
+
+                    if (isCopy == true)
+                    {
+                        spelling.append(m_ch.c_str());
+                        spelling.append(m_ptr, stop);
+                    }
+                    m_ptr = stop;
                     break;
+                }
             }
             nextChar();
         }
-        nextChar(); // consume the terminating double-quote char
 
         //--------
         // At the end of the string.
         //--------
-        token.reset(lex::LEX_STRING_SYM, lineNum, spelling.str());
-        return;
+        if (isCopy == true)
+        {
+            token.reset(lex::LEX_STRING_SYM, lineNum, std::move(spelling));
+        }
+        else
+        {
+            resetFromSource(token, lex::LEX_STRING_SYM, lineNum, begin, lookaheadPos());
+        }
+        nextChar(); // consume the terminating double-quote char
     }
 
     //----------------------------------------------------------------------
-    // Function:	isKeywordChar()
+    // Function:	resetFromSource()
     //
-    // Description:	Determine if the parameter is a char that can appear
-    //		in a keyword (after the initial "@").
+    // Description:	Reset the token with the chars of the source in
+    //		[begin, end). The token refers to the source unless
+    //		carriage returns have to be dropped.
     //----------------------------------------------------------------------
 
-    bool LexBase::isKeywordChar(const MBChar& mbCh)
+    void LexBase::resetFromSource(LexToken& token, short type, int lineNum, const char* begin, const char* end)
     {
-        wchar_t wCh;
+        const auto length = static_cast<std::size_t>(end - begin);
 
-        wCh = mbCh.getWChar();
-        if ('A' <= wCh && wCh <= 'Z')
+        if (memchr(begin, '\r', length) == nullptr)
         {
-            return true;
+            token.resetView(type, lineNum, std::string_view{begin, length});
         }
-        if ('a' <= wCh && wCh <= 'z')
+        else
         {
-            return true;
+            token.reset(type, lineNum, withoutCarriageReturns(begin, end));
         }
-        return false;
     }
 
-    //----------------------------------------------------------------------
-    // Function:	isIdentifierChar()
-    //
-    // Description:	Determine if the parameter is a char that can appear
-    //		in an identifier.
-    //----------------------------------------------------------------------
-
-    bool LexBase::isIdentifierChar(const MBChar& mbCh)
+    std::string LexBase::withoutCarriageReturns(const char* begin, const char* end)
     {
-        wchar_t wCh;
-        bool result;
-
-        wCh = mbCh.getWChar();
-        result = (::iswalpha(wCh) != 0)    // letter
-                 || (::iswdigit(wCh) != 0) // digit
-                 || mbCh == '-'            // dash
-                 || mbCh == '_'            // underscore
-                 || mbCh == '.'            // dot
-                 || mbCh == ':'            // For C++ nested names, e.g., Foo::Bar
-                 || mbCh == '$'            // For mangled names of Java nested classes
-                 || mbCh == '?'            // For Ruby identifiers, e.g., found?
-                 || mbCh == '/'            // For URLs, e.g., http://foo.com/bar/
-                 || mbCh == '\\'           // For Windows directory names
-            ;
-        return result;
+        std::string str;
+        str.reserve(static_cast<std::size_t>(end - begin));
+
+        for (const char* ptr = begin; ptr != end; ++ptr)
+        {
+            if (*ptr != '\r')
+            {
+                str += *ptr;
+            }
+        }
+        return str;
     }
 }
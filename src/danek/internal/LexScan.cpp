@@ -0,0 +1,243 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/internal/LexScan.h"
+#include <bit>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace danek::lex
+{
+    namespace
+    {
+        //--------
+        // A thin layer over the widest vector type available at compile
+        // time; AVX2 implies SSE2, so "#if defined(__SSE2__)" guards
+        // every use. mask() has one bit per byte, set if the byte's high bit
+        // is set, and inverseMask() the complement of that; comparisons set
+        // all bits of a matching byte.
+        //--------
+#if defined(__AVX2__)
+        using Block = __m256i;
+        constexpr std::ptrdiff_t blockSize = 32;
+
+        inline Block load(const char* ptr)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+
+        inline Block equals(Block block, char ch)
+        {
+            return _mm256_cmpeq_epi8(block, _mm256_set1_epi8(ch));
+        }
+
+        inline Block greater(Block block, char ch)
+        {
+            return _mm256_cmpgt_epi8(block, _mm256_set1_epi8(ch));
+        }
+
+        inline Block less(Block block, char ch)
+        {
+            return _mm256_cmpgt_epi8(_mm256_set1_epi8(ch), block);
+        }
+
+        inline Block either(Block a, Block b)
+        {
+            return _mm256_or_si256(a, b);
+        }
+
+        inline Block both(Block a, Block b)
+        {
+            return _mm256_and_si256(a, b);
+        }
+
+        inline std::uint32_t mask(Block block)
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(block));
+        }
+
+        inline std::uint32_t inverseMask(Block block)
+        {
+            return ~mask(block);
+        }
+#elif defined(__SSE2__)
+        using Block = __m128i;
+        constexpr std::ptrdiff_t blockSize = 16;
+
+        inline Block load(const char* ptr)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        }
+
+        inline Block equals(Block block, char ch)
+        {
+            return _mm_cmpeq_epi8(block, _mm_set1_epi8(ch));
+        }
+
+        inline Block greater(Block block, char ch)
+        {
+            return _mm_cmpgt_epi8(block, _mm_set1_epi8(ch));
+        }
+
+        inline Block less(Block block, char ch)
+        {
+            return _mm_cmplt_epi8(block, _mm_set1_epi8(ch));
+        }
+
+        inline Block either(Block a, Block b)
+        {
+            return _mm_or_si128(a, b);
+        }
+
+        inline Block both(Block a, Block b)
+        {
+            return _mm_and_si128(a, b);
+        }
+
+        inline std::uint32_t mask(Block block)
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(block));
+        }
+
+        inline std::uint32_t inverseMask(Block block)
+        {
+            return ~mask(block) & 0xFFFF;
+        }
+#endif
+
+        constexpr bool isAsciiSpace(unsigned char byte)
+        {
+            return byte == ' ' || (byte >= '\t' && byte <= '\r');
+        }
+
+        constexpr bool isAscii(unsigned char byte)
+        {
+            return byte < 0x80;
+        }
+
+        //--------
+        // Returns the first byte in [ptr, end) for which blockBits() has
+        // its bit set, or isStop() is true in the scalar tail.
+        //--------
+        template <typename BlockBits, typename IsStop>
+        const char* findFirst(const char* ptr, const char* end, [[maybe_unused]] BlockBits blockBits, IsStop isStop)
+        {
+#if defined(__SSE2__)
+            while (end - ptr >= blockSize)
+            {
+                const std::uint32_t bits = blockBits(load(ptr));
+
+                if (bits != 0)
+                {
+                    return ptr + std::countr_zero(bits);
+                }
+                ptr += blockSize;
+            }
+#endif
+
+            while (ptr != end && isStop(static_cast<unsigned char>(*ptr)) == false)
+            {
+                ++ptr;
+            }
+            return ptr;
+        }
+    }
+
+
+    //----------------------------------------------------------------------
+    // Function:	skipSpace()
+    //
+    // Description:	A byte is white space if it is ' ' or in the range
+    //		'\t'..'\r'. The signed comparisons treat non-ASCII
+    //		bytes as negative, so they are never white space.
+    //----------------------------------------------------------------------
+
+    const char* skipSpace(const char* begin, const char* end)
+    {
+        return findFirst(
+            begin, end,
+            [](auto block) {
+                const auto space = either(equals(block, ' '), both(greater(block, '\t' - 1), less(block, '\r' + 1)));
+                return inverseMask(space);
+            },
+            [](unsigned char byte) { return isAsciiSpace(byte) == false; });
+    }
+
+    const char* findLineEnd(const char* begin, const char* end)
+    {
+        return findFirst(
+            begin, end, [](auto block) { return mask(either(block, equals(block, '\n'))); },
+            [](unsigned char byte) { return byte == '\n' || isAscii(byte) == false; });
+    }
+
+    const char* findStringSpecial(const char* begin, const char* end)
+    {
+        return findFirst(
+            begin, end,
+            [](auto block) {
+                const auto special = either(either(equals(block, '"'), equals(block, '%')), either(equals(block, '\n'), equals(block, '\r')));
+                return mask(either(block, special));
+            },
+            [](unsigned char byte) { return byte == '"' || byte == '%' || byte == '\n' || byte == '\r' || isAscii(byte) == false; });
+    }
+
+    const char* findBlockStringSpecial(const char* begin, const char* end)
+    {
+        return findFirst(
+            begin, end, [](auto block) { return mask(either(block, either(equals(block, '%'), equals(block, '\r')))); },
+            [](unsigned char byte) { return byte == '%' || byte == '\r' || isAscii(byte) == false; });
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	countNewlines()
+    //
+    // Description:	Counts a block of newlines with a single popcount.
+    //----------------------------------------------------------------------
+
+    int countNewlines(const char* begin, const char* end)
+    {
+        const char* ptr = begin;
+        int count = 0;
+
+#if defined(__SSE2__)
+        while (end - ptr >= blockSize)
+        {
+            count += std::popcount(mask(equals(load(ptr), '\n')));
+            ptr += blockSize;
+        }
+#endif
+
+        for (; ptr != end; ++ptr)
+        {
+            if (*ptr == '\n')
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+}
@@ -23,6 +23,7 @@
 
 #include "danek/internal/LexToken.h"
 #include "danek/internal/LexBaseSymbols.h"
+#include <utility>
 
 namespace danek
 {
@@ -32,26 +33,50 @@ namespace danek
     }
 
     LexToken::LexToken(short type, std::int32_t lineNum, const std::string& spelling)
-        : m_type(type), m_spelling(spelling), m_lineNum(lineNum), m_funcType(FunctionType::None)
+        : m_type(type), m_isOwned(true), m_viewedSpelling(), m_ownedSpelling(spelling), m_lineNum(lineNum),
+          m_funcType(FunctionType::None)
     {
     }
 
-    void LexToken::reset(short type, std::int32_t lineNum, const std::string& spelling)
+    void LexToken::reset(short type, std::int32_t lineNum, std::string spelling)
     {
-        reset(type, lineNum, spelling, FunctionType::None);
+        reset(type, lineNum, std::move(spelling), FunctionType::None);
     }
 
-    void LexToken::reset(short type, std::int32_t lineNum, const std::string& spelling, FunctionType funcType)
+    void LexToken::reset(short type, std::int32_t lineNum, std::string spelling, FunctionType funcType)
     {
         m_type = type;
         m_lineNum = lineNum;
-        m_spelling = spelling;
+        m_isOwned = true;
+        m_ownedSpelling = std::move(spelling);
         m_funcType = funcType;
     }
 
-    const std::string& LexToken::spelling() const
+    void LexToken::resetView(short type, std::int32_t lineNum, std::string_view spelling)
     {
-        return m_spelling;
+        resetView(type, lineNum, spelling, FunctionType::None);
+    }
+
+    void LexToken::resetView(short type, std::int32_t lineNum, std::string_view spelling, FunctionType funcType)
+    {
+        m_type = type;
+        m_lineNum = lineNum;
+        m_isOwned = false;
+        m_viewedSpelling = spelling;
+        m_funcType = funcType;
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	spelling()
+    //
+    // Description:	A copy of the token (as the parser keeps of an
+    //		identifier) shares a viewed spelling and gets its own
+    //		copy of an owned one, so both stay valid.
+    //----------------------------------------------------------------------
+
+    std::string_view LexToken::spelling() const
+    {
+        return (m_isOwned == true) ? std::string_view{m_ownedSpelling} : m_viewedSpelling;
     }
 
     std::int32_t LexToken::lineNum() const
@@ -22,9 +22,6 @@
 // SOFTWARE.
 
 #include "danek/internal/MBChar.h"
-#include <ctype.h>
-#include <wchar.h>
-#include <wctype.h>
 
 namespace danek
 {
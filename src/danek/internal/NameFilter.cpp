@@ -0,0 +1,84 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/internal/NameFilter.h"
+#include "danek/internal/ConfigItem.h"
+#include "danek/internal/ConfigScope.h"
+#include <algorithm>
+#include <bit>
+
+namespace danek
+{
+    namespace
+    {
+        // Sixteen bits per name, four of which are set, keep false positives
+        // at a few percent even though the bits of a name share a word
+        constexpr std::size_t bitsPerName{16};
+        constexpr std::size_t bitsPerWord{64};
+        constexpr unsigned bitsSetPerName{4};
+    }
+
+
+    NameFilter::NameFilter(const ConfigScope& root, std::pmr::memory_resource* resource)
+        : m_words(resource), m_size(0)
+    {
+        std::vector<std::uint64_t> hashes;
+        std::string name;
+        root.forEachItem(ConfType::ScopesAndVars, true, name,
+                         [&hashes](std::string_view scopedName, const ConfigItem&) { hashes.push_back(util::hashName(scopedName)); });
+
+        m_size = hashes.size();
+        m_words.assign(std::bit_ceil(std::max<std::size_t>(1, (m_size * bitsPerName) / bitsPerWord)), 0);
+
+        for (const auto hash : hashes)
+        {
+            m_words[hash & (m_words.size() - 1)] |= bitsOf(hash);
+        }
+    }
+
+    bool NameFilter::mayContain(std::uint64_t hash) const
+    {
+        const auto bits = bitsOf(hash);
+        return (m_words[hash & (m_words.size() - 1)] & bits) == bits;
+    }
+
+    std::size_t NameFilter::size() const
+    {
+        return m_size;
+    }
+
+    //--------
+    // The low bits of the hash select the word, the high bits the bits
+    // within it.
+    //--------
+    std::uint64_t NameFilter::bitsOf(std::uint64_t hash)
+    {
+        std::uint64_t bits{0};
+
+        for (unsigned i = 0; i < bitsSetPerName; ++i)
+        {
+            bits |= std::uint64_t{1} << ((hash >> (40 + 6 * i)) & (bitsPerWord - 1));
+        }
+        return bits;
+    }
+}
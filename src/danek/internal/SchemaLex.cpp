@@ -25,8 +25,7 @@
 
 namespace danek
 {
-    // This array must be kept sorted becaue we do a binary search on it.
-    static LexBase::KeywordInfo keywordInfoArray[] = {
+    static constexpr LexBase::KeywordInfo keywordInfoArray[] = {
         //----------------------------------------------------------------------
         // spelling               symbol
         //----------------------------------------------------------------------
@@ -38,12 +37,11 @@ namespace danek
         {"@typedef", SchemaLex::LEX_TYPEDEF_SYM},
     };
 
-    const static int keywordInfoArraySize = sizeof(keywordInfoArray) / sizeof(keywordInfoArray[0]);
+    static constexpr lex::PerfectHash<LexBase::KeywordInfo> keywords{keywordInfoArray};
 
     SchemaLex::SchemaLex(const char* str)
         : LexBase(str)
     {
-        m_keywordInfoArray = keywordInfoArray;
-        m_keywordInfoArraySize = keywordInfoArraySize;
+        m_keywords = &keywords;
     }
 }
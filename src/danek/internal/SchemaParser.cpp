@@ -156,7 +156,7 @@ namespace danek
         }
 
         ruleInfo->setIsOptional(isOptional);
-        ruleInfo->setLocallyScopedName(m_token.spelling());
+        ruleInfo->setLocallyScopedName(std::string{m_token.spelling()});
         accept(lex::LEX_IDENT_SYM, rule, "expecting an identifier");
 
         //--------
@@ -184,7 +184,7 @@ namespace danek
 
         accept(lex::LEX_EQUALS_SYM, rule, "expecting '='");
 
-        ruleInfo->setTypeName(m_token.spelling());
+        ruleInfo->setTypeName(std::string{m_token.spelling()});
         accept(lex::LEX_IDENT_SYM, rule, "expecting an identifier");
 
         typeDef = m_sv->findType(ruleInfo->typeName().c_str());
@@ -203,7 +203,7 @@ namespace danek
         accept(lex::LEX_OPEN_BRACKET_SYM, rule, "expecting '['");
         if (m_token.type() == lex::LEX_IDENT_SYM || m_token.type() == lex::LEX_STRING_SYM)
         {
-            ruleInfo->addArg(m_token.spelling());
+            ruleInfo->addArg(std::string{m_token.spelling()});
             m_lex->nextToken(m_token);
         }
         else if (m_token.type() != lex::LEX_CLOSE_BRACKET_SYM)
@@ -213,7 +213,7 @@ namespace danek
         while (m_token.type() != lex::LEX_CLOSE_BRACKET_SYM)
         {
             accept(lex::LEX_COMMA_SYM, rule, "expecting ','");
-            ruleInfo->addArg(m_token.spelling());
+            ruleInfo->addArg(std::string{m_token.spelling()});
             if (m_token.type() == lex::LEX_IDENT_SYM || m_token.type() == lex::LEX_STRING_SYM)
             {
                 m_lex->nextToken(m_token);
@@ -240,7 +240,7 @@ namespace danek
     {
         ruleInfo->setSymbol(m_token.type());
         m_lex->nextToken(m_token); // consume the "@ignore<something>" keyword
-        ruleInfo->setLocallyScopedName(m_token.spelling());
+        ruleInfo->setLocallyScopedName(std::string{m_token.spelling()});
         accept(lex::LEX_IDENT_SYM, rule, "expecting an identifier");
         accept(lex::LEX_EOF_SYM, rule, "expecting <end of string>");
     }
@@ -263,10 +263,10 @@ namespace danek
         StringVector baseTypeArgs;
 
         accept(SchemaLex::LEX_TYPEDEF_SYM, str, "expecting '@typedef'");
-        const auto typeName = m_token.spelling();
+        const std::string typeName{m_token.spelling()};
         accept(lex::LEX_IDENT_SYM, str, "expecting an identifier");
         accept(lex::LEX_EQUALS_SYM, str, "expecting '='");
-        const auto baseTypeName = m_token.spelling();
+        const std::string baseTypeName{m_token.spelling()};
         accept(lex::LEX_IDENT_SYM, str, "expecting an identifier");
 
         baseTypeDef = m_sv->findType(baseTypeName.c_str());
@@ -291,7 +291,7 @@ namespace danek
         accept(lex::LEX_OPEN_BRACKET_SYM, str, "expecting '['");
         if (m_token.type() == lex::LEX_IDENT_SYM || m_token.type() == lex::LEX_STRING_SYM)
         {
-            baseTypeArgs.push_back(m_token.spelling());
+            baseTypeArgs.push_back(std::string{m_token.spelling()});
             m_lex->nextToken(m_token);
         }
         else if (m_token.type() != lex::LEX_CLOSE_BRACKET_SYM)
@@ -301,7 +301,7 @@ namespace danek
         while (m_token.type() != lex::LEX_CLOSE_BRACKET_SYM)
         {
             accept(lex::LEX_COMMA_SYM, str, "expecting ','");
-            baseTypeArgs.push_back(m_token.spelling());
+            baseTypeArgs.push_back(std::string{m_token.spelling()});
             if (m_token.type() == lex::LEX_IDENT_SYM || m_token.type() == lex::LEX_STRING_SYM)
             {
                 m_lex->nextToken(m_token);
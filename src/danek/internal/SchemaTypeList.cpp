@@ -86,7 +86,6 @@ namespace danek
         StringBuffer fullyScopedName;
         StringBuffer errSuffix;
         StringVector emptyArgs;
-        std::vector<std::string> data;
 
         compat::checkAssertion(typeArgs.size() == 1);
         const char* elemTypeName = typeArgs[0].c_str();
@@ -94,10 +93,10 @@ namespace danek
         compat::checkAssertion(elemTypeDef != nullptr);
         compat::checkAssertion(elemTypeDef->cfgType() == ConfType::String);
 
-        cfg->lookupList(scope, name, data);
+        const ListView data = cfg->lookupListView(scope, name);
         for (std::size_t i = 0; i < data.size(); i++)
         {
-            const char* elemValue = data[i].c_str();
+            const char* elemValue = data.c_str(i);
             bool ok = callIsA(elemTypeDef, sv, cfg, elemValue, elemTypeName, emptyArgs, indentLevel + 1, errSuffix);
             if (!ok)
             {
@@ -94,8 +94,7 @@ namespace danek
         compat::checkAssertion(typeArgsSize != 0);
         compat::checkAssertion(typeArgsSize % 2 == 0);
         int numColumns = typeArgsSize / 2;
-        std::vector<std::string> data;
-        cfg->lookupList(scope, name, data);
+        const ListView data = cfg->lookupListView(scope, name);
         if (data.size() % numColumns != 0)
         {
             cfg->mergeNames(scope, name, fullyScopedName);
@@ -112,7 +111,7 @@ namespace danek
             int typeIndex = (i * 2 + 0) % typeArgsSize;
             int colNameIndex = (i * 2 + 1) % typeArgsSize;
             int rowNum = (i / numColumns) + 1;
-            const char* colValue = data[i].c_str();
+            const char* colValue = data.c_str(i);
             const char* colTypeName = typeArgs[typeIndex].c_str();
             SchemaType* colTypeDef = findType(sv, colTypeName);
             bool ok = callIsA(colTypeDef, sv, cfg, colValue, colTypeName, emptyArgs, indentLevel + 1, errSuffix);
@@ -93,8 +93,7 @@ namespace danek
         compat::checkAssertion(typeArgsSize != 0);
         compat::checkAssertion(typeArgsSize % 2 == 0);
         std::size_t numElems = typeArgsSize / 2;
-        std::vector<std::string> data;
-        cfg->lookupList(scope, name, data);
+        const ListView data = cfg->lookupListView(scope, name);
         if (data.size() != numElems)
         {
             cfg->mergeNames(scope, name, fullyScopedName);
@@ -117,7 +116,7 @@ namespace danek
         {
             int typeIndex = (i * 2 + 0) % typeArgsSize;
             int elemNameIndex = (i * 2 + 1) % typeArgsSize;
-            const char* elemValue = data[i].c_str();
+            const char* elemValue = data.c_str(i);
             const char* elemTypeName = typeArgs[typeIndex].c_str();
             SchemaType* elemTypeDef = findType(sv, elemTypeName);
             bool ok = callIsA(elemTypeDef, sv, cfg, elemValue, elemTypeName, emptyArgs, indentLevel + 1, errSuffix);
@@ -0,0 +1,85 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/internal/SymbolTable.h"
+#include "danek/internal/UidIdentifierProcessor.h"
+#include <stdexcept>
+
+namespace danek
+{
+    SymbolTable::SymbolTable(std::pmr::memory_resource* resource)
+        : m_names(resource), m_unexpanded(resource), m_unexpandedNames(resource), m_ids(resource)
+    {
+    }
+
+    SymbolId SymbolTable::intern(std::string_view name)
+    {
+        if (const auto itr = m_ids.find(name); itr != m_ids.cend())
+        {
+            return itr->second;
+        }
+
+        if (m_names.size() >= noSymbol)
+        {
+            throw std::length_error{"Too many symbols"};
+        }
+
+        static const UidIdentifierProcessor uidProc; // Stateless for unexpand(), may be shared
+        const auto unexpanded = uidProc.unexpand(std::string{name});
+
+        // The deque never relocates its elements, so the key stays valid
+        const auto id = static_cast<SymbolId>(m_names.size());
+        const auto& stored = m_names.emplace_back(name);
+        m_ids.emplace(std::string_view{stored}, id);
+
+        if (unexpanded == name)
+        {
+            m_unexpanded.push_back(&stored);
+        }
+        else
+        {
+            m_unexpanded.push_back(&m_unexpandedNames.emplace_back(unexpanded));
+        }
+        return id;
+    }
+
+    SymbolId SymbolTable::find(std::string_view name) const
+    {
+        const auto itr = m_ids.find(name);
+        return itr != m_ids.cend() ? itr->second : noSymbol;
+    }
+
+    const std::pmr::string& SymbolTable::name(SymbolId id) const
+    {
+        return m_names.at(id);
+    }
+
+    const std::pmr::string& SymbolTable::unexpandedName(SymbolId id) const
+    {
+        return *m_unexpanded.at(id);
+    }
+
+    std::size_t SymbolTable::size() const
+    {
+        return m_names.size();
+    }
+}
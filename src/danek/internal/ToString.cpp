@@ -28,6 +28,8 @@
 #include <array>
 #include <iterator>
 #include <sstream>
+#include <string_view>
+#include <vector>
 
 namespace danek
 {
@@ -59,9 +61,9 @@ namespace danek
         }
 
 
-        std::string escape(const std::string& str)
+        std::string escape(std::string_view str)
         {
-            auto output = str;
+            std::string output{str};
 
             std::for_each(escapeSequences.cbegin(), escapeSequences.cend(),
                           [&output](const auto& v) { replaceInplace(output, v.first, v.second); });
@@ -74,21 +76,64 @@ namespace danek
         {
             if (expand == false)
             {
-                UidIdentifierProcessor uidIdProc;
+                // unexpand() only reads the processor, so one instance serves all threads
+                static const UidIdentifierProcessor uidIdProc;
                 return uidIdProc.unexpand(name);
             }
             return name;
         }
 
+        void appendItem(std::stringstream& os, const ConfigItem& item, std::string_view nameStr, bool expandUidNames,
+                        std::size_t indentLevel)
+        {
+            os << indent(indentLevel);
+
+            switch (item.type())
+            {
+                case ConfType::String:
+                    os << nameStr << " = " << escape(item.stringVal()) << ";\n";
+                    break;
+                case ConfType::List:
+                {
+                    os << nameStr << " = [";
+                    const auto& values = item.listVal();
+
+                    if (values.empty() == false)
+                    {
+                        using OItr = std::ostream_iterator<std::string>;
+                        std::transform(values.cbegin(), std::prev(values.cend()), OItr{os, ", "}, escape);
+                        std::transform(std::prev(values.cend()), values.cend(), OItr{os}, escape);
+                    }
+
+                    os << "];\n";
+                }
+                break;
+                case ConfType::Scope:
+                {
+                    os << nameStr << " {\n"
+                       << toString(*(item.scopeVal()), expandUidNames, indentLevel + 1) << indent(indentLevel) << "}\n";
+                }
+                break;
+                default:
+                    break;
+            }
+        }
+
+        //--------
+        // The items are written by name; each brings its unexpanded name
+        // along, so it need not be derived again.
+        //--------
         void appendConfType(std::stringstream& stream, const ConfigScope& scope, ConfType type, bool expandUid,
                             std::size_t indentLevel)
         {
-            auto names = scope.listLocallyScopedNames(type, false, {});
-            std::sort(names.begin(), names.end());
+            std::vector<const ConfigItem*> items;
+            std::string name;
+
+            scope.forEachItem(type, false, name, [&items](std::string_view, const ConfigItem& item) { items.push_back(&item); });
+            std::sort(items.begin(), items.end(), [](const ConfigItem* a, const ConfigItem* b) { return a->name() < b->name(); });
 
-            std::for_each(names.cbegin(), names.cend(), [&stream, &scope, expandUid, indentLevel](const auto s) {
-                const auto item = scope.findItem(s);
-                stream << toString(*item, item->name(), expandUid, indentLevel);
+            std::for_each(items.cbegin(), items.cend(), [&stream, expandUid, indentLevel](const ConfigItem* item) {
+                appendItem(stream, *item, (expandUid == true) ? item->name() : item->unexpandedName(), expandUid, indentLevel);
             });
         }
     }
@@ -96,40 +141,8 @@ namespace danek
 
     std::string toString(const ConfigItem& item, const std::string& name, bool expandUidNames, std::size_t indentLevel)
     {
-        const std::string nameStr = expandUid(name, expandUidNames);
         std::stringstream os;
-
-        os << indent(indentLevel);
-
-        switch (item.type())
-        {
-            case ConfType::String:
-                os << nameStr << " = " << escape(item.stringVal()) << ";\n";
-                break;
-            case ConfType::List:
-            {
-                os << nameStr << " = [";
-                const auto& values = item.listVal();
-
-                if (values.empty() == false)
-                {
-                    using OItr = std::ostream_iterator<std::string>;
-                    std::transform(values.cbegin(), std::prev(values.cend()), OItr{os, ", "}, escape);
-                    std::transform(std::prev(values.cend()), values.cend(), OItr{os}, escape);
-                }
-
-                os << "];\n";
-            }
-            break;
-            case ConfType::Scope:
-            {
-                os << nameStr << " {\n"
-                   << toString(*(item.scopeVal()), expandUidNames, indentLevel + 1) << indent(indentLevel) << "}\n";
-            }
-            break;
-            default:
-                break;
-        }
+        appendItem(os, item, expandUid(name, expandUidNames), expandUidNames, indentLevel);
 
         return os.str();
     }
@@ -46,9 +46,14 @@ namespace danek
     {
     }
 
+    bool UidIdentifierProcessor::needsExpanding(std::string_view spelling) const
+    {
+        return spelling.find(m_uidToken) != std::string_view::npos;
+    }
+
     std::string UidIdentifierProcessor::expand(const std::string& spelling)
     {
-        if (spelling.find(m_uidToken) == std::string::npos)
+        if (needsExpanding(spelling) == false)
         {
             return spelling;
         }
@@ -0,0 +1,207 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/internal/Utf8.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace danek::utf8
+{
+    namespace
+    {
+        constexpr bool isContinuation(unsigned char byte)
+        {
+            return (byte & 0xC0) == 0x80;
+        }
+    }
+
+
+    //----------------------------------------------------------------------
+    // Function:	asciiLength()
+    //
+    // Description:	Tests 16 bytes at a time with SSE2 where available,
+    //		else 8 bytes at a time, for any byte with the high bit
+    //		set.
+    //----------------------------------------------------------------------
+
+    std::size_t asciiLength(const char* begin, const char* end)
+    {
+        const char* ptr = begin;
+
+#if defined(__SSE2__)
+        while (end - ptr >= 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+            const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(block));
+
+            if (mask != 0)
+            {
+                return static_cast<std::size_t>(ptr - begin) + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+            ptr += 16;
+        }
+#endif
+
+        while (end - ptr >= 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, ptr, sizeof(word));
+
+            if ((word & 0x8080808080808080) != 0)
+            {
+                break;
+            }
+            ptr += 8;
+        }
+
+        while (ptr != end && static_cast<unsigned char>(*ptr) < 0x80)
+        {
+            ++ptr;
+        }
+        return static_cast<std::size_t>(ptr - begin);
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	decode()
+    //
+    // Description:	The range of the second byte depends on the first,
+    //		which rules out overlong forms, surrogates and code
+    //		points beyond U+10FFFF; the remaining bytes only need
+    //		to be continuation bytes.
+    //----------------------------------------------------------------------
+
+    bool decode(const char*& ptr, const char* end, char32_t& codePoint)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(ptr);
+        const auto available = end - ptr;
+
+        if (available <= 0)
+        {
+            return false;
+        }
+
+        const unsigned char first = bytes[0];
+
+        if (first < 0x80)
+        {
+            codePoint = first;
+            ++ptr;
+            return true;
+        }
+
+        std::ptrdiff_t length;
+        unsigned char secondMin = 0x80;
+        unsigned char secondMax = 0xBF;
+
+        if (first >= 0xC2 && first <= 0xDF)
+        {
+            length = 2;
+            codePoint = first & 0x1F;
+        }
+        else if (first >= 0xE0 && first <= 0xEF)
+        {
+            length = 3;
+            codePoint = first & 0x0F;
+            secondMin = (first == 0xE0) ? 0xA0 : 0x80;
+            secondMax = (first == 0xED) ? 0x9F : 0xBF;
+        }
+        else if (first >= 0xF0 && first <= 0xF4)
+        {
+            length = 4;
+            codePoint = first & 0x07;
+            secondMin = (first == 0xF0) ? 0x90 : 0x80;
+            secondMax = (first == 0xF4) ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (available < length || bytes[1] < secondMin || bytes[1] > secondMax)
+        {
+            return false;
+        }
+        codePoint = (codePoint << 6) | (bytes[1] & 0x3F);
+
+        for (std::ptrdiff_t i = 2; i < length; ++i)
+        {
+            if (isContinuation(bytes[i]) == false)
+            {
+                return false;
+            }
+            codePoint = (codePoint << 6) | (bytes[i] & 0x3F);
+        }
+        ptr += length;
+        return true;
+    }
+
+    std::ptrdiff_t countCodePoints(std::string_view str)
+    {
+        const char* ptr = str.data();
+        const char* const end = ptr + str.size();
+        std::ptrdiff_t count = 0;
+
+        while (ptr != end)
+        {
+            const auto ascii = asciiLength(ptr, end);
+            ptr += ascii;
+            count += static_cast<std::ptrdiff_t>(ascii);
+
+            if (ptr != end)
+            {
+                char32_t codePoint;
+
+                if (decode(ptr, end, codePoint) == false)
+                {
+                    return -1;
+                }
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    //----------------------------------------------------------------------
+    // Function:	isSpace()
+    //
+    // Description:	The ASCII white space characters and the Unicode
+    //		space separators which don't forbid a line break, as
+    //		iswspace() has them in a UTF-8 locale.
+    //----------------------------------------------------------------------
+
+    bool isSpace(char32_t codePoint)
+    {
+        if (codePoint < 0x80)
+        {
+            return codePoint == ' ' || (codePoint >= '\t' && codePoint <= '\r');
+        }
+        return codePoint == 0x85 || codePoint == 0x1680 || (codePoint >= 0x2000 && codePoint <= 0x2006) ||
+               (codePoint >= 0x2008 && codePoint <= 0x200A) || codePoint == 0x2028 || codePoint == 0x2029 ||
+               codePoint == 0x205F || codePoint == 0x3000;
+    }
+}
@@ -25,6 +25,32 @@
 
 namespace danek::util
 {
+    namespace
+    {
+        constexpr std::uint64_t fnvOffsetBasis{0xcbf29ce484222325};
+        constexpr std::uint64_t fnvPrime{0x100000001b3};
+
+
+        std::uint64_t hashAppend(std::uint64_t hash, std::string_view str)
+        {
+            for (const char c : str)
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * fnvPrime;
+            }
+            return hash;
+        }
+
+
+        // FNV-1a mixes poorly into the low bits, which hash tables use
+        std::uint64_t finish(std::uint64_t hash)
+        {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccd;
+            return hash ^ (hash >> 33);
+        }
+    }
+
+
     std::vector<std::string> splitScopes(const std::string& input)
     {
         constexpr char delim{'.'};
@@ -45,4 +71,134 @@ namespace danek::util
 
         return tokens;
     }
+
+
+    std::uint64_t hashName(std::string_view name)
+    {
+        return finish(hashAppend(fnvOffsetBasis, name));
+    }
+
+
+    ScopedName::ScopedName(std::string_view scope, std::string_view localName)
+        : m_parts{scope, localName}, m_numParts(2), m_localName(localName)
+    {
+        if (scope.empty() == true)
+        {
+            m_parts[0] = localName;
+            m_numParts = 1;
+        }
+        else if (localName.empty() == true)
+        {
+            m_numParts = 1;
+        }
+    }
+
+    bool ScopedName::empty() const
+    {
+        return m_numParts == 1 && m_parts[0].empty();
+    }
+
+    bool ScopedName::isAbsolute() const
+    {
+        return m_parts[0].empty() == false && m_parts[0].front() == '.';
+    }
+
+    ScopedName ScopedName::relativeName() const
+    {
+        ScopedName name{*this};
+        name.m_parts[0].remove_prefix(1);
+        return name;
+    }
+
+    std::string_view ScopedName::localName() const
+    {
+        return m_localName;
+    }
+
+    std::string ScopedName::str() const
+    {
+        std::string name{m_parts[0]};
+
+        if (m_numParts == 2)
+        {
+            name.append(".").append(m_parts[1]);
+        }
+        return name;
+    }
+
+    std::size_t ScopedName::numParts() const
+    {
+        return m_numParts;
+    }
+
+    std::string_view ScopedName::part(std::size_t index) const
+    {
+        return m_parts[index];
+    }
+
+    std::uint64_t ScopedName::hash() const
+    {
+        auto last = m_parts[m_numParts - 1];
+
+        //--------
+        // A trailing '.' is dropped, as the Tokenizer ignores it too
+        //--------
+        if (last.empty() == false && last.back() == '.')
+        {
+            last.remove_suffix(1);
+        }
+
+        if (m_numParts == 1)
+        {
+            return finish(hashAppend(fnvOffsetBasis, last));
+        }
+        return finish(hashAppend(hashAppend(hashAppend(fnvOffsetBasis, m_parts[0]), "."), last));
+    }
+
+    ScopedName::Tokenizer::Tokenizer(const ScopedName& name)
+        : m_name(name), m_part(0), m_pos(0), m_done(false)
+    {
+    }
+
+    bool ScopedName::Tokenizer::next(std::string_view& component)
+    {
+        if (m_done == true)
+        {
+            return false;
+        }
+
+        const auto part = m_name.m_parts[m_part];
+        const bool lastPart = (m_part + 1 == m_name.m_numParts);
+
+        //--------
+        // Like std::getline(), a trailing '.' does not start another component
+        //--------
+        if (lastPart == true && m_pos > 0 && m_pos == part.size())
+        {
+            m_done = true;
+            return false;
+        }
+
+        const auto end = part.find('.', m_pos);
+
+        if (end != std::string_view::npos)
+        {
+            component = part.substr(m_pos, end - m_pos);
+            m_pos = end + 1;
+            return true;
+        }
+
+        component = part.substr(m_pos);
+
+        if (lastPart == true)
+        {
+            m_done = true;
+        }
+        else
+        {
+            ++m_part;
+            m_pos = 0;
+        }
+        return true;
+    }
 }
@@ -22,8 +22,13 @@
 
 #include "danek/StringBuffer.h"
 #include "danek/internal/platform/Platform.h"
+#include <array>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <system_error>
 #include <unistd.h>
 
 namespace danek::platform
@@ -35,4 +40,119 @@ namespace danek::platform
 
         return (stat(fileName.c_str(), &sb) == 0);
     }
+
+    namespace
+    {
+        [[noreturn]] void throwLastError()
+        {
+            const auto errorCode = errno;
+            throw std::system_error{errorCode, std::system_category()};
+        }
+
+        bool isUnchanged(const struct stat& before, const struct stat& after)
+        {
+            return before.st_size == after.st_size && before.st_mtim.tv_sec == after.st_mtim.tv_sec
+                   && before.st_mtim.tv_nsec == after.st_mtim.tv_nsec;
+        }
+
+        // Closes the descriptor on every path out of the constructor
+        class FileDescriptor
+        {
+        public:
+            explicit FileDescriptor(int fd)
+                : m_fd(fd)
+            {
+            }
+
+            FileDescriptor(const FileDescriptor&) = delete;
+
+            ~FileDescriptor()
+            {
+                ::close(m_fd);
+            }
+
+            int get() const
+            {
+                return m_fd;
+            }
+
+            FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        private:
+            int m_fd;
+        };
+    }
+
+
+    FileContents::FileContents(const std::string& fileName)
+        : m_data(nullptr), m_size(0), m_mapped(false)
+    {
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+
+        if (fd == -1)
+        {
+            throwLastError();
+        }
+
+        const FileDescriptor file{fd};
+        struct stat sb;
+
+        if (::fstat(file.get(), &sb) == -1)
+        {
+            throwLastError();
+        }
+
+        //--------
+        // Files in /proc and the like report a size of 0, so only regular
+        // files with a size are mapped. A file which is being written while
+        // it's mapped is read instead; its size and modification time must
+        // be the same before and after mapping it.
+        //--------
+        if (S_ISREG(sb.st_mode) && sb.st_size > 0)
+        {
+            const auto size = static_cast<std::size_t>(sb.st_size);
+            void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.get(), 0);
+
+            if (addr != MAP_FAILED)
+            {
+                struct stat mapped;
+
+                if (::fstat(file.get(), &mapped) == 0 && isUnchanged(sb, mapped) == true)
+                {
+                    ::madvise(addr, size, MADV_SEQUENTIAL);
+                    m_data = static_cast<const char*>(addr);
+                    m_size = size;
+                    m_mapped = true;
+                    return;
+                }
+                ::munmap(addr, size);
+            }
+        }
+
+        std::array<char, 64 * 1024> chunk;
+        ssize_t count;
+
+        while ((count = ::read(file.get(), chunk.data(), chunk.size())) != 0)
+        {
+            if (count == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throwLastError();
+            }
+            m_buffer.append(chunk.data(), static_cast<std::size_t>(count));
+        }
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    FileContents::~FileContents()
+    {
+        if (m_mapped == true)
+        {
+            ::munmap(const_cast<char*>(m_data), m_size);
+        }
+    }
 }
@@ -22,6 +22,10 @@
 
 #include "danek/internal/platform/Platform.h"
 #include <array>
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <system_error>
 #include <windows.h>
 
 namespace danek
@@ -45,5 +49,26 @@ namespace danek
             }
             return false;
         }
+
+
+        //--------
+        // Files are read in bulk; they are not mapped on this platform.
+        //--------
+        FileContents::FileContents(const std::string& fileName)
+            : m_data(nullptr), m_size(0), m_mapped(false)
+        {
+            std::ifstream file{fileName, std::ios::binary};
+
+            if (file.good() == false)
+            {
+                const auto errorCode = errno;
+                throw std::system_error{errorCode, std::system_category()};
+            }
+            m_buffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+
+        FileContents::~FileContents() = default;
     }
 }
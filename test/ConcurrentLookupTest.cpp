@@ -0,0 +1,119 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace danek;
+using namespace testing;
+
+class ConcurrentLookupTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->setFallbackConfiguration(Configuration::SourceType::String, "extra = \"42\";\n"
+                                                                         "fallback = \"x\";\n");
+        cfg->parse(Configuration::SourceType::String, "port = \"8080\";\n"
+                                                      "app {\n"
+                                                      "  name = \"abc\";\n"
+                                                      "  timeout = \"5 seconds\";\n"
+                                                      "  size = \"2 MB\";\n"
+                                                      "  colour = \"red\";\n"
+                                                      "  values = [\"a\", \"b\"];\n"
+                                                      "  uid-entry { level = \"3\"; }\n"
+                                                      "  uid-entry { level = \"4\"; }\n"
+                                                      "}\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    // Runs the lookups from a number of threads at once, returns the number of wrong results
+    int hammer(const Configuration* config) const
+    {
+        constexpr int numThreads{8};
+        constexpr int iterations{2000};
+        static constexpr EnumNameAndValue colours[] = {{"red", 0}, {"green", 1}};
+        const auto key = config->resolveKey("app", "name");
+        std::atomic<int> failures{0};
+        std::vector<std::thread> threads;
+
+        const auto check = [&failures](bool result) {
+            if (result == false)
+            {
+                ++failures;
+            }
+        };
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            threads.emplace_back([config, &key, &check] {
+                for (int n = 0; n < iterations; ++n)
+                {
+                    StringVector values;
+                    StringVector names;
+                    config->lookupList("app", "values", values);
+                    config->listFullyScopedNames("app", "", ConfType::Scope, false, "app.uid-entry", names);
+
+                    check(config->lookupInt("", "port") == 8080);
+                    check(std::string_view{config->lookupString(key)} == "abc");
+                    check(config->lookupDurationSeconds("app", "timeout") == 5);
+                    check(config->lookupMemorySizeMB("app", "size") == 2);
+                    check(config->lookupEnum("app", "colour", "colour", colours, 2) == 0);
+                    check(config->lookupInt("", "extra") == 42);
+                    check(config->type("app", "fallback") == ConfType::String);
+                    check(config->lookupInt("app", "missing", 7) == 7);
+                    check(values.size() == 2);
+                    check(names.size() == 2);
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        return failures.load();
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(ConcurrentLookupTest, concurrentLookups)
+{
+    EXPECT_THAT(hammer(cfg), Eq(0));
+}
+
+TEST_F(ConcurrentLookupTest, concurrentLookupsOnFrozenConfiguration)
+{
+    cfg->freeze();
+    EXPECT_THAT(hammer(cfg), Eq(0));
+}
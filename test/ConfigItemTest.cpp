@@ -29,11 +29,13 @@ using namespace testing;
 
 class ConfigItemTest : public testing::Test
 {
+protected:
+    SymbolTable symbols;
 };
 
 TEST_F(ConfigItemTest, stringItem)
 {
-    const ConfigItem item{"name_s", "value"};
+    const ConfigItem item{symbols, symbols.intern("name_s"), "value"};
     EXPECT_EQ(ConfType::String, item.type());
     EXPECT_THAT(item.name(), StrEq("name_s"));
     EXPECT_THAT(item.stringVal(), StrEq("value"));
@@ -41,14 +43,14 @@ TEST_F(ConfigItemTest, stringItem)
 
 TEST_F(ConfigItemTest, stringItemThrowsOnInvalidTypeAccess)
 {
-    const ConfigItem item{"bad", std::vector<std::string>{}};
+    const ConfigItem item{symbols, symbols.intern("bad"), std::vector<std::string>{}};
     EXPECT_THROW(item.stringVal(), std::domain_error);
 }
 
 TEST_F(ConfigItemTest, stringListItem)
 {
     const std::vector<std::string> v{"a1", "a2"};
-    ConfigItem item{"name_l", v};
+    ConfigItem item{symbols, symbols.intern("name_l"), v};
 
     EXPECT_EQ(ConfType::List, item.type());
     EXPECT_THAT(item.name(), StrEq("name_l"));
@@ -59,14 +61,14 @@ TEST_F(ConfigItemTest, stringListItem)
 
 TEST_F(ConfigItemTest, stringListItemThrowsOnInvalidTypeAccess)
 {
-    const ConfigItem item{"bad", "value"};
+    const ConfigItem item{symbols, symbols.intern("bad"), "value"};
     EXPECT_THROW(item.listVal(), std::domain_error);
 }
 
 TEST_F(ConfigItemTest, scopeItem)
 {
     const char c = '\0';
-    const ConfigItem item{"name_cs", std::make_unique<ConfigScope>(nullptr, &c)};
+    const ConfigItem item{symbols, symbols.intern("name_cs"), makeResourcePtr<ConfigScope>(std::pmr::get_default_resource(), nullptr, &c)};
     EXPECT_EQ(ConfType::Scope, item.type());
     EXPECT_THAT(item.name(), StrEq("name_cs"));
     EXPECT_THAT(item.scopeVal(), Not(nullptr));
@@ -74,6 +76,30 @@ TEST_F(ConfigItemTest, scopeItem)
 
 TEST_F(ConfigItemTest, scopeItemThrowsOnInvalidTypeAccess)
 {
-    const ConfigItem item{"bad", "value"};
+    const ConfigItem item{symbols, symbols.intern("bad"), "value"};
     EXPECT_THROW(item.scopeVal(), std::domain_error);
 }
+
+TEST_F(ConfigItemTest, cachedValueOfConversion)
+{
+    const ConfigItem item{symbols, symbols.intern("n"), "-5"};
+    std::int32_t value{0};
+
+    EXPECT_FALSE(item.cachedValue(ConfigItem::Conversion::Int, value));
+    item.cacheValue(ConfigItem::Conversion::Int, -5);
+    EXPECT_TRUE(item.cachedValue(ConfigItem::Conversion::Int, value));
+    EXPECT_THAT(value, Eq(-5));
+    EXPECT_FALSE(item.cachedValue(ConfigItem::Conversion::DurationSeconds, value));
+}
+
+TEST_F(ConfigItemTest, cacheKeepsLastConversion)
+{
+    const ConfigItem item{symbols, symbols.intern("n"), "1 KB"};
+    std::int32_t value{0};
+
+    item.cacheValue(ConfigItem::Conversion::MemorySizeBytes, 1024);
+    item.cacheValue(ConfigItem::Conversion::MemorySizeKB, 1);
+    EXPECT_FALSE(item.cachedValue(ConfigItem::Conversion::MemorySizeBytes, value));
+    EXPECT_TRUE(item.cachedValue(ConfigItem::Conversion::MemorySizeKB, value));
+    EXPECT_THAT(value, Eq(1));
+}
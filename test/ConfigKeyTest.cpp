@@ -0,0 +1,203 @@
+// Copyright (c) 2017-2021 offa
+// Copyright 2011 Ciaran McHale.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+
+using namespace danek;
+using namespace testing;
+
+class ConfigKeyTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "port = \"8080\";\n"
+                                                      "app {\n"
+                                                      "  name = \"abc\";\n"
+                                                      "  timeout = \"5 seconds\";\n"
+                                                      "  size = \"2 MB\";\n"
+                                                      "  enabled = \"true\";\n"
+                                                      "  ratio = \"0.5\";\n"
+                                                      "  values = [\"a\", \"b\"];\n"
+                                                      "}\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(ConfigKeyTest, keyKeepsNames)
+{
+    const auto key = cfg->resolveKey("app", "name");
+    EXPECT_THAT(key.scope(), StrEq("app"));
+    EXPECT_THAT(key.localName(), StrEq("name"));
+}
+
+TEST_F(ConfigKeyTest, lookupThroughKey)
+{
+    EXPECT_THAT(cfg->lookupString(cfg->resolveKey("app", "name")), StrEq("abc"));
+    EXPECT_THAT(cfg->lookupInt(cfg->resolveKey("", "port")), Eq(8080));
+    EXPECT_THAT(cfg->lookupFloat(cfg->resolveKey("app", "ratio")), FloatEq(0.5f));
+    EXPECT_THAT(cfg->lookupDurationSeconds(cfg->resolveKey("app", "timeout")), Eq(5));
+    EXPECT_THAT(cfg->lookupDurationMilliseconds(cfg->resolveKey("app", "timeout")), Eq(5000));
+    EXPECT_THAT(cfg->lookupMemorySizeKB(cfg->resolveKey("app", "size")), Eq(2048));
+    EXPECT_TRUE(cfg->lookupBoolean(cfg->resolveKey("app", "enabled")));
+    EXPECT_THAT(cfg->type(cfg->resolveKey("", "app")), Eq(ConfType::Scope));
+
+    std::vector<std::string> values;
+    cfg->lookupList(cfg->resolveKey("app", "values"), values);
+    EXPECT_THAT(values, ElementsAre("a", "b"));
+}
+
+TEST_F(ConfigKeyTest, lookupThroughKeyReturnsSameAsLookupByName)
+{
+    EXPECT_THAT(cfg->lookupString(cfg->resolveKey("app", "name")), Eq(cfg->lookupString("app", "name")));
+}
+
+TEST_F(ConfigKeyTest, lookupOfMissingEntryUsesDefault)
+{
+    const auto key = cfg->resolveKey("app", "missing");
+    EXPECT_THAT(cfg->type(key), Eq(ConfType::NoValue));
+    EXPECT_THAT(cfg->lookupString(key, "default"), StrEq("default"));
+    EXPECT_THAT(cfg->lookupInt(key, 3), Eq(3));
+    EXPECT_THAT(cfg->lookupMemorySizeBytes(key, 10), Eq(10));
+    EXPECT_TRUE(cfg->lookupBoolean(key, true));
+
+    std::vector<std::string> values;
+    const char* defaults[] = {"x", "y"};
+    cfg->lookupList(key, values, defaults, 2);
+    EXPECT_THAT(values, ElementsAre("x", "y"));
+}
+
+TEST_F(ConfigKeyTest, lookupOfMissingEntryThrowsWithoutDefault)
+{
+    const auto key = cfg->resolveKey("app", "missing");
+    EXPECT_THROW(cfg->lookupString(key), ConfigurationException);
+    EXPECT_THROW(cfg->lookupInt(key), ConfigurationException);
+}
+
+TEST_F(ConfigKeyTest, lookupOfWrongTypeThrows)
+{
+    EXPECT_THROW(cfg->lookupString(cfg->resolveKey("", "app")), ConfigurationException);
+    EXPECT_THROW(cfg->lookupString(cfg->resolveKey("app", "values"), "default"), ConfigurationException);
+    EXPECT_THROW(cfg->lookupInt(cfg->resolveKey("app", "name")), ConfigurationException);
+
+    std::vector<std::string> values;
+    EXPECT_THROW(cfg->lookupList(cfg->resolveKey("app", "name"), values), ConfigurationException);
+}
+
+TEST_F(ConfigKeyTest, keyIsUpdatedByInsertString)
+{
+    const auto key = cfg->resolveKey("app", "name");
+    cfg->insertString("app", "name", "new value");
+    EXPECT_THAT(cfg->lookupString(key), StrEq("new value"));
+}
+
+TEST_F(ConfigKeyTest, keyOfMissingEntryFindsInsertedEntry)
+{
+    const auto key = cfg->resolveKey("app", "inserted");
+    cfg->insertList("app", "inserted", std::vector<std::string>{"1", "2"});
+    EXPECT_THAT(cfg->type(key), Eq(ConfType::List));
+}
+
+TEST_F(ConfigKeyTest, keyIsUpdatedByRemove)
+{
+    const auto key = cfg->resolveKey("app", "name");
+    cfg->remove("app", "name");
+    EXPECT_THAT(cfg->lookupString(key, "removed"), StrEq("removed"));
+}
+
+TEST_F(ConfigKeyTest, keyIsUpdatedByEmpty)
+{
+    const auto key = cfg->resolveKey("", "port");
+    cfg->empty();
+    EXPECT_THAT(cfg->type(key), Eq(ConfType::NoValue));
+}
+
+TEST_F(ConfigKeyTest, keyIsUpdatedByParse)
+{
+    const auto key = cfg->resolveKey("", "port");
+    cfg->parse(Configuration::SourceType::String, "port = \"9090\";");
+    EXPECT_THAT(cfg->lookupInt(key), Eq(9090));
+}
+
+TEST_F(ConfigKeyTest, keyOfOtherConfigurationIsResolvedByName)
+{
+    auto other = Configuration::create();
+    other->parse(Configuration::SourceType::String, "port = \"1234\";");
+
+    EXPECT_THAT(other->lookupInt(cfg->resolveKey("", "port")), Eq(1234));
+    other->destroy();
+}
+
+TEST_F(ConfigKeyTest, defaultConstructedKeyFindsNothing)
+{
+    const ConfigKey key;
+    EXPECT_THAT(cfg->type(key), Eq(ConfType::NoValue));
+    EXPECT_THAT(key.symbol(), Eq(ConfigKey::noSymbol));
+}
+
+TEST_F(ConfigKeyTest, keysOfSameNameShareSymbol)
+{
+    cfg->insertString("other", "name", "xyz");
+
+    const auto key = cfg->resolveKey("app", "name");
+    EXPECT_THAT(key.symbol(), Ne(ConfigKey::noSymbol));
+    EXPECT_THAT(cfg->resolveKey("other", "name").symbol(), Eq(key.symbol()));
+    EXPECT_THAT(cfg->resolveKey("app", "port").symbol(), Ne(key.symbol()));
+    EXPECT_THAT(cfg->resolveKey("app", "missing").symbol(), Eq(ConfigKey::noSymbol));
+}
+
+TEST_F(ConfigKeyTest, keyIsUpdatedByChangedFallback)
+{
+    auto fallback = Configuration::create();
+    fallback->parse(Configuration::SourceType::String, "level = \"1\";");
+    cfg->setFallbackConfiguration(fallback);
+
+    const auto key = cfg->resolveKey("", "level");
+    EXPECT_THAT(cfg->lookupInt(key), Eq(1));
+
+    fallback->insertString("", "level", "2");
+    EXPECT_THAT(cfg->lookupInt(key), Eq(2));
+
+    cfg->setFallbackConfiguration(nullptr);
+    EXPECT_THAT(cfg->lookupInt(key, 3), Eq(3));
+    fallback->destroy();
+}
+
+TEST_F(ConfigKeyTest, keyIsUpdatedByDestroyedFallback)
+{
+    auto fallback = Configuration::create();
+    fallback->parse(Configuration::SourceType::String, "level = \"1\";");
+    cfg->setFallbackConfiguration(fallback);
+
+    const auto key = cfg->resolveKey("", "level");
+    fallback->destroy();
+    EXPECT_THAT(cfg->lookupInt(key, 3), Eq(3));
+}
@@ -0,0 +1,250 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "danek/internal/ConfigLex.h"
+#include "danek/internal/LexBaseSymbols.h"
+#include "danek/internal/SchemaLex.h"
+#include <gmock/gmock.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace danek;
+using namespace testing;
+
+class ConfigLexTest : public testing::Test
+{
+protected:
+    using Token = std::tuple<short, std::string, std::int32_t>;
+
+    void TearDown() override
+    {
+        std::filesystem::remove(fileName);
+    }
+
+    void writeFile(const std::string& content)
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file << content;
+    }
+
+    std::vector<Token> lex(Configuration::SourceType sourceType, const char* source)
+    {
+        ConfigLex lexer{sourceType, source, &uidProc};
+        std::vector<Token> tokens;
+        LexToken token;
+
+        do
+        {
+            lexer.nextToken(token);
+            tokens.emplace_back(token.type(), token.spelling(), token.lineNum());
+        } while (token.type() != lex::LEX_EOF_SYM);
+        return tokens;
+    }
+
+    std::vector<std::pair<short, std::string>> lexSpellings(const char* source)
+    {
+        std::vector<std::pair<short, std::string>> spellings;
+
+        for (const auto& [type, spelling, lineNum] : lex(Configuration::SourceType::String, source))
+        {
+            spellings.emplace_back(type, spelling);
+        }
+        spellings.pop_back();
+        return spellings;
+    }
+
+    UidIdentifierProcessor uidProc;
+    const std::string fileName{(std::filesystem::temp_directory_path() / "danek-ConfigLexTest.cfg").string()};
+};
+
+TEST_F(ConfigLexTest, fileIsLexedLikeStringWithoutCarriageReturns)
+{
+    writeFile("a = \"x\";\r\nb = [\"1\", \"2\"];\r\n# comment\r\nc { d = \"e\"; }\r\n");
+
+    const auto fromFile = lex(Configuration::SourceType::File, fileName.c_str());
+    const auto fromString = lex(Configuration::SourceType::String, "a = \"x\";\nb = [\"1\", \"2\"];\n# comment\nc { d = \"e\"; }\n");
+
+    ASSERT_THAT(fromFile, SizeIs(fromString.size()));
+    EXPECT_THAT(std::vector<Token>(fromFile.begin(), std::prev(fromFile.end())),
+                ElementsAreArray(fromString.begin(), std::prev(fromString.end())));
+    EXPECT_THAT(std::get<1>(fromFile.back()), Eq("<end of file>"));
+    EXPECT_THAT(std::get<2>(fromFile.back()), Eq(std::get<2>(fromString.back())));
+}
+
+TEST_F(ConfigLexTest, emptyFileHasOnlyEndOfFile)
+{
+    writeFile("");
+    EXPECT_THAT(lex(Configuration::SourceType::File, fileName.c_str()), ElementsAre(Token{lex::LEX_EOF_SYM, "<end of file>", 1}));
+}
+
+TEST_F(ConfigLexTest, missingFileThrows)
+{
+    EXPECT_THROW(lex(Configuration::SourceType::File, "/nonexistent/danek.cfg"), ConfigurationException);
+}
+
+TEST_F(ConfigLexTest, multiByteCharactersAreDecodedAsUtf8)
+{
+    const auto tokens = lex(Configuration::SourceType::String, "gr\xC3\xBC\xC3\x9F" "e = \"\xE6\x97\xA5\xE6\x9C\xAC\";\n");
+
+    ASSERT_THAT(tokens, SizeIs(5));
+    EXPECT_THAT(std::get<0>(tokens[0]), Eq(lex::LEX_IDENT_SYM));
+    EXPECT_THAT(std::get<1>(tokens[0]), Eq("gr\xC3\xBC\xC3\x9F" "e"));
+    EXPECT_THAT(std::get<0>(tokens[2]), Eq(lex::LEX_STRING_SYM));
+    EXPECT_THAT(std::get<1>(tokens[2]), Eq("\xE6\x97\xA5\xE6\x9C\xAC"));
+}
+
+TEST_F(ConfigLexTest, invalidUtf8Throws)
+{
+    EXPECT_THROW(lex(Configuration::SourceType::String, "a = \"\xC3\";"), ConfigurationException);
+    EXPECT_THROW(lex(Configuration::SourceType::String, "a = \"\xC0\x80\";"), ConfigurationException);
+}
+
+TEST_F(ConfigLexTest, lineNumbersCountNewlinesInSkippedRuns)
+{
+    const std::string spaces(40, ' ');
+    const std::string source = spaces + "\n\n\t\n" + spaces + "a\n# " + spaces + " comment\n\n   # another\n" + spaces + "\r\n\n" +
+                               "b = <%x\n" + spaces + "\n%y\n%>;\nc";
+
+    const auto tokens = lex(Configuration::SourceType::String, source.c_str());
+
+    ASSERT_THAT(tokens, SizeIs(7));
+    EXPECT_THAT(tokens[0], Eq(Token{lex::LEX_IDENT_SYM, "a", 4}));
+    EXPECT_THAT(tokens[1], Eq(Token{lex::LEX_IDENT_SYM, "b", 10}));
+    EXPECT_THAT(tokens[3], Eq(Token{lex::LEX_STRING_SYM, "x\n" + spaces + "\n%y\n", 10}));
+    EXPECT_THAT(tokens[4], Eq(Token{lex::LEX_SEMICOLON_SYM, ";", 13}));
+    EXPECT_THAT(tokens[5], Eq(Token{lex::LEX_IDENT_SYM, "c", 14}));
+}
+
+TEST_F(ConfigLexTest, longStringsKeepEscapesAndDropCarriageReturns)
+{
+    const std::string text(50, 't');
+    const std::string source = "a = \"" + text + "%n" + text + "%\"\r" + text + "%%\";";
+
+    const auto tokens = lex(Configuration::SourceType::String, source.c_str());
+
+    ASSERT_THAT(tokens, SizeIs(5));
+    EXPECT_THAT(tokens[2], Eq(Token{lex::LEX_STRING_SYM, text + "\n" + text + "\"" + text + "%", 1}));
+}
+
+TEST_F(ConfigLexTest, unterminatedLongStringsEndAtNewline)
+{
+    const std::string text(50, 's');
+    const std::string source = "a = \"" + text + "\n\"b\";";
+
+    const auto tokens = lex(Configuration::SourceType::String, source.c_str());
+
+    EXPECT_THAT(tokens[2], Eq(Token{lex::LEX_STRING_WITH_EOL_SYM, text, 1}));
+}
+
+TEST_F(ConfigLexTest, invalidUtf8InCommentThrows)
+{
+    const std::string source = "# " + std::string(40, 'c') + "\xC3 comment\na = \"x\";";
+    EXPECT_THROW(lex(Configuration::SourceType::String, source.c_str()), ConfigurationException);
+}
+
+TEST_F(ConfigLexTest, operatorsAndPunctuation)
+{
+    EXPECT_THAT(lexSpellings("?= != ! == = && || + ; [ ] { } ( ) ,"),
+                ElementsAre(Pair(lex::LEX_QUESTION_EQUALS_SYM, "?="), Pair(lex::LEX_NOT_EQUALS_SYM, "!="), Pair(lex::LEX_NOT_SYM, "!"),
+                            Pair(lex::LEX_EQUALS_EQUALS_SYM, "=="), Pair(lex::LEX_EQUALS_SYM, "="), Pair(lex::LEX_AND_SYM, "&&"),
+                            Pair(lex::LEX_OR_SYM, "||"), Pair(lex::LEX_PLUS_SYM, "+"), Pair(lex::LEX_SEMICOLON_SYM, ";"),
+                            Pair(lex::LEX_OPEN_BRACKET_SYM, "["), Pair(lex::LEX_CLOSE_BRACKET_SYM, "]"), Pair(lex::LEX_OPEN_BRACE_SYM, "{"),
+                            Pair(lex::LEX_CLOSE_BRACE_SYM, "}"), Pair(lex::LEX_OPEN_PAREN_SYM, "("), Pair(lex::LEX_CLOSE_PAREN_SYM, ")"),
+                            Pair(lex::LEX_COMMA_SYM, ",")));
+    EXPECT_THAT(lexSpellings("a=\"b\";c==d"),
+                ElementsAre(Pair(lex::LEX_IDENT_SYM, "a"), Pair(lex::LEX_EQUALS_SYM, "="), Pair(lex::LEX_STRING_SYM, "b"),
+                            Pair(lex::LEX_SEMICOLON_SYM, ";"), Pair(lex::LEX_IDENT_SYM, "c"), Pair(lex::LEX_EQUALS_EQUALS_SYM, "=="),
+                            Pair(lex::LEX_IDENT_SYM, "d")));
+}
+
+TEST_F(ConfigLexTest, incompleteOperatorsAreUnknown)
+{
+    EXPECT_THAT(lexSpellings("?x &y |z <w ^"),
+                ElementsAre(Pair(lex::LEX_UNKNOWN_SYM, "?x"), Pair(lex::LEX_IDENT_SYM, "x"), Pair(lex::LEX_UNKNOWN_SYM, "&y"),
+                            Pair(lex::LEX_IDENT_SYM, "y"), Pair(lex::LEX_UNKNOWN_SYM, "|z"), Pair(lex::LEX_IDENT_SYM, "z"),
+                            Pair(lex::LEX_UNKNOWN_SYM, "<"), Pair(lex::LEX_IDENT_SYM, "w"), Pair(lex::LEX_UNKNOWN_SYM, "^")));
+}
+
+TEST_F(ConfigLexTest, keywordsAndFunctions)
+{
+    EXPECT_THAT(lexSpellings("@include @ifExists @if2 @bogus @ getenv( split(x) read.file( foo ("),
+                ElementsAre(Pair(ConfigLex::LEX_INCLUDE_SYM, "@include"), Pair(ConfigLex::LEX_IF_EXISTS_SYM, "@ifExists"),
+                            Pair(ConfigLex::LEX_IF_SYM, "@if"), Pair(lex::LEX_IDENT_SYM, "2"), Pair(lex::LEX_UNKNOWN_SYM, "@bogus"),
+                            Pair(lex::LEX_UNKNOWN_SYM, "@"), Pair(ConfigLex::LEX_FUNC_GETENV_SYM, "getenv("),
+                            Pair(ConfigLex::LEX_FUNC_SPLIT_SYM, "split("), Pair(lex::LEX_IDENT_SYM, "x"), Pair(lex::LEX_CLOSE_PAREN_SYM, ")"),
+                            Pair(lex::LEX_UNKNOWN_FUNC_SYM, "read.file("), Pair(lex::LEX_IDENT_SYM, "foo"), Pair(lex::LEX_OPEN_PAREN_SYM, "(")));
+
+    ConfigLex lexer{Configuration::SourceType::String, "split( isFileReadable( getenv(", &uidProc};
+    LexToken token;
+    lexer.nextToken(token);
+    EXPECT_TRUE(token.isListFunc());
+    lexer.nextToken(token);
+    EXPECT_TRUE(token.isBoolFunc());
+    lexer.nextToken(token);
+    EXPECT_TRUE(token.isStringFunc());
+}
+
+TEST_F(ConfigLexTest, identifiers)
+{
+    EXPECT_THAT(lexSpellings("a.b x? c::d $e /f/g \\h -1 3_z . a..b a\rb"),
+                ElementsAre(Pair(lex::LEX_IDENT_SYM, "a.b"), Pair(lex::LEX_IDENT_SYM, "x?"), Pair(lex::LEX_IDENT_SYM, "c::d"),
+                            Pair(lex::LEX_IDENT_SYM, "$e"), Pair(lex::LEX_IDENT_SYM, "/f/g"), Pair(lex::LEX_IDENT_SYM, "\\h"),
+                            Pair(lex::LEX_IDENT_SYM, "-1"), Pair(lex::LEX_IDENT_SYM, "3_z"), Pair(lex::LEX_SOLE_DOT_IDENT_SYM, "."),
+                            Pair(lex::LEX_TWO_DOTS_IDENT_SYM, "a..b"), Pair(lex::LEX_IDENT_SYM, "ab")));
+}
+
+TEST_F(ConfigLexTest, schemaLexHasItsOwnKeywordsAndNoFunctions)
+{
+    SchemaLex lexer{"@typedef @required @include getenv("};
+    std::vector<std::pair<short, std::string>> spellings;
+    LexToken token;
+
+    for (lexer.nextToken(token); token.type() != lex::LEX_EOF_SYM; lexer.nextToken(token))
+    {
+        spellings.emplace_back(token.type(), token.spelling());
+    }
+    EXPECT_THAT(spellings, ElementsAre(Pair(SchemaLex::LEX_TYPEDEF_SYM, "@typedef"), Pair(SchemaLex::LEX_REQUIRED_SYM, "@required"),
+                                       Pair(lex::LEX_UNKNOWN_SYM, "@include"), Pair(lex::LEX_UNKNOWN_FUNC_SYM, "getenv(")));
+}
+
+TEST_F(ConfigLexTest, plainSpellingsReferToTheSource)
+{
+    const char* source = "name = \"plain value\" <%block%> @include getenv(";
+    ConfigLex lexer{Configuration::SourceType::String, source, &uidProc};
+    const std::string_view all{source};
+    LexToken token;
+
+    for (lexer.nextToken(token); token.type() != lex::LEX_EOF_SYM; lexer.nextToken(token))
+    {
+        EXPECT_THAT(token.spelling().data(), AllOf(Ge(all.data()), Lt(all.data() + all.size()))) << token.spelling();
+    }
+}
+
+TEST_F(ConfigLexTest, escapesAndCarriageReturnsAreRemovedFromSpellings)
+{
+    EXPECT_THAT(lexSpellings("a = \"x%ty%n\" \"p\rq\" <%m\rn%> uid-x a\rb"),
+                ElementsAre(Pair(lex::LEX_IDENT_SYM, "a"), Pair(lex::LEX_EQUALS_SYM, "="), Pair(lex::LEX_STRING_SYM, "x\ty\n"),
+                            Pair(lex::LEX_STRING_SYM, "pq"), Pair(lex::LEX_STRING_SYM, "mn"), Pair(lex::LEX_IDENT_SYM, "uid-000000000-x"),
+                            Pair(lex::LEX_IDENT_SYM, "ab")));
+}
@@ -29,6 +29,13 @@ using namespace testing;
 
 class ConfigScopeTest : public testing::Test
 {
+protected:
+    static std::string itemName(int i)
+    {
+        std::string name{"n"};
+        name.append(std::to_string(i));
+        return name;
+    }
 };
 
 TEST_F(ConfigScopeTest, initRootElement)
@@ -530,3 +537,181 @@ TEST_F(ConfigScopeTest, listLocallyScopedNamesOfMultipleNodesRecursiveScope)
 
     EXPECT_THAT(v, UnorderedElementsAre("sn1"));
 }
+
+TEST_F(ConfigScopeTest, findItemInLargeScope)
+{
+    ConfigScope root{nullptr, "\0"};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        root.addOrReplaceString(itemName(i), std::to_string(i));
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto item = root.findItem(itemName(i));
+        ASSERT_THAT(item, Ne(nullptr));
+        EXPECT_THAT(item->stringVal(), StrEq(std::to_string(i)));
+    }
+    EXPECT_THAT(root.findItem("n1000"), Eq(nullptr));
+}
+
+TEST_F(ConfigScopeTest, replaceItemInLargeScope)
+{
+    ConfigScope root{nullptr, "\0"};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        root.addOrReplaceString(itemName(i), "old");
+    }
+    root.addOrReplaceList("n50", {"a", "b"});
+
+    const auto found = root.findItem("n50");
+    EXPECT_THAT(found->type(), Eq(ConfType::List));
+    EXPECT_THAT(found->listVal(), ElementsAre("a", "b"));
+    EXPECT_THAT(root.listFullyScopedNames(ConfType::Variables, false), SizeIs(100));
+}
+
+TEST_F(ConfigScopeTest, removeItemFromLargeScope)
+{
+    ConfigScope root{nullptr, "\0"};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        root.addOrReplaceString(itemName(i), std::to_string(i));
+    }
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        EXPECT_TRUE(root.removeItem(itemName(i)));
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_THAT(root.contains(itemName(i)), Eq(i % 2 == 1));
+    }
+    EXPECT_THAT(root.findItem("n51")->stringVal(), StrEq("51"));
+}
+
+TEST_F(ConfigScopeTest, removeAndAddItemsInLargeScope)
+{
+    ConfigScope root{nullptr, "\0"};
+    std::vector<std::string> expected;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        root.addOrReplaceString(itemName(i), std::to_string(i));
+        expected.push_back(itemName(i));
+    }
+
+    for (int i = 0; i < 100; i += 3)
+    {
+        EXPECT_TRUE(root.removeItem(itemName(i)));
+        EXPECT_FALSE(root.removeItem(itemName(i)));
+        root.addOrReplaceString(itemName(i + 1000), std::to_string(i));
+        expected.erase(std::find(expected.begin(), expected.end(), itemName(i)));
+        expected.push_back(itemName(i + 1000));
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_THAT(root.contains(itemName(i)), Eq(i % 3 != 0));
+        EXPECT_THAT(root.contains(itemName(i + 1000)), Eq(i % 3 == 0));
+    }
+    EXPECT_THAT(root.findItem("n1003")->stringVal(), StrEq("3"));
+    EXPECT_THAT(root.listFullyScopedNames(ConfType::String, false), ContainerEq(expected));
+}
+
+TEST_F(ConfigScopeTest, listFullyScopedNamesKeepsInsertionOrderInLargeScope)
+{
+    ConfigScope root{nullptr, "\0"};
+    std::vector<std::string> expected;
+
+    for (int i = 20; i > 0; --i)
+    {
+        expected.push_back(itemName(i));
+        root.addOrReplaceString(expected.back(), "");
+    }
+    root.removeItem("n10");
+    expected.erase(std::find(expected.begin(), expected.end(), "n10"));
+
+    EXPECT_THAT(root.listFullyScopedNames(ConfType::String, false), ContainerEq(expected));
+}
+
+TEST_F(ConfigScopeTest, namesAreInternedInSymbolTableOfRoot)
+{
+    ConfigScope root{nullptr, "\0"};
+    ConfigScope* a = nullptr;
+    ConfigScope* b = nullptr;
+    root.ensureScopeExists("a", a);
+    root.ensureScopeExists("b", b);
+    a->addOrReplaceString("port", "1");
+    b->addOrReplaceString("port", "2");
+
+    EXPECT_THAT(&a->symbols(), Eq(&root.symbols()));
+    EXPECT_THAT(&b->symbols(), Eq(&root.symbols()));
+    EXPECT_THAT(a->findItem("port")->nameId(), Eq(b->findItem("port")->nameId()));
+    EXPECT_THAT(&a->findItem("port")->name(), Eq(&b->findItem("port")->name()));
+}
+
+TEST_F(ConfigScopeTest, findItemBySymbol)
+{
+    ConfigScope root{nullptr, "\0"};
+
+    for (int i = 0; i < 20; ++i)
+    {
+        root.addOrReplaceString(itemName(i), std::to_string(i));
+    }
+
+    const auto id = root.symbols().find("n7");
+    EXPECT_THAT(root.findItem(id)->stringVal(), StrEq("7"));
+    EXPECT_THAT(root.findItem(SymbolTable::noSymbol), Eq(nullptr));
+}
+
+TEST_F(ConfigScopeTest, findItemOfNameInternedElsewhere)
+{
+    ConfigScope root{nullptr, "\0"};
+    ConfigScope* a = nullptr;
+    root.ensureScopeExists("a", a);
+    a->addOrReplaceString("only-in-a", "1");
+
+    EXPECT_THAT(root.findItem("only-in-a"), Eq(nullptr));
+    EXPECT_FALSE(root.contains("only-in-a"));
+    EXPECT_FALSE(root.removeItem("only-in-a"));
+}
+
+TEST_F(ConfigScopeTest, forEachItemBuildsScopedNamesInPlace)
+{
+    ConfigScope root{nullptr, "\0"};
+    ConfigScope* a = nullptr;
+    root.addOrReplaceString("n1", "1");
+    root.ensureScopeExists("a", a);
+    a->addOrReplaceList("n2", {"x"});
+
+    std::string name{"prefix"};
+    std::vector<std::pair<std::string, ConfType>> items;
+    root.forEachItem(ConfType::ScopesAndVars, true, name,
+                     [&items](std::string_view scopedName, const ConfigItem& item) { items.emplace_back(scopedName, item.type()); });
+
+    EXPECT_THAT(items, ElementsAre(Pair("prefix.n1", ConfType::String), Pair("prefix.a", ConfType::Scope),
+                                   Pair("prefix.a.n2", ConfType::List)));
+    EXPECT_THAT(name, Eq("prefix"));
+}
+
+TEST_F(ConfigScopeTest, filterPatternsMatchUnexpandedNames)
+{
+    ConfigScope root{nullptr, "\0"};
+    ConfigScope* app = nullptr;
+    ConfigScope* entry = nullptr;
+    root.ensureScopeExists("uid-000000001-app", app);
+    app->ensureScopeExists("uid-000000002-entry", entry);
+    entry->addOrReplaceString("x", "1");
+    app->addOrReplaceString("y", "2");
+
+    EXPECT_THAT(entry->unexpandedScopedName(), Eq("uid-app.uid-entry"));
+    EXPECT_THAT(app->listFullyScopedNames(ConfType::ScopesAndVars, true, {"uid-app.uid-entry*"}),
+                ElementsAre("uid-000000001-app.uid-000000002-entry", "uid-000000001-app.uid-000000002-entry.x"));
+    EXPECT_THAT(app->listLocallyScopedNames(ConfType::String, true, {"uid-entry.*", "y"}),
+                ElementsAre("uid-000000002-entry.x", "y"));
+    EXPECT_THAT(app->listLocallyScopedNames(ConfType::String, true, {"uid-000000002-entry.*"}), IsEmpty());
+}
@@ -0,0 +1,190 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/ConfigurationHolder.h"
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace danek;
+using namespace testing;
+
+namespace
+{
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t bytesInUse() const
+        {
+            return m_bytesInUse;
+        }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            m_bytesInUse += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            m_bytesInUse -= bytes;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        std::size_t m_bytesInUse{0};
+    };
+}
+
+class ConfigurationHolderTest : public testing::Test
+{
+protected:
+    static Configuration* makeConfig(int value, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    {
+        const auto str = std::to_string(value);
+        auto cfg = Configuration::create(resource);
+        cfg->insertString("", "a", str);
+        cfg->insertString("app", "b", str);
+        return cfg;
+    }
+};
+
+TEST_F(ConfigurationHolderTest, initialVersion)
+{
+    const ConfigurationHolder holder{makeConfig(7)};
+    const auto snapshot = holder.acquire();
+
+    EXPECT_THAT(holder.version(), Eq(1));
+    EXPECT_THAT(snapshot.version(), Eq(1));
+    EXPECT_THAT(snapshot->lookupInt("", "a"), Eq(7));
+    EXPECT_TRUE(snapshot->isFrozen());
+}
+
+TEST_F(ConfigurationHolderTest, nullConfigurationThrows)
+{
+    EXPECT_THROW(ConfigurationHolder{nullptr}, std::invalid_argument);
+
+    ConfigurationHolder holder{makeConfig(1)};
+    EXPECT_THROW(holder.publish(nullptr), std::invalid_argument);
+    EXPECT_THAT(holder.version(), Eq(1));
+}
+
+TEST_F(ConfigurationHolderTest, defaultSnapshotIsEmpty)
+{
+    const ConfigurationHolder::Snapshot snapshot;
+    EXPECT_FALSE(snapshot);
+    EXPECT_THAT(snapshot.get(), Eq(nullptr));
+    EXPECT_THAT(snapshot.version(), Eq(0));
+}
+
+TEST_F(ConfigurationHolderTest, publishReplacesCurrentVersion)
+{
+    ConfigurationHolder holder{makeConfig(1)};
+    const auto old = holder.acquire();
+
+    EXPECT_THAT(holder.publish(makeConfig(2)), Eq(2));
+    EXPECT_THAT(holder.version(), Eq(2));
+    EXPECT_THAT(holder.acquire()->lookupInt("", "a"), Eq(2));
+    EXPECT_THAT(old->lookupInt("", "a"), Eq(1));
+}
+
+TEST_F(ConfigurationHolderTest, snapshotsCanBeCopiedAndMoved)
+{
+    const ConfigurationHolder holder{makeConfig(3)};
+    auto snapshot = holder.acquire();
+    const auto copy = snapshot;
+    const auto moved = std::move(snapshot);
+
+    EXPECT_THAT(copy.get(), Eq(moved.get()));
+    EXPECT_THAT(copy->lookupInt("app", "b"), Eq(3));
+}
+
+TEST_F(ConfigurationHolderTest, replacedVersionIsDestroyedWithLastSnapshot)
+{
+    CountingResource resource;
+    ConfigurationHolder holder{makeConfig(1, &resource)};
+    auto snapshot = holder.acquire();
+    auto copy = snapshot;
+
+    holder.publish(makeConfig(2));
+    EXPECT_THAT(resource.bytesInUse(), Gt(0));
+
+    snapshot = ConfigurationHolder::Snapshot{};
+    EXPECT_THAT(resource.bytesInUse(), Gt(0));
+
+    copy = ConfigurationHolder::Snapshot{};
+    EXPECT_THAT(resource.bytesInUse(), Eq(0));
+}
+
+TEST_F(ConfigurationHolderTest, concurrentReadsDuringReloads)
+{
+    constexpr int numReaders{4};
+    constexpr int numVersions{200};
+    ConfigurationHolder holder{makeConfig(1)};
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < numReaders; ++i)
+    {
+        readers.emplace_back([&holder, &done, &failures] {
+            std::uint64_t lastVersion{0};
+
+            while (done.load() == false)
+            {
+                const auto snapshot = holder.acquire();
+                const auto a = snapshot->lookupInt("", "a");
+
+                if (a != snapshot->lookupInt("app", "b") || static_cast<std::uint64_t>(a) != snapshot.version() ||
+                    snapshot.version() < lastVersion)
+                {
+                    ++failures;
+                }
+                lastVersion = snapshot.version();
+            }
+        });
+    }
+
+    for (int i = 2; i <= numVersions; ++i)
+    {
+        holder.publish(makeConfig(i));
+    }
+    done = true;
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_THAT(failures.load(), Eq(0));
+    EXPECT_THAT(holder.acquire()->lookupInt("", "a"), Eq(numVersions));
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+
+using namespace danek;
+using namespace testing;
+
+class ConversionCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "port = \"8080\";\n"
+                                                      "timeout = \"2 seconds\";\n"
+                                                      "size = \"2 MB\";\n"
+                                                      "ratio = \"0.5\";\n"
+                                                      "color = \"green\";\n"
+                                                      "invalid = \"abc\";\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(ConversionCacheTest, repeatedLookupsReturnSameValue)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+        EXPECT_THAT(cfg->lookupFloat("", "ratio"), FloatEq(0.5f));
+    }
+}
+
+TEST_F(ConversionCacheTest, differentConversionsOfSameItem)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_THAT(cfg->lookupDurationMilliseconds("", "timeout"), Eq(2000));
+        EXPECT_THAT(cfg->lookupDurationSeconds("", "timeout"), Eq(2));
+        EXPECT_THAT(cfg->lookupMemorySizeKB("", "size"), Eq(2048));
+        EXPECT_THAT(cfg->lookupMemorySizeMB("", "size"), Eq(2));
+    }
+}
+
+TEST_F(ConversionCacheTest, replacedItemIsConvertedAgain)
+{
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+    cfg->insertString("", "port", "9090");
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(9090));
+
+    const auto key = cfg->resolveKey("", "port");
+    EXPECT_THAT(cfg->lookupInt(key), Eq(9090));
+    cfg->insertString("", "port", "1");
+    EXPECT_THAT(cfg->lookupInt(key), Eq(1));
+}
+
+TEST_F(ConversionCacheTest, enumLookupsWithDifferentTables)
+{
+    const EnumNameAndValue colors[] = {{"red", 0}, {"green", 1}};
+    const EnumNameAndValue otherColors[] = {{"blue", 5}, {"red", 6}, {"green", 7}};
+    const EnumNameAndValue noGreen[] = {{"red", 0}, {"blue", 1}};
+
+    EXPECT_THAT(cfg->lookupEnum("", "color", "color", colors, 2), Eq(1));
+    EXPECT_THAT(cfg->lookupEnum("", "color", "color", otherColors, 3), Eq(7));
+    EXPECT_THAT(cfg->lookupEnum("", "color", "color", colors, 2), Eq(1));
+    EXPECT_THROW(cfg->lookupEnum("", "color", "color", noGreen, 2), ConfigurationException);
+    EXPECT_THROW(cfg->lookupEnum("", "color", "color", colors, 1), ConfigurationException);
+}
+
+TEST_F(ConversionCacheTest, invalidValuesThrowEveryTime)
+{
+    EXPECT_THROW(cfg->lookupInt("", "invalid"), ConfigurationException);
+    EXPECT_THROW(cfg->lookupInt("", "invalid"), ConfigurationException);
+    EXPECT_THROW(cfg->lookupBoolean("", "port"), ConfigurationException);
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+    EXPECT_THROW(cfg->lookupBoolean("", "port"), ConfigurationException);
+}
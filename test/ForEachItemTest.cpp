@@ -0,0 +1,129 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace danek;
+using namespace testing;
+
+class ForEachItemTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "port = \"8080\";\n"
+                                                      "app {\n"
+                                                      "  name = \"abc\";\n"
+                                                      "  values = [\"a\", \"b\"];\n"
+                                                      "  nested { level = \"3\"; }\n"
+                                                      "}\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    std::vector<std::string> namesOf(std::string_view scope, ConfType typeMask, bool recursive) const
+    {
+        std::vector<std::string> names;
+        cfg->forEachItem(scope, typeMask, recursive, [&names](const ItemRef& item) { names.emplace_back(item.name); });
+        return names;
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(ForEachItemTest, visitsItemsInInsertionOrder)
+{
+    EXPECT_THAT(namesOf("", ConfType::ScopesAndVars, true),
+                ElementsAre("port", "app", "app.name", "app.values", "app.nested", "app.nested.level"));
+    EXPECT_THAT(namesOf("", ConfType::ScopesAndVars, false), ElementsAre("port", "app"));
+}
+
+TEST_F(ForEachItemTest, namesAreRelativeToScope)
+{
+    EXPECT_THAT(namesOf("app", ConfType::ScopesAndVars, true), ElementsAre("name", "values", "nested", "nested.level"));
+    EXPECT_THAT(namesOf("app.nested", ConfType::String, true), ElementsAre("level"));
+}
+
+TEST_F(ForEachItemTest, typeMaskSelectsItems)
+{
+    EXPECT_THAT(namesOf("", ConfType::String, true), ElementsAre("port", "app.name", "app.nested.level"));
+    EXPECT_THAT(namesOf("", ConfType::Scope, true), ElementsAre("app", "app.nested"));
+    EXPECT_THAT(namesOf("", ConfType::List, true), ElementsAre("app.values"));
+}
+
+TEST_F(ForEachItemTest, itemsReferToValues)
+{
+    std::vector<std::tuple<ConfType, std::string, std::size_t>> items;
+    cfg->forEachItem("app", ConfType::ScopesAndVars, false, [&items](const ItemRef& item) {
+        items.emplace_back(item.type, item.stringValue, item.listValue.size());
+    });
+
+    using Item = std::tuple<ConfType, std::string, std::size_t>;
+    EXPECT_THAT(items, ElementsAre(Item{ConfType::String, "abc", 0}, Item{ConfType::List, "", 2}, Item{ConfType::Scope, "", 0}));
+}
+
+TEST_F(ForEachItemTest, matchesListedNames)
+{
+    StringVector listed;
+    cfg->listFullyScopedNames("app", "", ConfType::ScopesAndVars, true, listed);
+
+    auto names = namesOf("app", ConfType::ScopesAndVars, true);
+    std::sort(names.begin(), names.end());
+
+    for (auto& name : names)
+    {
+        name.insert(0, "app.");
+    }
+    EXPECT_THAT(names, ContainerEq(listed.get()));
+}
+
+TEST_F(ForEachItemTest, passesUnexpandedNames)
+{
+    cfg->parse(Configuration::SourceType::String, "ids { uid-entry { uid-x = \"1\"; } }\n");
+
+    std::vector<std::pair<std::string, std::string>> names;
+    cfg->forEachItem("ids", ConfType::ScopesAndVars, true, [&names](const ItemRef& item) {
+        names.emplace_back(item.name, item.unexpandedName);
+    });
+
+    ASSERT_THAT(names, SizeIs(2));
+    EXPECT_THAT(names[0].first, StartsWith("uid-0"));
+    EXPECT_THAT(names[0].second, Eq("uid-entry"));
+    EXPECT_THAT(names[1].second, Eq("uid-entry.uid-x"));
+}
+
+TEST_F(ForEachItemTest, scopeWhichIsNotAScopeThrows)
+{
+    EXPECT_THROW(namesOf("port", ConfType::ScopesAndVars, true), ConfigurationException);
+    EXPECT_THROW(namesOf("missing", ConfType::ScopesAndVars, true), ConfigurationException);
+}
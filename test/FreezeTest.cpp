@@ -0,0 +1,148 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <utility>
+
+using namespace danek;
+using namespace testing;
+
+class FreezeTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, input);
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    static constexpr const char* input = "port = \"8080\";\n"
+                                         "app {\n"
+                                         "  name = \"abc\";\n"
+                                         "  timeout = \"5 seconds\";\n"
+                                         "  enabled = \"true\";\n"
+                                         "  values = [\"a\", \"b\"];\n"
+                                         "  nested { level = \"3\"; }\n"
+                                         "}\n";
+
+    Configuration* cfg;
+};
+
+TEST_F(FreezeTest, configurationIsNotFrozenByDefault)
+{
+    EXPECT_FALSE(cfg->isFrozen());
+    cfg->freeze();
+    EXPECT_TRUE(cfg->isFrozen());
+}
+
+TEST_F(FreezeTest, lookupsOnFrozenConfiguration)
+{
+    cfg->freeze();
+
+    StringVector values;
+    cfg->lookupList("app", "values", values);
+
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+    EXPECT_THAT(cfg->lookupString("app", "name"), StrEq("abc"));
+    EXPECT_THAT(cfg->lookupDurationSeconds("app", "timeout"), Eq(5));
+    EXPECT_TRUE(cfg->lookupBoolean("app", "enabled"));
+    EXPECT_THAT(values.size(), Eq(2));
+    EXPECT_THAT(cfg->lookupInt("app.nested", "level"), Eq(3));
+    EXPECT_THAT(cfg->lookupInt("", ".app.nested.level"), Eq(3));
+    EXPECT_THAT(cfg->lookupInt("app", "missing", 7), Eq(7));
+    EXPECT_THROW(cfg->lookupInt("app", "missing"), ConfigurationException);
+}
+
+TEST_F(FreezeTest, frozenLookupsMatchUnfrozenLookups)
+{
+    const std::pair<std::string, std::string> names[] = {
+        {"", "port"}, {"app", "name"}, {"", "app.nested.level"}, {"app.nested", ""}, {"app.", ""},
+        {"app", "name."}, {"", ".app.name"}, {"", "app..name"}, {"", "."}, {"app", "."}, {"", "name"},
+        {"app", "nested.level"}, {"app.nested", "missing"}, {"", "port.x"}};
+
+    auto frozen = Configuration::create();
+    frozen->parse(Configuration::SourceType::String, input);
+    frozen->freeze();
+
+    for (const auto& [scope, localName] : names)
+    {
+        EXPECT_THAT(frozen->type(scope.c_str(), localName.c_str()), Eq(cfg->type(scope.c_str(), localName.c_str())))
+            << "'" << scope << "' + '" << localName << "'";
+    }
+    frozen->destroy();
+}
+
+TEST_F(FreezeTest, listingNamesOfFrozenConfiguration)
+{
+    cfg->freeze();
+
+    StringVector names;
+    cfg->listFullyScopedNames("app", "", ConfType::String, false, names);
+    EXPECT_THAT(names.size(), Eq(3));
+}
+
+TEST_F(FreezeTest, modificationOfFrozenConfigurationThrows)
+{
+    cfg->freeze();
+
+    EXPECT_THROW(cfg->insertString("", "port", "1"), ConfigurationException);
+    EXPECT_THROW(cfg->insertList("app", "values", std::vector<std::string>{"x"}), ConfigurationException);
+    EXPECT_THROW(cfg->ensureScopeExists("other", ""), ConfigurationException);
+    EXPECT_THROW(cfg->remove("", "port"), ConfigurationException);
+    EXPECT_THROW(cfg->parse(Configuration::SourceType::String, "x = \"1\";"), ConfigurationException);
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+}
+
+TEST_F(FreezeTest, emptyUnfreezesConfiguration)
+{
+    cfg->freeze();
+    cfg->empty();
+
+    EXPECT_FALSE(cfg->isFrozen());
+    EXPECT_THAT(cfg->type("", "port"), Eq(ConfType::NoValue));
+    cfg->insertString("", "port", "1");
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(1));
+}
+
+TEST_F(FreezeTest, frozenConfigurationUsesFallback)
+{
+    cfg->setFallbackConfiguration(Configuration::SourceType::String, "extra = \"42\";");
+    cfg->freeze();
+
+    EXPECT_THAT(cfg->lookupInt("", "extra"), Eq(42));
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+}
+
+TEST_F(FreezeTest, keysStayValidWhenFreezing)
+{
+    const auto key = cfg->resolveKey("app", "name");
+    cfg->freeze();
+    EXPECT_THAT(cfg->lookupString(key), StrEq("abc"));
+}
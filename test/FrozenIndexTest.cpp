@@ -0,0 +1,133 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/internal/FrozenIndex.h"
+#include "danek/internal/ConfigItem.h"
+#include "danek/internal/ConfigScope.h"
+#include <gmock/gmock.h>
+#include <array>
+
+using namespace danek;
+using namespace testing;
+
+class FrozenIndexTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ConfigScope* app;
+        ConfigScope* nested;
+
+        root.addOrReplaceString("port", "8080");
+        root.ensureScopeExists("app", app);
+        app->addOrReplaceString("name", "abc");
+        app->addOrReplaceList("values", {"a", "b"});
+        app->ensureScopeExists("nested", nested);
+        nested->addOrReplaceString("level", "3");
+    }
+
+    ConfigScope root{nullptr, ""};
+};
+
+TEST_F(FrozenIndexTest, indexesAllItems)
+{
+    const FrozenIndex index{root};
+    EXPECT_THAT(index.size(), Eq(6));
+}
+
+TEST_F(FrozenIndexTest, findItemsByFullyScopedName)
+{
+    const FrozenIndex index{root};
+
+    EXPECT_THAT(index.find({"", "port"}), Eq(root.findItem("port")));
+    EXPECT_THAT(index.find({"app", "name"})->stringVal(), StrEq("abc"));
+    EXPECT_THAT(index.find({"", "app.values"})->type(), Eq(ConfType::List));
+    EXPECT_THAT(index.find({"app.nested", "level"})->stringVal(), StrEq("3"));
+    EXPECT_THAT(index.find({"app.nested", ""})->type(), Eq(ConfType::Scope));
+}
+
+TEST_F(FrozenIndexTest, findReturnsNullptrForMissingItems)
+{
+    const FrozenIndex index{root};
+
+    EXPECT_THAT(index.find({"", "missing"}), Eq(nullptr));
+    EXPECT_THAT(index.find({"app", "nam"}), Eq(nullptr));
+    EXPECT_THAT(index.find({"app", "names"}), Eq(nullptr));
+    EXPECT_THAT(index.find({"", "name"}), Eq(nullptr));
+    EXPECT_THAT(index.find({"", "app..name"}), Eq(nullptr));
+    EXPECT_THAT(index.find({"", ""}), Eq(nullptr));
+}
+
+TEST_F(FrozenIndexTest, findIgnoresTrailingDot)
+{
+    const FrozenIndex index{root};
+
+    EXPECT_THAT(index.find({"app.", ""}), Eq(root.findItem("app")));
+    EXPECT_THAT(index.find({"app", "name."})->stringVal(), StrEq("abc"));
+}
+
+TEST_F(FrozenIndexTest, emptyScope)
+{
+    const ConfigScope empty{nullptr, ""};
+    const FrozenIndex index{empty};
+
+    EXPECT_THAT(index.size(), Eq(0));
+    EXPECT_THAT(index.find({"", "port"}), Eq(nullptr));
+}
+
+TEST_F(FrozenIndexTest, fallbackItemsAreKeptApart)
+{
+    ConfigScope fallback{nullptr, ""};
+    ConfigScope farFallback{nullptr, ""};
+    fallback.addOrReplaceString("port", "1");
+    fallback.addOrReplaceString("name", "fallback");
+    farFallback.addOrReplaceString("name", "far");
+    farFallback.addOrReplaceString("level", "4");
+
+    const std::array<const ConfigScope*, 2> fallbackRoots{&fallback, &farFallback};
+    const FrozenIndex index{root, fallbackRoots};
+
+    EXPECT_THAT(index.size(), Eq(8));
+    EXPECT_THAT(index.find({"", "port"}), Eq(root.findItem("port")));
+    EXPECT_THAT(index.find({"", "name"}), Eq(nullptr));
+    EXPECT_THAT(index.findInFallback({"", "port"}), Eq(fallback.findItem("port")));
+    EXPECT_THAT(index.findInFallback({"", "name"}), Eq(fallback.findItem("name")));
+    EXPECT_THAT(index.findInFallback({"app", "name"}), Eq(nullptr));
+}
+
+TEST_F(FrozenIndexTest, findWithFallbackUsesLocalNameInFallback)
+{
+    ConfigScope fallback{nullptr, ""};
+    fallback.addOrReplaceString("port", "1");
+    fallback.addOrReplaceString("level", "4");
+
+    const std::array<const ConfigScope*, 1> fallbackRoots{&fallback};
+    const FrozenIndex index{root, fallbackRoots};
+
+    EXPECT_THAT(index.findWithFallback({"", "port"}), Eq(root.findItem("port")));
+    EXPECT_THAT(index.findWithFallback({"app.nested", "level"})->stringVal(), StrEq("3"));
+    EXPECT_THAT(index.findWithFallback({"app", "level"}), Eq(fallback.findItem("level")));
+    EXPECT_THAT(index.findWithFallback({"", "level"}), Eq(fallback.findItem("level")));
+    EXPECT_THAT(index.findWithFallback({"", "app.level"}), Eq(nullptr));
+    EXPECT_THAT(index.findWithFallback({"app", "missing"}), Eq(nullptr));
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/internal/LexScan.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <string>
+
+using namespace danek::lex;
+using namespace testing;
+
+class LexScanTest : public testing::Test
+{
+protected:
+    //--------
+    // Places a single stop byte at every position of inputs longer
+    // than a block, so that both the vector loop and the scalar tail
+    // find it.
+    //--------
+    template <typename Kernel>
+    void expectStopAtEveryPosition(Kernel kernel, char fill, char stop)
+    {
+        for (std::size_t size = 0; size < 80; ++size)
+        {
+            const std::string plain(size, fill);
+            EXPECT_THAT(kernel(plain.data(), plain.data() + size), Eq(plain.data() + size)) << size;
+
+            for (std::size_t pos = 0; pos < size; ++pos)
+            {
+                std::string input = plain;
+                input[pos] = stop;
+                EXPECT_THAT(kernel(input.data(), input.data() + size), Eq(input.data() + pos)) << size << "/" << pos;
+            }
+        }
+    }
+};
+
+TEST_F(LexScanTest, skipSpaceStopsAtFirstNonSpace)
+{
+    expectStopAtEveryPosition(skipSpace, ' ', 'x');
+    expectStopAtEveryPosition(skipSpace, '\n', '#');
+    expectStopAtEveryPosition(skipSpace, '\t', '\xE2');
+}
+
+TEST_F(LexScanTest, skipSpaceSkipsAllAsciiWhiteSpace)
+{
+    const std::string input = " \t\n\v\f\r \t\n\v\f\r \t\n\v\f\r \t\n\v\f\r \t\n\v\f\r\x08";
+    EXPECT_THAT(skipSpace(input.data(), input.data() + input.size()), Eq(input.data() + input.size() - 1));
+
+    const std::string bounds = "\x0E";
+    EXPECT_THAT(skipSpace(bounds.data(), bounds.data() + bounds.size()), Eq(bounds.data()));
+}
+
+TEST_F(LexScanTest, findLineEndStopsAtNewlineOrNonAscii)
+{
+    expectStopAtEveryPosition(findLineEnd, 'c', '\n');
+    expectStopAtEveryPosition(findLineEnd, ' ', '\xC3');
+}
+
+TEST_F(LexScanTest, findStringSpecialStopsAtEveryStopByte)
+{
+    for (const char stop : {'"', '%', '\n', '\r', '\x80', '\xFF'})
+    {
+        expectStopAtEveryPosition(findStringSpecial, 'a', stop);
+    }
+}
+
+TEST_F(LexScanTest, findBlockStringSpecialStopsAtEveryStopByte)
+{
+    for (const char stop : {'%', '\r', '\x80', '\xF0'})
+    {
+        expectStopAtEveryPosition(findBlockStringSpecial, '\n', stop);
+    }
+}
+
+TEST_F(LexScanTest, countNewlinesCountsEveryNewline)
+{
+    std::string input;
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        input += (i % 3 == 0) ? '\n' : 'x';
+        const auto expected = std::count(input.begin(), input.end(), '\n');
+        EXPECT_THAT(countNewlines(input.data(), input.data() + input.size()), Eq(expected)) << i;
+    }
+}
@@ -111,3 +111,24 @@ TEST_F(LexTokenTest, resetWithFunctionType)
     EXPECT_THAT(t.spelling(), StrEq("xyz"));
     EXPECT_TRUE(t.isBoolFunc());
 }
+
+TEST_F(LexTokenTest, resetViewRefersToSpelling)
+{
+    const std::string source{"abc def"};
+    LexToken t;
+    t.resetView(lex::LEX_IDENT_SYM, 3, std::string_view{source}.substr(4), FunctionType::String);
+    EXPECT_THAT(t.spelling(), Eq("def"));
+    EXPECT_THAT(t.spelling().data(), Eq(source.data() + 4));
+    EXPECT_THAT(t.lineNum(), Eq(3));
+    EXPECT_TRUE(t.isStringFunc());
+}
+
+TEST_F(LexTokenTest, copyKeepsOwnedSpellingValid)
+{
+    LexToken t;
+    t.reset(lex::LEX_STRING_SYM, 1, "owned");
+    const LexToken copy = t;
+    t.reset(lex::LEX_STRING_SYM, 2, "other");
+    EXPECT_THAT(copy.spelling(), Eq("owned"));
+    EXPECT_THAT(t.spelling(), Eq("other"));
+}
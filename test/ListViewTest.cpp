@@ -0,0 +1,115 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+using namespace danek;
+using namespace testing;
+
+static_assert(std::random_access_iterator<ListView::Iterator>);
+
+class ListViewTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "name = \"abc\";\n"
+                                                      "app {\n"
+                                                      "  values = [\"a\", \"bc\", \"def\"];\n"
+                                                      "  none = [];\n"
+                                                      "}\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(ListViewTest, viewRefersToStoredList)
+{
+    const ListView values = cfg->lookupListView("app", "values");
+
+    EXPECT_THAT(values.size(), Eq(3));
+    EXPECT_THAT(values[1], Eq("bc"));
+    EXPECT_THAT(values.c_str(2), StrEq("def"));
+    EXPECT_THAT(std::vector<std::string_view>(values.begin(), values.end()), ElementsAre("a", "bc", "def"));
+    EXPECT_THAT(values.c_str(0), Eq(cfg->lookupListView("", "app.values").c_str(0)));
+}
+
+TEST_F(ListViewTest, iteratorsAreRandomAccess)
+{
+    const ListView values = cfg->lookupListView("app", "values");
+    auto it = values.begin();
+
+    EXPECT_THAT(values.end() - it, Eq(3));
+    EXPECT_THAT(*(it + 2), Eq("def"));
+    EXPECT_THAT(it[1], Eq("bc"));
+    EXPECT_THAT(*--values.end(), Eq("def"));
+    EXPECT_TRUE(it < values.end());
+    EXPECT_THAT(std::ranges::find(values, "bc") - values.begin(), Eq(1));
+}
+
+TEST_F(ListViewTest, emptyList)
+{
+    const ListView values = cfg->lookupListView("app", "none");
+
+    EXPECT_TRUE(values.empty());
+    EXPECT_THAT(values.begin(), Eq(values.end()));
+}
+
+TEST_F(ListViewTest, missingListUsesDefault)
+{
+    const ListView defaultList = cfg->lookupListView("app", "values");
+
+    EXPECT_TRUE(cfg->lookupListView("app", "missing", {}).empty());
+    EXPECT_THAT(cfg->lookupListView("app", "missing", defaultList).size(), Eq(3));
+    EXPECT_THROW(cfg->lookupListView("app", "missing"), ConfigurationException);
+}
+
+TEST_F(ListViewTest, lookupOfOtherTypesThrows)
+{
+    EXPECT_THROW(cfg->lookupListView("", "name"), ConfigurationException);
+    EXPECT_THROW(cfg->lookupListView("", "app"), ConfigurationException);
+    EXPECT_THROW(cfg->lookupListView("", "name", {}), ConfigurationException);
+}
+
+TEST_F(ListViewTest, lookupByKeyAndScopeView)
+{
+    const auto key = cfg->resolveKey("app", "values");
+    const auto view = cfg->scopeView("app");
+
+    EXPECT_THAT(cfg->lookupListView(key).size(), Eq(3));
+    EXPECT_THAT(cfg->lookupListView(cfg->resolveKey("app", "missing"), {}).size(), Eq(0));
+    EXPECT_THAT(view.lookupListView("values")[0], Eq("a"));
+    EXPECT_TRUE(view.lookupListView("missing", {}).empty());
+    EXPECT_THROW(view.lookupListView("missing"), ConfigurationException);
+}
@@ -0,0 +1,219 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+
+using namespace danek;
+using namespace testing;
+
+namespace
+{
+    std::size_t allocationCount{0};
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocationCount;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr)
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+class LookupAllocationTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "port = \"8080\";\n"
+                                                      "app {\n"
+                                                      "  name = \"abc\";\n"
+                                                      "  timeout = \"5 seconds\";\n"
+                                                      "  size = \"2 MB\";\n"
+                                                      "  enabled = \"true\";\n"
+                                                      "  ratio = \"0.5\";\n"
+                                                      "  nested { level = \"3\"; }\n"
+                                                      "}\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    template <class Fn>
+    std::size_t allocationsOf(Fn fn)
+    {
+        const std::size_t before = allocationCount;
+        fn();
+        return allocationCount - before;
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(LookupAllocationTest, lookupOfExistingEntryDoesNotAllocate)
+{
+    const char* name = nullptr;
+    int port = 0;
+    float ratio = 0.0f;
+    bool enabled = false;
+    int level = 0;
+
+    const auto count = allocationsOf([&] {
+        name = cfg->lookupString("app", "name");
+        port = cfg->lookupInt("", "port");
+        ratio = cfg->lookupFloat("app", "ratio");
+        enabled = cfg->lookupBoolean("app", "enabled");
+        level = cfg->lookupInt("app.nested", "level");
+    });
+
+    EXPECT_THAT(count, Eq(0));
+    EXPECT_THAT(name, StrEq("abc"));
+    EXPECT_THAT(port, Eq(8080));
+    EXPECT_THAT(ratio, FloatEq(0.5f));
+    EXPECT_TRUE(enabled);
+    EXPECT_THAT(level, Eq(3));
+}
+
+TEST_F(LookupAllocationTest, lookupWithUnitsDoesNotAllocate)
+{
+    int seconds = 0;
+    int milliseconds = 0;
+    int bytes = 0;
+    int kiloBytes = 0;
+    int megaBytes = 0;
+
+    const auto count = allocationsOf([&] {
+        seconds = cfg->lookupDurationSeconds("app", "timeout");
+        milliseconds = cfg->lookupDurationMilliseconds("app", "timeout");
+        bytes = cfg->lookupMemorySizeBytes("app", "size");
+        kiloBytes = cfg->lookupMemorySizeKB("app", "size");
+        megaBytes = cfg->lookupMemorySizeMB("app", "size");
+    });
+
+    EXPECT_THAT(count, Eq(0));
+    EXPECT_THAT(seconds, Eq(5));
+    EXPECT_THAT(milliseconds, Eq(5000));
+    EXPECT_THAT(bytes, Eq(2 * 1024 * 1024));
+    EXPECT_THAT(kiloBytes, Eq(2048));
+    EXPECT_THAT(megaBytes, Eq(2));
+}
+
+TEST_F(LookupAllocationTest, lookupByStringViewDoesNotAllocate)
+{
+    constexpr std::string_view buffer{"app.nested.level"};
+    std::string_view name;
+    int level = 0;
+
+    const auto count = allocationsOf([&] {
+        name = cfg->lookupString(buffer.substr(0, 3), std::string_view{"name"});
+        level = cfg->lookupInt(buffer.substr(0, 10), buffer.substr(11));
+    });
+
+    EXPECT_THAT(count, Eq(0));
+    EXPECT_THAT(name, Eq("abc"));
+    EXPECT_THAT(level, Eq(3));
+}
+
+TEST_F(LookupAllocationTest, typeDoesNotAllocate)
+{
+    ConfType scopeType = ConfType::NoValue;
+    ConfType stringType = ConfType::NoValue;
+    ConfType missingType = ConfType::String;
+
+    const auto count = allocationsOf([&] {
+        scopeType = cfg->type("", "app");
+        stringType = cfg->type("app.nested", "level");
+        missingType = cfg->type("app", "missing");
+    });
+
+    EXPECT_THAT(count, Eq(0));
+    EXPECT_THAT(scopeType, Eq(ConfType::Scope));
+    EXPECT_THAT(stringType, Eq(ConfType::String));
+    EXPECT_THAT(missingType, Eq(ConfType::NoValue));
+}
+
+TEST_F(LookupAllocationTest, lookupOfMissingEntryWithDefaultDoesNotAllocate)
+{
+    const char* name = nullptr;
+    int value = 0;
+    int duration = 0;
+    bool flag = false;
+
+    const auto count = allocationsOf([&] {
+        name = cfg->lookupString("app", "missing", "default");
+        value = cfg->lookupInt("app", "missing", 7);
+        duration = cfg->lookupDurationSeconds("app", "missing", 9);
+        flag = cfg->lookupBoolean("app", "missing", true);
+    });
+
+    EXPECT_THAT(count, Eq(0));
+    EXPECT_THAT(name, StrEq("default"));
+    EXPECT_THAT(value, Eq(7));
+    EXPECT_THAT(duration, Eq(9));
+    EXPECT_TRUE(flag);
+}
+
+TEST_F(LookupAllocationTest, lookupInFallbackDoesNotAllocate)
+{
+    auto fallback = Configuration::create();
+    fallback->parse(Configuration::SourceType::String, "retries = \"4\";");
+    cfg->setFallbackConfiguration(fallback);
+    int retries = 0;
+
+    const auto count = allocationsOf([&] { retries = cfg->lookupInt("app", "retries"); });
+
+    EXPECT_THAT(count, Eq(0));
+    EXPECT_THAT(retries, Eq(4));
+    cfg->setFallbackConfiguration(nullptr);
+    fallback->destroy();
+}
+
+TEST_F(LookupAllocationTest, lookupThroughStaleKeyDoesNotAllocate)
+{
+    const auto key = cfg->resolveKey("app", "name");
+    cfg->insertString("", "other", "x");
+    const char* name = nullptr;
+
+    const auto count = allocationsOf([&] { name = cfg->lookupString(key); });
+
+    EXPECT_THAT(count, Eq(0));
+    EXPECT_THAT(name, StrEq("abc"));
+}
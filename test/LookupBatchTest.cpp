@@ -0,0 +1,170 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <array>
+
+using namespace danek;
+using namespace testing;
+
+class LookupBatchTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "app {\n"
+                                                      "  name = \"abc\";\n"
+                                                      "  port = \"8080\";\n"
+                                                      "  ratio = \"0.5\";\n"
+                                                      "  enabled = \"true\";\n"
+                                                      "  timeout = \"2 seconds\";\n"
+                                                      "  size = \"2 KB\";\n"
+                                                      "  values = [\"a\", \"b\"];\n"
+                                                      "  nested { level = \"3\"; }\n"
+                                                      "}\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(LookupBatchTest, lookupAllTypes)
+{
+    using Type = LookupRequest::Type;
+    std::string_view name;
+    std::vector<std::string> values;
+    int port{0};
+    float ratio{0.0f};
+    bool enabled{false};
+    int timeoutMs{0};
+    int timeoutSec{0};
+    int size{0};
+    int level{0};
+
+    std::array requests{LookupRequest{"name", Type::String, &name},
+                        LookupRequest{"values", Type::List, &values},
+                        LookupRequest{"port", Type::Int, &port},
+                        LookupRequest{"ratio", Type::Float, &ratio},
+                        LookupRequest{"enabled", Type::Boolean, &enabled},
+                        LookupRequest{"timeout", Type::DurationMilliseconds, &timeoutMs},
+                        LookupRequest{"timeout", Type::DurationSeconds, &timeoutSec},
+                        LookupRequest{"size", Type::MemorySizeBytes, &size},
+                        LookupRequest{"nested.level", Type::Int, &level}};
+
+    EXPECT_THAT(cfg->lookupBatch("app", requests), Eq(0));
+    EXPECT_THAT(name, Eq("abc"));
+    EXPECT_THAT(values, ElementsAre("a", "b"));
+    EXPECT_THAT(port, Eq(8080));
+    EXPECT_THAT(ratio, FloatEq(0.5f));
+    EXPECT_TRUE(enabled);
+    EXPECT_THAT(timeoutMs, Eq(2000));
+    EXPECT_THAT(timeoutSec, Eq(2));
+    EXPECT_THAT(size, Eq(2048));
+    EXPECT_THAT(level, Eq(3));
+
+    for (const auto& request : requests)
+    {
+        EXPECT_THAT(request.status, Eq(LookupRequest::Status::Found));
+        EXPECT_THAT(request.error, IsEmpty());
+    }
+}
+
+TEST_F(LookupBatchTest, errorsAreReportedPerEntry)
+{
+    using Type = LookupRequest::Type;
+    int missing{0};
+    int invalid{0};
+    int port{0};
+    std::string_view wrongType;
+
+    std::array requests{LookupRequest{"missing", Type::Int, &missing},
+                        LookupRequest{"name", Type::Int, &invalid},
+                        LookupRequest{"values", Type::String, &wrongType},
+                        LookupRequest{"port", Type::Int, &port}};
+
+    EXPECT_THAT(cfg->lookupBatch("app", requests), Eq(3));
+    EXPECT_THAT(requests[0].status, Eq(LookupRequest::Status::Missing));
+    EXPECT_THAT(requests[0].error, HasSubstr("app.missing"));
+    EXPECT_THAT(requests[1].status, Eq(LookupRequest::Status::Invalid));
+    EXPECT_THAT(requests[2].status, Eq(LookupRequest::Status::Invalid));
+    EXPECT_THAT(requests[2].error, HasSubstr("is a list instead of a string"));
+    EXPECT_THAT(requests[3].status, Eq(LookupRequest::Status::Found));
+    EXPECT_THAT(port, Eq(8080));
+}
+
+TEST_F(LookupBatchTest, optionalEntriesKeepDefault)
+{
+    int workers{4};
+    std::array requests{LookupRequest{"workers", LookupRequest::Type::Int, &workers, false}};
+
+    EXPECT_THAT(cfg->lookupBatch("app", requests), Eq(0));
+    EXPECT_THAT(requests[0].status, Eq(LookupRequest::Status::Defaulted));
+    EXPECT_THAT(workers, Eq(4));
+}
+
+TEST_F(LookupBatchTest, destinationOfWrongTypeIsInvalid)
+{
+    float port{0.0f};
+    std::array requests{LookupRequest{"port", LookupRequest::Type::Int, &port}};
+
+    EXPECT_THAT(cfg->lookupBatch("app", requests), Eq(1));
+    EXPECT_THAT(requests[0].status, Eq(LookupRequest::Status::Invalid));
+}
+
+TEST_F(LookupBatchTest, missingScopeUsesFallback)
+{
+    cfg->setFallbackConfiguration(Configuration::SourceType::String, "port = \"1\";");
+    int port{0};
+    std::array requests{LookupRequest{"port", LookupRequest::Type::Int, &port}};
+
+    EXPECT_THAT(cfg->lookupBatch("other", requests), Eq(0));
+    EXPECT_THAT(port, Eq(1));
+}
+
+TEST_F(LookupBatchTest, resultsMatchSingleLookups)
+{
+    const std::pair<std::string, std::string> names[] = {
+        {"", "app.port"}, {"app", "port"}, {".app", "port"}, {"app.", "port"}, {"app..x", "port"},
+        {"app", ".port"}, {"app", "port."}, {"app", ""}, {"app.nested", "level"}, {"app.name", "x"}};
+
+    for (const auto& [scope, localName] : names)
+    {
+        int value{0};
+        std::array requests{LookupRequest{localName, LookupRequest::Type::Int, &value}};
+        cfg->lookupBatch(scope, requests);
+
+        const bool found = (cfg->type(scope.c_str(), localName.c_str()) == ConfType::String);
+        EXPECT_THAT(requests[0].status == LookupRequest::Status::Found, Eq(found)) << "'" << scope << "' + '" << localName << "'";
+    }
+}
+
+TEST_F(LookupBatchTest, emptyBatch)
+{
+    EXPECT_THAT(cfg->lookupBatch("app", {}), Eq(0));
+}
@@ -0,0 +1,200 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <memory_resource>
+
+using namespace danek;
+using namespace testing;
+
+namespace
+{
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t allocations() const
+        {
+            return m_allocations;
+        }
+
+        std::size_t bytesInUse() const
+        {
+            return m_bytesInUse;
+        }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++m_allocations;
+            m_bytesInUse += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            m_bytesInUse -= bytes;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        std::size_t m_allocations{0};
+        std::size_t m_bytesInUse{0};
+    };
+
+    class DefaultResourceGuard
+    {
+    public:
+        explicit DefaultResourceGuard(std::pmr::memory_resource* resource)
+            : m_previous(std::pmr::set_default_resource(resource))
+        {
+        }
+
+        ~DefaultResourceGuard()
+        {
+            std::pmr::set_default_resource(m_previous);
+        }
+
+    private:
+        std::pmr::memory_resource* m_previous;
+    };
+
+    constexpr const char* input = "port = \"8080\";\n"
+                                  "app {\n"
+                                  "  name = \"a name which is too long for small string optimization\";\n"
+                                  "  values = [\"a\", \"b\", \"c\"];\n"
+                                  "  nested { level = \"3\"; }\n"
+                                  "}\n";
+}
+
+class MemoryResourceTest : public testing::Test
+{
+protected:
+    void parseAndCheck(Configuration* cfg)
+    {
+        cfg->parse(Configuration::SourceType::String, input);
+
+        StringVector values;
+        cfg->lookupList("app", "values", values);
+
+        EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+        EXPECT_THAT(cfg->lookupString("app", "name"), StrEq("a name which is too long for small string optimization"));
+        EXPECT_THAT(values.size(), Eq(3));
+        EXPECT_THAT(cfg->lookupInt("app.nested", "level"), Eq(3));
+    }
+
+    CountingResource resource;
+};
+
+TEST_F(MemoryResourceTest, parseAllocatesFromCallerResource)
+{
+    auto cfg = Configuration::create(&resource);
+    const auto initial = resource.allocations();
+
+    parseAndCheck(cfg);
+    EXPECT_THAT(resource.allocations(), Gt(initial));
+    cfg->destroy();
+}
+
+TEST_F(MemoryResourceTest, destroyReturnsAllMemoryToCallerResource)
+{
+    auto cfg = Configuration::create(&resource);
+    parseAndCheck(cfg);
+    EXPECT_THAT(resource.bytesInUse(), Gt(0));
+
+    cfg->destroy();
+    EXPECT_THAT(resource.bytesInUse(), Eq(0));
+}
+
+TEST_F(MemoryResourceTest, emptyReturnsMemoryToCallerResource)
+{
+    auto cfg = Configuration::create(&resource);
+    const auto initial = resource.bytesInUse();
+    parseAndCheck(cfg);
+
+    cfg->empty();
+    EXPECT_THAT(resource.bytesInUse(), Eq(initial));
+    EXPECT_THAT(cfg->type("", "port"), Eq(ConfType::NoValue));
+    cfg->destroy();
+}
+
+TEST_F(MemoryResourceTest, heapModeAllocatesFromDefaultResource)
+{
+    const DefaultResourceGuard guard{&resource};
+    auto cfg = Configuration::create(Configuration::AllocationMode::Heap);
+
+    parseAndCheck(cfg);
+    EXPECT_THAT(resource.allocations(), Gt(0));
+    cfg->destroy();
+    EXPECT_THAT(resource.bytesInUse(), Eq(0));
+}
+
+TEST_F(MemoryResourceTest, arenaModeAllocatesInFewerBlocks)
+{
+    const DefaultResourceGuard guard{&resource};
+    auto heap = Configuration::create(Configuration::AllocationMode::Heap);
+    parseAndCheck(heap);
+    const auto heapAllocations = resource.allocations();
+    heap->destroy();
+
+    CountingResource arenaUpstream;
+    std::pmr::set_default_resource(&arenaUpstream);
+    auto arena = Configuration::create(Configuration::AllocationMode::Arena);
+    parseAndCheck(arena);
+
+    EXPECT_THAT(arenaUpstream.allocations(), Lt(heapAllocations));
+    arena->destroy();
+    EXPECT_THAT(arenaUpstream.bytesInUse(), Eq(0));
+}
+
+TEST_F(MemoryResourceTest, arenaModeCreatesRootScopeOnlyOnArena)
+{
+    const DefaultResourceGuard guard{&resource};
+    auto heap = Configuration::create(Configuration::AllocationMode::Heap);
+    const auto heapAllocations = resource.allocations();
+    heap->destroy();
+
+    CountingResource arenaUpstream;
+    std::pmr::set_default_resource(&arenaUpstream);
+    auto arena = Configuration::create(Configuration::AllocationMode::Arena);
+
+    EXPECT_THAT(arenaUpstream.allocations(), Lt(heapAllocations));
+    arena->destroy();
+    EXPECT_THAT(arenaUpstream.bytesInUse(), Eq(0));
+}
+
+TEST_F(MemoryResourceTest, arenaModeEmptyAndReparse)
+{
+    auto cfg = Configuration::create(Configuration::AllocationMode::Arena);
+    parseAndCheck(cfg);
+
+    cfg->empty();
+    EXPECT_THAT(cfg->type("app", "name"), Eq(ConfType::NoValue));
+
+    parseAndCheck(cfg);
+    cfg->destroy();
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include "danek/LookupRequest.h"
+#include "danek/ScopeView.h"
+#include <gmock/gmock.h>
+#include <array>
+#include <string>
+#include <utility>
+
+using namespace danek;
+using namespace testing;
+
+class MergedIndexTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, input);
+        cfg->setFallbackConfiguration(Configuration::SourceType::String, fallbackInput);
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    static constexpr const char* input = "port = \"8080\";\n"
+                                         "app { name = \"abc\"; nested { level = \"3\"; } }\n";
+    static constexpr const char* fallbackInput = "port = \"1\";\n"
+                                                 "timeout = \"5\";\n"
+                                                 "name = \"fallback\";\n"
+                                                 "level = \"4\";\n"
+                                                 "app { extra = \"6\"; }\n";
+
+    Configuration* cfg;
+};
+
+TEST_F(MergedIndexTest, mergedIndexIsDisabledByDefault)
+{
+    EXPECT_FALSE(cfg->isMergedIndexEnabled());
+    cfg->setMergedIndex(true);
+    EXPECT_TRUE(cfg->isMergedIndexEnabled());
+    cfg->setMergedIndex(false);
+    EXPECT_FALSE(cfg->isMergedIndexEnabled());
+}
+
+TEST_F(MergedIndexTest, lookupsMatchLookupsWithoutIndex)
+{
+    const std::pair<std::string, std::string> names[] = {
+        {"", "port"}, {"", "timeout"}, {"app", "name"}, {"app", "timeout"}, {"app.nested", "level"},
+        {"app", "extra"}, {"", "app.extra"}, {"", "app"}, {"app.nested", ""}, {"app.", ""}, {"app", "name."},
+        {"", ".app.name"}, {"app", ".timeout"}, {"", "app..name"}, {"", "."}, {"app", "."}, {"", "missing"},
+        {"app", "nested.level"}, {"app.nested", "missing"}, {"", "port.x"}, {"x.y", "timeout"}};
+
+    auto indexed = Configuration::create();
+    indexed->parse(Configuration::SourceType::String, input);
+    indexed->setFallbackConfiguration(Configuration::SourceType::String, fallbackInput);
+    indexed->setMergedIndex(true);
+
+    for (const auto& [scope, localName] : names)
+    {
+        const auto type = cfg->type(scope.c_str(), localName.c_str());
+        EXPECT_THAT(indexed->type(scope.c_str(), localName.c_str()), Eq(type)) << "'" << scope << "' + '" << localName << "'";
+
+        if (type == ConfType::String)
+        {
+            EXPECT_THAT(indexed->lookupString(scope.c_str(), localName.c_str()),
+                        StrEq(cfg->lookupString(scope.c_str(), localName.c_str())))
+                << "'" << scope << "' + '" << localName << "'";
+        }
+    }
+    indexed->destroy();
+}
+
+TEST_F(MergedIndexTest, configurationTakesPrecedenceOverFallback)
+{
+    cfg->setMergedIndex(true);
+
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+    EXPECT_THAT(cfg->lookupString("app", "name"), StrEq("abc"));
+    EXPECT_THAT(cfg->lookupInt("app", "timeout"), Eq(5));
+    EXPECT_THAT(cfg->lookupString("", "name"), StrEq("fallback"));
+}
+
+TEST_F(MergedIndexTest, nearerFallbackTakesPrecedence)
+{
+    auto fallback = Configuration::create();
+    fallback->parse(Configuration::SourceType::String, "timeout = \"7\";");
+    fallback->setFallbackConfiguration(Configuration::SourceType::String, "timeout = \"8\"; retries = \"9\";");
+    cfg->setFallbackConfiguration(fallback);
+    cfg->setMergedIndex(true);
+
+    EXPECT_THAT(cfg->lookupInt("app", "timeout"), Eq(7));
+    EXPECT_THAT(cfg->lookupInt("app", "retries"), Eq(9));
+
+    cfg->destroy();
+    cfg = fallback;
+}
+
+TEST_F(MergedIndexTest, indexIsRefreshedWhenConfigurationChanges)
+{
+    cfg->setMergedIndex(true);
+    EXPECT_THAT(cfg->lookupInt("app", "timeout"), Eq(5));
+
+    cfg->insertString("app", "timeout", "10");
+    EXPECT_THAT(cfg->lookupInt("app", "timeout"), Eq(10));
+
+    cfg->remove("app", "timeout");
+    EXPECT_THAT(cfg->lookupInt("app", "timeout"), Eq(5));
+
+    cfg->parse(Configuration::SourceType::String, "app { timeout = \"11\"; }");
+    EXPECT_THAT(cfg->lookupInt("app", "timeout"), Eq(11));
+}
+
+TEST_F(MergedIndexTest, indexIsRefreshedWhenFallbackChanges)
+{
+    auto fallback = Configuration::create();
+    fallback->parse(Configuration::SourceType::String, "timeout = \"7\";");
+    cfg->setFallbackConfiguration(fallback);
+    cfg->setMergedIndex(true);
+    EXPECT_THAT(cfg->lookupInt("app", "timeout"), Eq(7));
+
+    fallback->insertString("", "timeout", "12");
+    EXPECT_THAT(cfg->lookupInt("app", "timeout"), Eq(12));
+
+    fallback->parse(Configuration::SourceType::String, "retries = \"3\";");
+    EXPECT_THAT(cfg->lookupInt("app", "retries"), Eq(3));
+
+    fallback->destroy();
+    EXPECT_THAT(cfg->type("app", "timeout"), Eq(ConfType::NoValue));
+}
+
+TEST_F(MergedIndexTest, batchAndScopeViewLookupsUseFallback)
+{
+    cfg->setMergedIndex(true);
+
+    int timeout{0};
+    int level{0};
+    std::array requests{LookupRequest{"timeout", LookupRequest::Type::Int, &timeout},
+                        LookupRequest{"nested.level", LookupRequest::Type::Int, &level}};
+
+    EXPECT_THAT(cfg->lookupBatch("app", requests), Eq(0));
+    EXPECT_THAT(timeout, Eq(5));
+    EXPECT_THAT(level, Eq(3));
+    EXPECT_THAT(cfg->scopeView("app.nested").lookupInt("timeout"), Eq(5));
+}
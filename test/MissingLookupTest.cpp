@@ -0,0 +1,103 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+
+using namespace danek;
+using namespace testing;
+
+class MissingLookupTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "port = \"8080\";\n"
+                                                      "app { name = \"abc\"; nested { level = \"3\"; } }\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    // Enough lookups of absent names to have them skip the scopes afterwards
+    void lookupMissingNames()
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            EXPECT_THAT(cfg->lookupInt("app", std::string{"missing_"}.append(std::to_string(i)).c_str(), -1), Eq(-1));
+        }
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(MissingLookupTest, existingNamesAreStillFound)
+{
+    lookupMissingNames();
+
+    EXPECT_THAT(cfg->lookupInt("", "port"), Eq(8080));
+    EXPECT_THAT(cfg->lookupString("app", "name"), StrEq("abc"));
+    EXPECT_THAT(cfg->lookupInt("app.nested", "level"), Eq(3));
+    EXPECT_THAT(cfg->lookupInt("", ".app.nested.level"), Eq(3));
+    EXPECT_THAT(cfg->type("app", "nested."), Eq(ConfType::Scope));
+    EXPECT_THAT(cfg->type("app..nested", "level"), Eq(ConfType::NoValue));
+}
+
+TEST_F(MissingLookupTest, insertedNamesAreFound)
+{
+    lookupMissingNames();
+    cfg->insertString("app", "inserted", "5");
+    EXPECT_THAT(cfg->lookupInt("app", "inserted", -1), Eq(5));
+
+    lookupMissingNames();
+    cfg->parse(Configuration::SourceType::String, "app { parsed = \"6\"; }");
+    EXPECT_THAT(cfg->lookupInt("app", "parsed", -1), Eq(6));
+}
+
+TEST_F(MissingLookupTest, removedNamesAreMissing)
+{
+    lookupMissingNames();
+    cfg->remove("app", "name");
+    EXPECT_THAT(cfg->type("app", "name"), Eq(ConfType::NoValue));
+}
+
+TEST_F(MissingLookupTest, fallbackConfigurationIsSearched)
+{
+    cfg->setFallbackConfiguration(Configuration::SourceType::String, "workers = \"4\";");
+    lookupMissingNames();
+
+    EXPECT_THAT(cfg->lookupInt("app", "workers", -1), Eq(4));
+}
+
+TEST_F(MissingLookupTest, lookupsWhileParsing)
+{
+    lookupMissingNames();
+    cfg->parse(Configuration::SourceType::String, "a = \"1\";\n"
+                                                  "b = a;\n"
+                                                  "c = b;\n");
+
+    EXPECT_THAT(cfg->lookupInt("", "c"), Eq(1));
+}
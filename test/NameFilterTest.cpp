@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/internal/NameFilter.h"
+#include "danek/internal/ConfigItem.h"
+#include "danek/internal/ConfigScope.h"
+#include <gmock/gmock.h>
+
+using namespace danek;
+using namespace testing;
+
+class NameFilterTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ConfigScope* app;
+        ConfigScope* nested;
+
+        root.addOrReplaceString("port", "8080");
+        root.ensureScopeExists("app", app);
+        app->addOrReplaceString("name", "abc");
+        app->addOrReplaceList("values", {"a", "b"});
+        app->ensureScopeExists("nested", nested);
+        nested->addOrReplaceString("level", "3");
+    }
+
+    ConfigScope root{nullptr, ""};
+};
+
+TEST_F(NameFilterTest, containsAllItems)
+{
+    const NameFilter filter{root};
+
+    EXPECT_THAT(filter.size(), Eq(6));
+    EXPECT_TRUE(filter.mayContain(util::ScopedName{"", "port"}.hash()));
+    EXPECT_TRUE(filter.mayContain(util::ScopedName{"", "app"}.hash()));
+    EXPECT_TRUE(filter.mayContain(util::ScopedName{"app", "name"}.hash()));
+    EXPECT_TRUE(filter.mayContain(util::ScopedName{"app", "values"}.hash()));
+    EXPECT_TRUE(filter.mayContain(util::ScopedName{"app.nested", ""}.hash()));
+    EXPECT_TRUE(filter.mayContain(util::ScopedName{"", "app.nested.level"}.hash()));
+}
+
+TEST_F(NameFilterTest, rejectsMostAbsentNames)
+{
+    ConfigScope* many;
+    root.ensureScopeExists("many", many);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        many->addOrReplaceString(std::string{"entry_"}.append(std::to_string(i)), "x");
+    }
+
+    const NameFilter filter{root};
+    int falsePositives{0};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_TRUE(filter.mayContain(util::ScopedName{"many", std::string{"entry_"}.append(std::to_string(i))}.hash()));
+
+        if (filter.mayContain(util::ScopedName{"many", std::string{"missing_"}.append(std::to_string(i))}.hash()) == true)
+        {
+            ++falsePositives;
+        }
+    }
+    EXPECT_THAT(falsePositives, Lt(50));
+}
+
+TEST_F(NameFilterTest, emptyScope)
+{
+    const ConfigScope empty{nullptr, ""};
+    const NameFilter filter{empty};
+
+    EXPECT_THAT(filter.size(), Eq(0));
+    EXPECT_FALSE(filter.mayContain(util::ScopedName{"", "port"}.hash()));
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/GlobPattern.h"
+#include "danek/PatternMatch.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+using danek::GlobPattern;
+using danek::patternMatch;
+using namespace testing;
+
+class PatternMatchTest : public testing::Test
+{
+};
+
+TEST_F(PatternMatchTest, patternWithoutWildcardMatchesExactly)
+{
+    EXPECT_TRUE(patternMatch("abc", "abc"));
+    EXPECT_TRUE(patternMatch("", ""));
+    EXPECT_FALSE(patternMatch("abc", "ab"));
+    EXPECT_FALSE(patternMatch("ab", "abc"));
+    EXPECT_FALSE(patternMatch("", "a"));
+}
+
+TEST_F(PatternMatchTest, wildcardMatchesZeroOrMoreCharacters)
+{
+    EXPECT_TRUE(patternMatch("", "*"));
+    EXPECT_TRUE(patternMatch("abc", "*"));
+    EXPECT_TRUE(patternMatch("abc", "a*"));
+    EXPECT_TRUE(patternMatch("abc", "*c"));
+    EXPECT_TRUE(patternMatch("abc", "a*c"));
+    EXPECT_TRUE(patternMatch("ac", "a*c"));
+    EXPECT_TRUE(patternMatch("abc", "a**c"));
+    EXPECT_TRUE(patternMatch("abc", "*b*"));
+    EXPECT_FALSE(patternMatch("abc", "*d*"));
+    EXPECT_FALSE(patternMatch("abc", "b*"));
+    EXPECT_FALSE(patternMatch("abc", "*b"));
+    EXPECT_FALSE(patternMatch("a", "a*a"));
+}
+
+TEST_F(PatternMatchTest, piecesMatchInOrder)
+{
+    EXPECT_TRUE(patternMatch("xaybzc", "*a*b*c"));
+    EXPECT_TRUE(patternMatch("aaab", "*a*a*a*b"));
+    EXPECT_TRUE(patternMatch("abab", "a*b*b"));
+    EXPECT_FALSE(patternMatch("xbyazc", "*a*b*c"));
+    EXPECT_FALSE(patternMatch("aab", "*a*a*a*b"));
+    EXPECT_FALSE(patternMatch("aba", "a*b*b"));
+}
+
+TEST_F(PatternMatchTest, prefixAndSuffixDoNotOverlap)
+{
+    EXPECT_FALSE(patternMatch("aba", "aba*aba"));
+    EXPECT_TRUE(patternMatch("abaaba", "aba*aba"));
+    EXPECT_TRUE(patternMatch("ababa", "ab*ba"));
+    EXPECT_FALSE(patternMatch("aba", "ab*ba"));
+}
+
+TEST_F(PatternMatchTest, matchesMultiByteCharacters)
+{
+    EXPECT_TRUE(patternMatch("gr\xc3\xbc\xc3\x9f" "e", "gr*e"));
+    EXPECT_TRUE(patternMatch("gr\xc3\xbc\xc3\x9f" "e", "*\xc3\x9f*"));
+    EXPECT_FALSE(patternMatch("gr\xc3\xbc\xc3\x9f" "e", "*\xc3\xbc" "e"));
+}
+
+TEST_F(PatternMatchTest, compiledPatternMatchesLikePatternMatch)
+{
+    const std::vector<std::string> patterns{"", "*", "a", "a*", "*a", "a*b", "*a*b*", "a**b", "ab*ba", "*a*a*a*b"};
+    const std::vector<std::string> strings{"", "a", "b", "ab", "ba", "aab", "abba", "ababa", "xaaab", "aaaa"};
+
+    for (const auto& pattern : patterns)
+    {
+        const GlobPattern glob{pattern};
+
+        for (const auto& str : strings)
+        {
+            EXPECT_THAT(glob.matches(str), Eq(patternMatch(str.c_str(), pattern.c_str())))
+                << "'" << str << "' ~ '" << pattern << "'";
+        }
+    }
+}
+
+TEST_F(PatternMatchTest, copiedPatternKeepsMatching)
+{
+    GlobPattern copy{"x"};
+    {
+        const GlobPattern glob{"a*b*c"};
+        copy = glob;
+    }
+    const auto moved = std::move(copy);
+
+    EXPECT_TRUE(moved.matches("a-b-c"));
+    EXPECT_FALSE(moved.matches("a-c"));
+    EXPECT_THAT(moved.pattern(), Eq("a*b*c"));
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "danek/PatternSet.h"
+#include "danek/GlobPattern.h"
+#include <gmock/gmock.h>
+#include <span>
+#include <string>
+#include <vector>
+
+using danek::GlobPattern;
+using danek::PatternSet;
+using namespace testing;
+
+class PatternSetTest : public testing::Test
+{
+protected:
+    static std::vector<std::size_t> matchingOneByOne(const std::vector<std::string>& patterns, std::string_view str)
+    {
+        std::vector<std::size_t> indices;
+
+        for (std::size_t i = 0; i < patterns.size(); ++i)
+        {
+            if (GlobPattern::matches(str, patterns[i]) == true)
+            {
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }
+};
+
+TEST_F(PatternSetTest, emptySetMatchesNothing)
+{
+    const PatternSet patterns{std::vector<std::string>{}};
+    EXPECT_TRUE(patterns.empty());
+    EXPECT_FALSE(patterns.matchesAny(""));
+    EXPECT_FALSE(patterns.matchesAny("abc"));
+    EXPECT_THAT(patterns.matching("abc"), IsEmpty());
+}
+
+TEST_F(PatternSetTest, matchingReturnsIndicesOfMatchingPatterns)
+{
+    const std::vector<std::string> list = {"*.exe", "ls*", "*grep*", "ls -l", "cat *", "*cat*"};
+    const PatternSet patterns{list};
+
+    EXPECT_THAT(patterns.size(), Eq(list.size()));
+    EXPECT_THAT(patterns.matching("ls -l"), ElementsAre(1, 3));
+    EXPECT_THAT(patterns.matching("cat x | grep y"), ElementsAre(2, 4, 5));
+    EXPECT_THAT(patterns.matching("setup.exe"), ElementsAre(0));
+    EXPECT_THAT(patterns.matching("rm -rf"), IsEmpty());
+    EXPECT_TRUE(patterns.matchesAny("lsof"));
+    EXPECT_FALSE(patterns.matchesAny("rm -rf"));
+}
+
+TEST_F(PatternSetTest, patternsWithoutLiteralAreAlwaysChecked)
+{
+    const std::vector<std::string> list = {"", "*", "**", "abc"};
+    const PatternSet patterns{list};
+
+    EXPECT_THAT(patterns.matching(""), ElementsAre(0, 1, 2));
+    EXPECT_THAT(patterns.matching("abc"), ElementsAre(1, 2, 3));
+    EXPECT_THAT(patterns.matching("x"), ElementsAre(1, 2));
+}
+
+TEST_F(PatternSetTest, overlappingLiteralsAreAllFound)
+{
+    const std::vector<std::string> list = {"*he*", "*she*", "*his*", "*hers*", "*e", "x*hers"};
+    const PatternSet patterns{list};
+
+    for (const std::string str : {"ushers", "she", "hishers", "h", "xhers", "ahishe", ""})
+    {
+        EXPECT_THAT(patterns.matching(str), ContainerEq(matchingOneByOne(list, str))) << "'" << str << "'";
+    }
+}
+
+TEST_F(PatternSetTest, agreesWithMatchingPatternsOneByOne)
+{
+    const std::vector<std::string> list = {"a*b*c", "*ab*", "abc", "*c", "b*", "a*a", "*bca*", "**a**", "ca*ab"};
+    const std::vector<std::string> strings = {"", "a", "abc", "aabbcc", "cab", "bca", "caab", "ababab", "cacab", "aa"};
+    const PatternSet patterns{list};
+
+    for (const auto& str : strings)
+    {
+        EXPECT_THAT(patterns.matching(str), ContainerEq(matchingOneByOne(list, str))) << "'" << str << "'";
+        EXPECT_THAT(patterns.matchesAny(str), Eq(matchingOneByOne(list, str).empty() == false)) << "'" << str << "'";
+    }
+}
+
+TEST_F(PatternSetTest, manyPatternsEachMatchOnce)
+{
+    std::vector<std::string> list;
+
+    for (int i = 0; i < 300; ++i)
+    {
+        list.push_back(std::string{"*item"}.append(std::to_string(i)).append("*"));
+    }
+    const PatternSet patterns{std::span<const std::string>{list}};
+
+    EXPECT_THAT(patterns.matching("item299 item299"), ElementsAre(2, 29, 299));
+    EXPECT_THAT(patterns.matching("item2 item1"), ElementsAre(1, 2));
+    EXPECT_THAT(patterns.matching("item12"), ElementsAre(1, 12));
+    EXPECT_FALSE(patterns.matchesAny("item"));
+}
+
+TEST_F(PatternSetTest, copiedSetMatchesLikeOriginal)
+{
+    const std::vector<std::string> list = {"*foo*", "bar*"};
+    const PatternSet original{list};
+    const PatternSet copy{original};
+
+    EXPECT_THAT(copy.matching("barfoo"), ElementsAre(0, 1));
+}
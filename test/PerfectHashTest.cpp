@@ -0,0 +1,75 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/internal/PerfectHash.h"
+#include <gmock/gmock.h>
+#include <string>
+
+using danek::lex::PerfectHash;
+using namespace testing;
+
+namespace
+{
+    struct Entry
+    {
+        const char* m_spelling;
+        int m_value;
+    };
+
+    constexpr Entry entries[] = {{"@copyFrom", 1}, {"@else", 2}, {"@elseIf", 3}, {"@if", 4}, {"@ifExists", 5},
+                                 {"@in", 6},       {"@include", 7}, {"getenv(", 8}, {"", 9}};
+
+    constexpr PerfectHash<Entry> table{entries};
+}
+
+class PerfectHashTest : public testing::Test
+{
+};
+
+TEST_F(PerfectHashTest, findsEveryEntry)
+{
+    EXPECT_THAT(table.size(), Eq(std::size(entries)));
+
+    for (const auto& entry : entries)
+    {
+        const Entry* found = table.find(entry.m_spelling);
+        ASSERT_THAT(found, NotNull()) << entry.m_spelling;
+        EXPECT_THAT(found->m_value, Eq(entry.m_value));
+    }
+}
+
+TEST_F(PerfectHashTest, rejectsOtherSpellings)
+{
+    for (const char* spelling : {"@els", "@elseif", "@includes", "getenv", "@", "x", "@copyFrom("})
+    {
+        EXPECT_THAT(table.find(spelling), IsNull()) << spelling;
+    }
+}
+
+TEST_F(PerfectHashTest, emptyTableFindsNothing)
+{
+    constexpr PerfectHash<Entry> empty{std::span<const Entry>{}};
+
+    EXPECT_THAT(empty.size(), Eq(0));
+    EXPECT_THAT(empty.find(""), IsNull());
+    EXPECT_THAT(empty.find("@if"), IsNull());
+}
@@ -22,6 +22,9 @@
 
 #include "danek/internal/platform/Platform.h"
 #include <gmock/gmock.h>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
 
 using namespace danek::platform;
 using namespace testing;
@@ -39,3 +42,55 @@ TEST_F(PlatformTest, configs)
 {
     EXPECT_THAT(directorySeparator(), AnyOf(Eq('/'), Eq('\\')));
 }
+
+TEST_F(PlatformTest, fileContentsOfRegularFile)
+{
+    const auto fileName = (std::filesystem::temp_directory_path() / "danek-PlatformTest.txt").string();
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file << "abc\r\ndef";
+    }
+
+    {
+        const FileContents contents{fileName};
+        EXPECT_THAT(contents.data(), Eq("abc\r\ndef"));
+    }
+    std::filesystem::remove(fileName);
+}
+
+#ifndef _WIN32
+TEST_F(PlatformTest, fileContentsOfRegularFileIsMapped)
+{
+    const auto fileName = (std::filesystem::temp_directory_path() / "danek-PlatformTest-mapped.txt").string();
+    const auto newFileName = fileName + ".new";
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file << "abc";
+    }
+
+    {
+        const FileContents contents{fileName};
+        EXPECT_TRUE(contents.isMapped());
+
+        {
+            std::ofstream file{newFileName, std::ios::binary};
+            file << "x";
+        }
+        std::filesystem::rename(newFileName, fileName);
+        EXPECT_THAT(contents.data(), Eq("abc"));
+    }
+    std::filesystem::remove(fileName);
+}
+
+TEST_F(PlatformTest, fileContentsOfFileWithoutSizeIsRead)
+{
+    const FileContents contents{"/dev/null"};
+    EXPECT_FALSE(contents.isMapped());
+    EXPECT_THAT(contents.data(), IsEmpty());
+}
+#endif
+
+TEST_F(PlatformTest, fileContentsOfMissingFileThrows)
+{
+    EXPECT_THROW(FileContents{"/nonexistent/danek.txt"}, std::system_error);
+}
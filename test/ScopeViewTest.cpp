@@ -0,0 +1,157 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+
+using namespace danek;
+using namespace testing;
+
+class ScopeViewTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "app {\n"
+                                                      "  name = \"abc\";\n"
+                                                      "  port = \"8080\";\n"
+                                                      "  ratio = \"0.5\";\n"
+                                                      "  enabled = \"true\";\n"
+                                                      "  timeout = \"2 seconds\";\n"
+                                                      "  size = \"2 KB\";\n"
+                                                      "  values = [\"a\", \"b\"];\n"
+                                                      "  nested { level = \"3\"; }\n"
+                                                      "}\n"
+                                                      "top = \"1\";\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(ScopeViewTest, lookupsRelativeToScope)
+{
+    const auto view = cfg->scopeView("app");
+    std::vector<std::string> values;
+    view.lookupList("values", values);
+
+    EXPECT_THAT(view.scope(), StrEq("app"));
+    EXPECT_THAT(view.type("nested"), Eq(ConfType::Scope));
+    EXPECT_THAT(view.lookupString("name"), Eq("abc"));
+    EXPECT_THAT(values, ElementsAre("a", "b"));
+    EXPECT_THAT(view.lookupInt("port"), Eq(8080));
+    EXPECT_THAT(view.lookupFloat("ratio"), FloatEq(0.5f));
+    EXPECT_TRUE(view.lookupBoolean("enabled"));
+    EXPECT_THAT(view.lookupDurationMilliseconds("timeout"), Eq(2000));
+    EXPECT_THAT(view.lookupMemorySizeBytes("size"), Eq(2048));
+    EXPECT_THAT(view.lookupInt("nested.level"), Eq(3));
+}
+
+TEST_F(ScopeViewTest, lookupsWithDefault)
+{
+    const auto view = cfg->scopeView("app");
+
+    EXPECT_THAT(view.type("missing"), Eq(ConfType::NoValue));
+    EXPECT_THAT(view.lookupString("missing", "x"), Eq("x"));
+    EXPECT_THAT(view.lookupInt("missing", 7), Eq(7));
+    EXPECT_FALSE(view.lookupBoolean("missing", false));
+    EXPECT_THAT(view.lookupInt("port", 7), Eq(8080));
+}
+
+TEST_F(ScopeViewTest, lookupErrorsNameFullyScopedName)
+{
+    const auto view = cfg->scopeView("app");
+
+    EXPECT_THAT([&view] { view.lookupInt("missing"); },
+                ThrowsMessage<ConfigurationException>(HasSubstr("no value specified for 'app.missing'")));
+    EXPECT_THAT([&view] { view.lookupInt("name"); }, Throws<ConfigurationException>());
+    EXPECT_THAT([&view] { view.lookupString("values"); }, Throws<ConfigurationException>());
+}
+
+TEST_F(ScopeViewTest, missingScopeThrows)
+{
+    EXPECT_THROW(cfg->scopeView("missing"), ConfigurationException);
+    EXPECT_THROW(cfg->scopeView("top"), ConfigurationException);
+    EXPECT_THROW(cfg->scopeView("app").child("name"), ConfigurationException);
+}
+
+TEST_F(ScopeViewTest, rootAndAbsoluteScopes)
+{
+    EXPECT_THAT(cfg->scopeView("").lookupInt("top"), Eq(1));
+    EXPECT_THAT(cfg->scopeView("").lookupInt("app.port"), Eq(8080));
+    EXPECT_THAT(cfg->scopeView(".app").lookupInt("port"), Eq(8080));
+}
+
+TEST_F(ScopeViewTest, childView)
+{
+    const auto child = cfg->scopeView("app").child("nested");
+
+    EXPECT_THAT(child.scope(), StrEq("app.nested"));
+    EXPECT_THAT(child.lookupInt("level"), Eq(3));
+}
+
+TEST_F(ScopeViewTest, staleViewResolvesNameAgain)
+{
+    const auto view = cfg->scopeView("app");
+    cfg->remove("app", "");
+    cfg->insertString("app", "port", "1");
+
+    EXPECT_THAT(view.lookupInt("port"), Eq(1));
+    EXPECT_THAT(view.type("name"), Eq(ConfType::NoValue));
+}
+
+TEST_F(ScopeViewTest, fallbackConfiguration)
+{
+    cfg->setFallbackConfiguration(Configuration::SourceType::String, "workers = \"4\"; other { x = \"5\"; }");
+
+    EXPECT_THAT(cfg->scopeView("app").lookupInt("workers"), Eq(4));
+    EXPECT_THAT(cfg->scopeView("other").lookupInt("workers"), Eq(4));
+}
+
+TEST_F(ScopeViewTest, frozenConfiguration)
+{
+    cfg->freeze();
+    const auto view = cfg->scopeView("app");
+
+    EXPECT_THAT(view.lookupInt("port"), Eq(8080));
+    EXPECT_THAT(view.child("nested").lookupInt("level"), Eq(3));
+}
+
+TEST_F(ScopeViewTest, resultsMatchLookupsByName)
+{
+    const std::pair<std::string, std::string> names[] = {{"app", "port"}, {"app", ".port"}, {"app", "port."},
+                                                         {"app", ""},     {"app", "nested"}, {"app", "nested.level"},
+                                                         {"", "top"},     {"", "app.port"},  {"app.nested", "level"}};
+
+    for (const auto& [scope, localName] : names)
+    {
+        const auto view = cfg->scopeView(scope);
+        EXPECT_THAT(view.type(localName), Eq(cfg->type(scope.c_str(), localName.c_str())))
+            << "'" << scope << "' + '" << localName << "'";
+    }
+}
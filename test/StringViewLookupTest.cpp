@@ -0,0 +1,141 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/Configuration.h"
+#include <gmock/gmock.h>
+#include <string_view>
+
+using namespace danek;
+using namespace testing;
+
+class StringViewLookupTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cfg = Configuration::create();
+        cfg->parse(Configuration::SourceType::String, "port = \"8080\";\n"
+                                                      "app {\n"
+                                                      "  name = \"abc\";\n"
+                                                      "  timeout = \"5 seconds\";\n"
+                                                      "  size = \"2 MB\";\n"
+                                                      "  enabled = \"true\";\n"
+                                                      "  ratio = \"0.5\";\n"
+                                                      "  values = [\"a\", \"b\"];\n"
+                                                      "  nested { level = \"3\"; }\n"
+                                                      "}\n");
+    }
+
+    void TearDown() override
+    {
+        cfg->destroy();
+    }
+
+    Configuration* cfg;
+};
+
+TEST_F(StringViewLookupTest, lookupWithSlicesOfLargerBuffer)
+{
+    constexpr std::string_view buffer{"app.nested.level=port"};
+    const auto scope = buffer.substr(0, 10);
+    const auto localName = buffer.substr(11, 5);
+
+    EXPECT_THAT(cfg->lookupInt(scope, localName), Eq(3));
+    EXPECT_THAT(cfg->lookupInt(std::string_view{}, buffer.substr(17)), Eq(8080));
+    EXPECT_THAT(cfg->type(buffer.substr(0, 3), buffer.substr(4, 6)), Eq(ConfType::Scope));
+}
+
+TEST_F(StringViewLookupTest, lookupStringReturnsView)
+{
+    const std::string_view value = cfg->lookupString(std::string_view{"app"}, std::string_view{"name"});
+    EXPECT_THAT(value, Eq("abc"));
+    EXPECT_THAT(value.size(), Eq(3));
+}
+
+TEST_F(StringViewLookupTest, lookupThroughViewsReturnsSameAsLookupByName)
+{
+    const std::string_view scope{"app"};
+
+    EXPECT_THAT(cfg->lookupFloat(scope, "ratio"), FloatEq(cfg->lookupFloat("app", "ratio")));
+    EXPECT_THAT(cfg->lookupDurationMilliseconds(scope, "timeout"), Eq(5000));
+    EXPECT_THAT(cfg->lookupDurationSeconds(scope, "timeout"), Eq(5));
+    EXPECT_THAT(cfg->lookupMemorySizeKB(scope, "size"), Eq(2048));
+    EXPECT_THAT(cfg->lookupMemorySizeMB(scope, "size"), Eq(2));
+    EXPECT_TRUE(cfg->lookupBoolean(scope, "enabled"));
+
+    std::vector<std::string> values;
+    cfg->lookupList(scope, "values", values);
+    EXPECT_THAT(values, ElementsAre("a", "b"));
+
+    StringVector list;
+    cfg->lookupList(scope, "values", list);
+    EXPECT_THAT(list.get(), ElementsAre("a", "b"));
+}
+
+TEST_F(StringViewLookupTest, lookupOfMissingEntryUsesDefault)
+{
+    const std::string_view scope{"app"};
+
+    EXPECT_THAT(cfg->type(scope, "missing"), Eq(ConfType::NoValue));
+    EXPECT_THAT(cfg->lookupString(scope, "missing", std::string_view{"default"}), Eq("default"));
+    EXPECT_THAT(cfg->lookupInt(scope, "missing", 3), Eq(3));
+    EXPECT_THAT(cfg->lookupFloat(scope, "missing", 1.5f), FloatEq(1.5f));
+    EXPECT_THAT(cfg->lookupDurationSeconds(scope, "missing", 7), Eq(7));
+    EXPECT_THAT(cfg->lookupMemorySizeBytes(scope, "missing", 10), Eq(10));
+    EXPECT_TRUE(cfg->lookupBoolean(scope, "missing", true));
+
+    StringVector list;
+    cfg->lookupList(scope, "missing", list, StringVector{std::vector<std::string>{"x"}});
+    EXPECT_THAT(list.get(), ElementsAre("x"));
+}
+
+TEST_F(StringViewLookupTest, lookupOfMissingEntryThrowsWithoutDefault)
+{
+    EXPECT_THROW(cfg->lookupString(std::string_view{"app"}, std::string_view{"missing"}), ConfigurationException);
+    EXPECT_THROW(cfg->lookupInt(std::string_view{"app"}, "missing"), ConfigurationException);
+}
+
+TEST_F(StringViewLookupTest, errorNamesTheSlicedEntry)
+{
+    constexpr std::string_view buffer{"app.nameXYZ"};
+
+    try
+    {
+        cfg->lookupInt(buffer.substr(0, 3), buffer.substr(4, 4));
+        FAIL() << "Exception expected";
+    }
+    catch (const ConfigurationException& ex)
+    {
+        EXPECT_THAT(ex.message(), HasSubstr("'app.name'"));
+    }
+}
+
+TEST_F(StringViewLookupTest, insertWithViews)
+{
+    constexpr std::string_view buffer{"new.scope.key=value;"};
+
+    cfg->insertString(buffer.substr(0, 9), buffer.substr(10, 3), buffer.substr(14, 5));
+    cfg->insertList(std::string_view{"new"}, std::string_view{"list"}, std::vector<std::string>{"a"});
+
+    EXPECT_THAT(cfg->lookupString("new.scope", "key"), StrEq("value"));
+    EXPECT_THAT(cfg->type("new", "list"), Eq(ConfType::List));
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "danek/internal/SymbolTable.h"
+#include <gmock/gmock.h>
+
+using namespace danek;
+using namespace testing;
+
+class SymbolTableTest : public testing::Test
+{
+protected:
+    SymbolTable symbols;
+};
+
+TEST_F(SymbolTableTest, emptyTable)
+{
+    EXPECT_THAT(symbols.size(), Eq(0));
+    EXPECT_THAT(symbols.find("name"), Eq(SymbolTable::noSymbol));
+}
+
+TEST_F(SymbolTableTest, internReturnsSameIdForSameName)
+{
+    const auto id = symbols.intern("port");
+    EXPECT_THAT(symbols.intern("port"), Eq(id));
+    EXPECT_THAT(symbols.find("port"), Eq(id));
+    EXPECT_THAT(symbols.size(), Eq(1));
+}
+
+TEST_F(SymbolTableTest, internReturnsDistinctIdsForDistinctNames)
+{
+    const auto host = symbols.intern("host");
+    const auto port = symbols.intern("port");
+    EXPECT_THAT(host, Ne(port));
+    EXPECT_THAT(symbols.name(host), StrEq("host"));
+    EXPECT_THAT(symbols.name(port), StrEq("port"));
+}
+
+TEST_F(SymbolTableTest, internCopiesTheName)
+{
+    std::string name{"timeout"};
+    const auto id = symbols.intern(name);
+    name = "changed";
+
+    EXPECT_THAT(symbols.name(id), StrEq("timeout"));
+    EXPECT_THAT(symbols.find("timeout"), Eq(id));
+}
+
+TEST_F(SymbolTableTest, namesStayValidWhenTableGrows)
+{
+    const auto id = symbols.intern("a");
+    const auto* name = &symbols.name(id);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        symbols.intern(std::string{"n"}.append(std::to_string(i)));
+    }
+
+    EXPECT_THAT(&symbols.name(id), Eq(name));
+    EXPECT_THAT(symbols.find("a"), Eq(id));
+    EXPECT_THAT(symbols.find("n999"), Ne(SymbolTable::noSymbol));
+}
+
+TEST_F(SymbolTableTest, unexpandedNameOfUidName)
+{
+    const auto id = symbols.intern("uid-000000042-entry");
+    EXPECT_THAT(symbols.unexpandedName(id), StrEq("uid-entry"));
+    EXPECT_THAT(symbols.name(id), StrEq("uid-000000042-entry"));
+}
+
+TEST_F(SymbolTableTest, unexpandedNameOfOtherNameIsTheName)
+{
+    const auto id = symbols.intern("uid-entry");
+    EXPECT_THAT(&symbols.unexpandedName(id), Eq(&symbols.name(id)));
+    EXPECT_THAT(&symbols.unexpandedName(symbols.intern("plain")), Eq(&symbols.name(symbols.intern("plain"))));
+}
+
+TEST_F(SymbolTableTest, nameThrowsOnUnknownId)
+{
+    EXPECT_THROW(symbols.name(3), std::out_of_range);
+}
@@ -30,25 +30,27 @@ using namespace testing;
 
 class ToStringTest : public testing::Test
 {
+protected:
+    SymbolTable symbols;
 };
 
 TEST_F(ToStringTest, configItemEscapesSpecialCharacters)
 {
-    const ConfigItem item{"name", "value\t_\n_%_\"_"};
+    const ConfigItem item{symbols, symbols.intern("name"), "value\t_\n_%_\"_"};
     const auto str = toString(item, "xyz", false);
     EXPECT_THAT(str, StrEq("xyz = \"value%t_%n_%%_%\"_\";\n"));
 }
 
 TEST_F(ToStringTest, configItemWithIndention)
 {
-    const ConfigItem item{"name", "value"};
+    const ConfigItem item{symbols, symbols.intern("name"), "value"};
     const auto str = toString(item, "xyz", false, 2);
     EXPECT_THAT(str, StrEq("        xyz = \"value\";\n"));
 }
 
 TEST_F(ToStringTest, configItemStringItem)
 {
-    const ConfigItem item{"name", "value"};
+    const ConfigItem item{symbols, symbols.intern("name"), "value"};
     const auto str = toString(item, "xyz", false);
     EXPECT_THAT(str, StrEq("xyz = \"value\";\n"));
 }
@@ -56,7 +58,7 @@ TEST_F(ToStringTest, configItemStringItem)
 TEST_F(ToStringTest, configItemListItem)
 {
     const std::vector<std::string> v{"a", "b\n"};
-    const ConfigItem item{"name", v};
+    const ConfigItem item{symbols, symbols.intern("name"), v};
 
     const auto str = toString(item, "xyz", false);
     EXPECT_THAT(str, StrEq("xyz = [\"a\", \"b%n\"];\n"));
@@ -65,7 +67,7 @@ TEST_F(ToStringTest, configItemListItem)
 TEST_F(ToStringTest, configItemListItemSingleElement)
 {
     const std::vector<std::string> v{};
-    const ConfigItem item{"name", v};
+    const ConfigItem item{symbols, symbols.intern("name"), v};
 
     const auto str = toString(item, "xyz", false);
     EXPECT_THAT(str, StrEq("xyz = [];\n"));
@@ -74,7 +76,7 @@ TEST_F(ToStringTest, configItemListItemSingleElement)
 TEST_F(ToStringTest, configItemListItemIfEmpty)
 {
     const std::vector<std::string> v{};
-    const ConfigItem item{"name", v};
+    const ConfigItem item{symbols, symbols.intern("name"), v};
 
     const auto str = toString(item, "xyz", false);
     EXPECT_THAT(str, StrEq("xyz = [];\n"));
@@ -83,7 +85,7 @@ TEST_F(ToStringTest, configItemListItemIfEmpty)
 TEST_F(ToStringTest, configItemScopeItem)
 {
     const char c = '\0';
-    const ConfigItem item{"name", std::make_unique<ConfigScope>(nullptr, &c)};
+    const ConfigItem item{symbols, symbols.intern("name"), makeResourcePtr<ConfigScope>(std::pmr::get_default_resource(), nullptr, &c)};
     const auto str = toString(item, "xyz", false);
     EXPECT_THAT(str, StrEq("xyz {\n}\n"));
 }
@@ -145,3 +147,14 @@ TEST_F(ToStringTest, configScopeMixedType)
     const auto str = toString(root, true);
     EXPECT_THAT(str, StrEq("sn0 {\n    a = \"b\";\n    sn1 {\n        x = \"y\";\n    }\n}\n"));
 }
+
+TEST_F(ToStringTest, configScopeUnexpandsUidNames)
+{
+    ConfigScope root{nullptr, "\0"};
+    ConfigScope* ptr = nullptr;
+    root.ensureScopeExists("uid-000000001-entry", ptr);
+    ptr->addOrReplaceString("uid-000000002-x", "y");
+
+    EXPECT_THAT(toString(root, false), StrEq("uid-entry {\n    uid-x = \"y\";\n}\n"));
+    EXPECT_THAT(toString(root, true), StrEq("uid-000000001-entry {\n    uid-000000002-x = \"y\";\n}\n"));
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2017-2021 offa
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions.
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "danek/internal/Utf8.h"
+#include <gmock/gmock.h>
+#include <string>
+
+using namespace danek::utf8;
+using namespace testing;
+
+class Utf8Test : public testing::Test
+{
+protected:
+    static char32_t decodeAll(const std::string& str)
+    {
+        const char* ptr = str.data();
+        char32_t codePoint = 0;
+
+        if (decode(ptr, str.data() + str.size(), codePoint) == false || ptr != str.data() + str.size())
+        {
+            return 0xFFFFFFFF;
+        }
+        return codePoint;
+    }
+
+    static bool isInvalid(const std::string& str)
+    {
+        const char* ptr = str.data();
+        char32_t codePoint;
+        return decode(ptr, str.data() + str.size(), codePoint) == false && ptr == str.data();
+    }
+};
+
+TEST_F(Utf8Test, asciiLengthFindsFirstNonAsciiByte)
+{
+    for (std::size_t length = 0; length < 40; ++length)
+    {
+        std::string str(length, 'a');
+        EXPECT_THAT(asciiLength(str.data(), str.data() + str.size()), Eq(length));
+
+        str.append("\xC3\xA4").append(20, 'b');
+        EXPECT_THAT(asciiLength(str.data(), str.data() + str.size()), Eq(length)) << length;
+    }
+}
+
+TEST_F(Utf8Test, decodeSequencesOfAllLengths)
+{
+    EXPECT_THAT(decodeAll("a"), Eq(U'a'));
+    EXPECT_THAT(decodeAll("\xC3\xA4"), Eq(U'ä'));
+    EXPECT_THAT(decodeAll("\xE2\x82\xAC"), Eq(U'€'));
+    EXPECT_THAT(decodeAll("\xF0\x9F\x98\x80"), Eq(U'\U0001F600'));
+    EXPECT_THAT(decodeAll("\xF4\x8F\xBF\xBF"), Eq(U'\U0010FFFF'));
+}
+
+TEST_F(Utf8Test, decodeRejectsInvalidSequences)
+{
+    EXPECT_TRUE(isInvalid("\x80"));             // Continuation byte
+    EXPECT_TRUE(isInvalid("\xC0\x80"));         // Overlong
+    EXPECT_TRUE(isInvalid("\xC1\xBF"));         // Overlong
+    EXPECT_TRUE(isInvalid("\xE0\x9F\xBF"));     // Overlong
+    EXPECT_TRUE(isInvalid("\xF0\x8F\xBF\xBF")); // Overlong
+    EXPECT_TRUE(isInvalid("\xED\xA0\x80"));     // Surrogate
+    EXPECT_TRUE(isInvalid("\xF4\x90\x80\x80")); // Beyond U+10FFFF
+    EXPECT_TRUE(isInvalid("\xF5\x80\x80\x80"));
+    EXPECT_TRUE(isInvalid("\xFF"));
+    EXPECT_TRUE(isInvalid("\xC3"));             // Truncated
+    EXPECT_TRUE(isInvalid("\xE2\x82"));
+    EXPECT_TRUE(isInvalid("\xE2\x28\xA1"));     // Not a continuation byte
+    EXPECT_TRUE(isInvalid(""));
+}
+
+TEST_F(Utf8Test, countCodePoints)
+{
+    EXPECT_THAT(countCodePoints(""), Eq(0));
+    EXPECT_THAT(countCodePoints("abc"), Eq(3));
+    EXPECT_THAT(countCodePoints("Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC"), Eq(7));
+    EXPECT_THAT(countCodePoints(std::string(100, 'x').append("\xF0\x9F\x98\x80").append(100, 'y')), Eq(201));
+    EXPECT_THAT(countCodePoints(std::string(100, 'x').append("\xC3")), Eq(-1));
+    EXPECT_THAT(countCodePoints("ab\xFF" "cd"), Eq(-1));
+}
+
+TEST_F(Utf8Test, isSpace)
+{
+    EXPECT_TRUE(isSpace(U' '));
+    EXPECT_TRUE(isSpace(U'\t'));
+    EXPECT_TRUE(isSpace(U'\n'));
+    EXPECT_TRUE(isSpace(U'\r'));
+    EXPECT_TRUE(isSpace(U'　'));
+    EXPECT_FALSE(isSpace(U'a'));
+    EXPECT_FALSE(isSpace(U'ä'));
+    EXPECT_FALSE(isSpace(0));
+}
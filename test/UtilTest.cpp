@@ -23,6 +23,7 @@
 #include "danek/internal/Util.h"
 #include "danek/StringVector.h"
 #include <gmock/gmock.h>
+#include <utility>
 
 using namespace danek::util;
 using namespace testing;
@@ -46,3 +47,68 @@ TEST(UtilTest, splitScopedNameReturnsSplittedResults)
     EXPECT_THAT(v[1], Eq("b"));
     EXPECT_THAT(v[2], Eq("c"));
 }
+
+namespace
+{
+    std::vector<std::string> tokenize(std::string_view scope, std::string_view localName)
+    {
+        const ScopedName name{scope, localName};
+        ScopedName::Tokenizer tokenizer{name};
+        std::vector<std::string> components;
+        std::string_view component;
+
+        while (tokenizer.next(component))
+        {
+            components.emplace_back(component);
+        }
+        return components;
+    }
+}
+
+TEST(UtilTest, scopedNameMergesScopeAndLocalName)
+{
+    EXPECT_THAT(ScopedName("a.b", "c").str(), Eq("a.b.c"));
+    EXPECT_THAT(ScopedName("", "c").str(), Eq("c"));
+    EXPECT_THAT(ScopedName("a.b", "").str(), Eq("a.b"));
+    EXPECT_TRUE(ScopedName("", "").empty());
+}
+
+TEST(UtilTest, scopedNameAbsoluteName)
+{
+    const ScopedName name{"", ".a.b"};
+    EXPECT_TRUE(name.isAbsolute());
+    EXPECT_FALSE(ScopedName("a", "b").isAbsolute());
+    EXPECT_THAT(name.relativeName().str(), Eq("a.b"));
+}
+
+TEST(UtilTest, scopedNameTokenizerMatchesSplitScopes)
+{
+    const std::vector<std::pair<std::string, std::string>> names = {
+        {"", "a"}, {"", "a.b"}, {"", "a."}, {"", "a..b"}, {"", "."}, {"", ".."},
+        {"a", "b"}, {"a.b", "c.d"}, {"a.", "b"}, {"a", ".b"}, {"a", "b."}, {"a.b", ""},
+        {".a", "b"}, {"a..b", "c"}, {".", "."}, {"", ".a"}, {"a", "."}, {"x.y.z", "w"}};
+
+    for (const auto& [scope, localName] : names)
+    {
+        const std::string merged = ScopedName{scope, localName}.str();
+        EXPECT_THAT(tokenize(scope, localName), ContainerEq(splitScopes(merged)))
+            << "'" << scope << "' + '" << localName << "'";
+    }
+}
+
+TEST(UtilTest, scopedNameHashMatchesHashOfMergedName)
+{
+    const std::vector<std::pair<std::string, std::string>> names = {
+        {"", "a"}, {"", "a.b"}, {"a", "b"}, {"a.b", "c.d"}, {"a.b", ""}, {"a", "b."}, {"", "a."}};
+
+    for (const auto& [scope, localName] : names)
+    {
+        std::string merged = ScopedName{scope, localName}.str();
+
+        if (merged.back() == '.')
+        {
+            merged.pop_back();
+        }
+        EXPECT_THAT(ScopedName(scope, localName).hash(), Eq(hashName(merged))) << "'" << scope << "' + '" << localName << "'";
+    }
+}